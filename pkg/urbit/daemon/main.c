@@ -75,6 +75,7 @@ _main_getopt(c3_i argc, c3_c** argv)
   u3_Host.ops_u.abo = c3n;
   u3_Host.ops_u.dem = c3n;
   u3_Host.ops_u.dry = c3n;
+  u3_Host.ops_u.fos = c3n;
   u3_Host.ops_u.gab = c3n;
   u3_Host.ops_u.git = c3n;
 
@@ -85,19 +86,23 @@ _main_getopt(c3_i argc, c3_c** argv)
 
   u3_Host.ops_u.net = c3y;
   u3_Host.ops_u.lit = c3n;
+  u3_Host.ops_u.map = c3n;
   u3_Host.ops_u.nuu = c3n;
   u3_Host.ops_u.pro = c3n;
   u3_Host.ops_u.qui = c3n;
   u3_Host.ops_u.rep = c3n;
+  u3_Host.ops_u.shm = c3n;
   u3_Host.ops_u.tem = c3n;
   u3_Host.ops_u.tex = c3n;
   u3_Host.ops_u.tra = c3n;
   u3_Host.ops_u.veb = c3n;
+  u3_Host.ops_u.zip = c3n;
+  u3_Host.ops_u.gro_w = 0;
   u3_Host.ops_u.hap_w = 50000;
   u3_Host.ops_u.kno_w = DefaultKernel;
 
   while ( -1 != (ch_i=getopt(argc, argv,
-                 "G:J:B:K:A:H:I:C:w:u:e:F:k:p:LljacdgqstvxPDRS")) )
+                 "G:J:B:K:A:H:I:C:b:w:u:e:F:k:p:LljacdfgmqstvxzPDRSW")) )
   {
     switch ( ch_i ) {
       case 'J': {
@@ -130,6 +135,12 @@ _main_getopt(c3_i argc, c3_c** argv)
         }
         break;
       }
+      case 'b': {
+        if ( c3n == _main_readw(optarg, 60000, &u3_Host.ops_u.gro_w) ) {
+          return c3n;
+        }
+        break;
+      }
       case 'e': {
         u3_Host.ops_u.eth_c = strdup(optarg);
         break;
@@ -178,13 +189,17 @@ _main_getopt(c3_i argc, c3_c** argv)
       case 'a': { u3_Host.ops_u.abo = c3y; break; }
       case 'c': { u3_Host.ops_u.nuu = c3y; break; }
       case 'd': { u3_Host.ops_u.dem = c3y; break; }
+      case 'f': { u3_Host.ops_u.fos = c3y; break; }
       case 'g': { u3_Host.ops_u.gab = c3y; break; }
+      case 'm': { u3_Host.ops_u.map = c3y; break; }
+      case 'z': { u3_Host.ops_u.zip = c3y; break; }
       case 'P': { u3_Host.ops_u.pro = c3y; break; }
       case 'D': { u3_Host.ops_u.dry = c3y; break; }
       case 'q': { u3_Host.ops_u.qui = c3y; break; }
       case 'v': { u3_Host.ops_u.veb = c3y; break; }
       case 's': { u3_Host.ops_u.git = c3y; break; }
       case 'S': { u3_Host.ops_u.has = c3y; break; }
+      case 'W': { u3_Host.ops_u.shm = c3y; break; }
       case 't': { u3_Host.ops_u.tem = c3y; break; }
       case '?': default: {
         return c3n;
@@ -376,17 +391,20 @@ u3_ve_usage(c3_i argc, c3_c** argv)
     "\n",
     "-A dir        Use dir for initial clay sync\n",
     "-B pill       Bootstrap from this pill\n",
+    "-b ms         Group event log commits, waiting up to ms\n",
     "-C limit      Set memo cache max size; 0 means uncapped\n",
     "-c pier       Create a new urbit in pier/\n",
     "-D            Recompute from events\n",
     "-d            Daemon mode; implies -t\n",
     "-e url        Ethereum gateway\n",
     "-F ship       Fake keys; also disables networking\n",
+    "-f            Write snapshots from a background process\n",
     "-g            Set GC flag\n",
     "-j file       Create json trace file\n",
     "-K stage      Start at Hoon kernel version stage\n",
     "-k keys       Private key file\n",
     "-L            local networking only\n",
+    "-m            Map the snapshot into memory on demand\n",
     "-P            Profiling\n",
     "-p ames_port  Set the ames port to bind to\n",
     "-q            Quiet\n",
@@ -397,8 +415,10 @@ u3_ve_usage(c3_i argc, c3_c** argv)
     "-t            Disable terminal/tty assumptions\n",
     "-u url        URL from which to download pill\n",
     "-v            Verbose\n",
+    "-W            Talk to the worker through shared memory\n",
     "-w name       Boot as ~name\n",
     "-x            Exit immediately\n",
+    "-z            Write a compressed snapshot on exit\n",
     "\n",
     "Development Usage:\n",
     "   To create a development ship, use a fakezod:\n",
@@ -737,6 +757,24 @@ main(c3_i   argc,
         u3C.wag_w |= u3o_dryrun;
       }
 
+      /*  Set background snapshot flag.
+      */
+      if ( _(u3_Host.ops_u.fos) ) {
+        u3C.wag_w |= u3o_fork_save;
+      }
+
+      /*  Set lazy snapshot loading flag.
+      */
+      if ( _(u3_Host.ops_u.map) ) {
+        u3C.wag_w |= u3o_lazy_load;
+      }
+
+      /*  Set packed snapshot flag.
+      */
+      if ( _(u3_Host.ops_u.zip) ) {
+        u3C.wag_w |= u3o_pack_exit;
+      }
+
       /*  Set hashboard flag
       */
       if ( _(u3_Host.ops_u.has) ) {
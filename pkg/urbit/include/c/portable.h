@@ -96,23 +96,45 @@
 #     else
 #       define U3_OS_LoomBase 0x36000000
 #     endif
-#       define U3_OS_LoomBits 29            //  ie, 2^29 words == 2GB
 #   elif defined(U3_OS_osx)
 #     ifdef __LP64__
 #       define U3_OS_LoomBase 0x200000000
 #     else
 #       define U3_OS_LoomBase 0x4000000
 #     endif
-#       define U3_OS_LoomBits 29            //  ie, 2^29 words == 2GB
 #   elif defined(U3_OS_bsd)
 #     ifdef __LP64__
 #       define U3_OS_LoomBase 0x200000000
 #     else
 #       define U3_OS_LoomBase 0x4000000
 #     endif
-#       define U3_OS_LoomBits 29            //  ie, 2^29 words == 2GB
 #   else
 #     error "port: LoomBase"
+#   endif
+
+  /** Loom size.
+  ***
+  *** A noun carries a 30-bit offset into the loom, counted in units
+  *** of (1 << U3_OS_LoomShift) words.  With the default shift of 0,
+  *** the loom is 2^29 words (2GB).  Building with a shift of 1 aligns
+  *** every box on two words and doubles the reach of a noun, for a
+  *** 2^31 word (8GB) loom.  Images are not portable across shifts.
+  **/
+#   ifndef U3_OS_LoomShift
+#     define U3_OS_LoomShift 0
+#   endif
+#   if (0 == U3_OS_LoomShift)
+#     define U3_OS_LoomBits 29            //  ie, 2^29 words == 2GB
+#   elif (1 == U3_OS_LoomShift)
+#     ifndef __LP64__
+#       error "port: U3_OS_LoomShift requires a 64-bit address space"
+#     endif
+#     ifdef U3_MEMORY_DEBUG
+#       error "port: U3_OS_LoomShift is incompatible with U3_MEMORY_DEBUG"
+#     endif
+#     define U3_OS_LoomBits 31            //  ie, 2^31 words == 8GB
+#   else
+#     error "port: U3_OS_LoomShift"
 #   endif
 
   /** Global variable control.
@@ -30,7 +30,8 @@
     **  If bit 31 is 1 and bit 30 0, an indirect atom ("pug").
     **  If bit 31 is 1 and bit 30 1, an indirect cell ("pom").
     **
-    ** Bits 0-29 are a word offset against u3_Loom (u3_post).
+    ** Bits 0-29 are a word offset against u3_Loom (u3_post),
+    ** shifted right by u3a_vits.
     */
       typedef c3_w u3_noun;
 
@@ -8,6 +8,14 @@
     */
 #     define u3a_bits  U3_OS_LoomBits
 
+    /* u3a_vits: number of low bits dropped from a compressed pointer.
+    */
+#     define u3a_vits  U3_OS_LoomShift
+
+    /* u3a_walign: word alignment of every box, and of its contents.
+    */
+#     define u3a_walign  (1 << u3a_vits)
+
     /* u3a_page: number of bits in word-addressed page.  12 == 16Kbyte page.
     */
 #     define u3a_page   12
@@ -18,11 +26,11 @@
 
     /* u3a_words: number of words in memory.
     */
-#     define u3a_words  (1 << u3a_bits)
+#     define u3a_words  ((c3_w)1 << u3a_bits)
 
     /* u3a_bytes: number of bytes in memory.
     */
-#     define u3a_bytes  (c3_w)((1 << (2 + u3a_bits)))
+#     define u3a_bytes  ((c3_d)1 << (2 + u3a_bits))
 
     /* u3a_minimum: minimum number of words in a box.
     **
@@ -38,6 +46,20 @@
     */
 #     define u3a_fbox_no   27
 
+    /* u3a_sabs_no: number of exact size classes for small boxes.
+    **
+    **  classes are u3a_minimum, u3a_minimum + 2, ... u3a_sabs_max words.
+    */
+#     define u3a_sabs_no   30
+
+    /* u3a_sabs_max: largest box, in words, served from a slab.
+    */
+#     define u3a_sabs_max  64
+
+    /* u3a_sabs_blok: words carved from the hat to refill a slab.
+    */
+#     define u3a_sabs_blok 4096
+
 
   /**  Structures.
   **/
@@ -113,7 +135,16 @@
         u3p(c3_w) rut_p;                      //  bottom of durable region
         u3p(c3_w) ear_p;                      //  original cap if kid is live
 
-        c3_w fut_w[32];                       //  futureproof buffer
+        union {                               //  futureproof buffer
+          c3_w fut_w[32];                     //
+          struct {                            //
+            u3p(u3a_fbox) sab_p[u3a_sabs_no]; //  slab lists by size class
+            u3_noun       mel;                //  meld root (home road)
+            u3p(u3h_root) mel_p;              //  meld canonical table, or 0
+            c3_w          vit_w;              //  loom shift (home road)
+            u3p(u3h_root) meg_p;              //  megamorphic kicks, or 0
+          };
+        };
 
         struct {                              //  escape buffer
           union {
@@ -163,9 +194,13 @@
       typedef u3a_road u3_road;
 
     /* u3a_flag: flags for how.fag_w.  All arena related.
+    **
+    **  u3a_flag_sand: allocate by bumping the hat, never free.
+    **  the road is reclaimed wholesale when it falls, so it
+    **  must only be used for short-lived computations.
     */
       enum u3a_flag {
-        u3a_flag_sand  = 0x1,                 //  bump allocation (XX not impl)
+        u3a_flag_sand  = 0x1,                 //  bump allocation
       };
 
 
@@ -188,11 +223,11 @@
 
 #     define u3a_is_pug(som)    ((2 == ((som) >> 30)) ? c3y : c3n)
 #     define u3a_is_pom(som)    ((3 == ((som) >> 30)) ? c3y : c3n)
-#     define u3a_to_off(som)    ((som) & 0x3fffffff)
+#     define u3a_to_off(som)    (((som) & 0x3fffffff) << u3a_vits)
 #     define u3a_to_ptr(som)    (u3a_into(u3a_to_off(som)))
 #     define u3a_to_wtr(som)    ((c3_w *)u3a_to_ptr(som))
-#     define u3a_to_pug(off)    (off | 0x80000000)
-#     define u3a_to_pom(off)    (off | 0xc0000000)
+#     define u3a_to_pug(off)    (((off) >> u3a_vits) | 0x80000000)
+#     define u3a_to_pom(off)    (((off) >> u3a_vits) | 0xc0000000)
 
 #     define u3a_is_atom(som)    c3o(u3a_is_cat(som), \
                                          u3a_is_pug(som))
@@ -214,6 +249,12 @@
 #     define  u3a_is_north(r)  __(r->cap_p > r->hat_p)
 #     define  u3a_is_south(r)  !u3a_is_north(r)
 
+#     define  u3a_is_sand(r)   __(r->how.fag_w & u3a_flag_sand)
+
+    /* u3a_walign_up(): round a word count up to u3a_walign.
+    */
+#     define  u3a_walign_up(x)  (((x) + (u3a_walign - 1)) & ~(u3a_walign - 1))
+
     /* u3a_open(): words of contiguous free space in [r]
     */
 #     define  u3a_open(r)  ( (c3y == u3a_is_north(r)) \
@@ -279,6 +320,8 @@
 
 #     define  u3a_is_mutable(r, som) \
                 ( _(u3a_is_atom(som)) \
+                  ? c3n \
+                  : _(u3a_is_sand(r)) \
                   ? c3n \
                   : _(u3a_is_senior(r, som)) \
                   ? c3n \
@@ -488,11 +531,81 @@
           c3_w
           u3a_idle(u3a_road* rod_u);
 
+        /* u3a_idle_slabs(): measure slab lists in [rod_u]
+        */
+          c3_w
+          u3a_idle_slabs(u3a_road* rod_u);
+
+        /* u3a_print_slabs(): print slab hits and misses.
+        */
+          void
+          u3a_print_slabs(FILE* fil_u);
+
         /* u3a_sweep(): sweep a fully marked road.
         */
           c3_w
           u3a_sweep(void);
 
+        /* u3a_pack_seek(): sweep the heap, recording new addresses in boxes.
+        */
+          void
+          u3a_pack_seek(u3a_road* rod_u);
+
+        /* u3a_pack_move(): sweep the heap, sliding boxes to new addresses.
+        */
+          void
+          u3a_pack_move(u3a_road* rod_u);
+
+        /* u3a_rewrite_ptr(): mark a pointer as rewritten; c3n if it was.
+        */
+          c3_o
+          u3a_rewrite_ptr(void* ptr_v);
+
+        /* u3a_rewritten(): new location of the allocation at [ptr_p].
+        */
+          u3_post
+          u3a_rewritten(u3_post ptr_p);
+
+        /* u3a_rewritten_noun(): new reference to [som].
+        */
+          u3_noun
+          u3a_rewritten_noun(u3_noun som);
+
+        /* u3a_rewrite_noun(): rewrite the references inside [som].
+        */
+          void
+          u3a_rewrite_noun(u3_noun som);
+
+        /* u3a_rewrite_compact(): rewrite ad-hoc persistent road structures.
+        */
+          void
+          u3a_rewrite_compact(void);
+
+        /* u3a_meld_start(): begin canonicalizing [som] on the home road.
+        **
+        **  [som] is transferred, and held until the meld is stopped.
+        */
+          void
+          u3a_meld_start(u3_noun som);
+
+        /* u3a_meld_live(): c3y if a meld is in progress.
+        */
+          c3_o
+          u3a_meld_live(void);
+
+        /* u3a_meld(): meld for at most [mil_w] milliseconds (0 for no limit),
+        **             adding words released to [sav_w].  c3y if finished.
+        **
+        **  abandons the meld, producing c3n, if the loom is nearly full.
+        */
+          c3_o
+          u3a_meld(c3_w mil_w, c3_w* sav_w);
+
+        /* u3a_meld_stop(): finish or abandon a meld, releasing its state.
+        */
+          void
+          u3a_meld_stop(void);
+
         /* u3a_sane(): check allocator sanity.
         */
           void
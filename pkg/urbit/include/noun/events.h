@@ -18,6 +18,7 @@
         c3_w nor_w;                         //  new page count north
         c3_w sou_w;                         //  new page count south
         c3_w pgs_w;                         //  number of changed pages
+        c3_w vit_w;                         //  loom shift, u3a_vits
         u3e_line mem_u[0];                  //  per page
       } u3e_control;
 
@@ -35,14 +36,48 @@
         c3_c* nam_c;                        //  segment name
         c3_i  fid_i;                        //  open file, or 0
         c3_w  pgs_w;                        //  length in pages
+        c3_w  map_w;                        //  pages mapped onto the loom
       } u3e_image;
 
+    /* u3e_pack_head: packed image, header.
+
+      A packed image is a header, a bitmap of zero pages (one bit per
+      page, north pages then south), a u3e_pack_line for every page not
+      in the bitmap, and the compressed pages themselves.
+    */
+      typedef struct _u3e_pack_head {
+        c3_w mag_w;                         //  u3e_pack_magic
+        c3_w ver_w;                         //  u3e_pack_version
+        c3_w nor_w;                         //  pages north
+        c3_w sou_w;                         //  pages south
+        c3_w num_w;                         //  nonzero pages
+        c3_w zip_w;                         //  compression, u3e_pack_zlib
+        c3_w vit_w;                         //  loom shift, u3a_vits
+        c3_w pad_w;                         //  0
+        c3_d has_d;                         //  checksum of bitmap and lines
+      } u3e_pack_head;
+
+    /* u3e_pack_line: packed image, nonzero page.
+    */
+      typedef struct _u3e_pack_line {
+        c3_d off_d;                         //  offset in file
+        c3_w len_w;                         //  length, raw if a whole page
+        c3_w pad_w;                         //  0
+        c3_d has_d;                         //  checksum of page
+      } u3e_pack_line;
+
+#     define u3e_pack_magic    0x6b617075   //  "upak"
+#     define u3e_pack_version  2
+#     define u3e_pack_zlib     1
+
     /* u3e_pool: entire memory system.
     */
       typedef struct _u3e_pool {
         c3_c*        dir_c;                     //  path to
         c3_d         evt_d;                     //  last patch written at event
         c3_w         dit_w[u3a_pages >> 5];   //  touched since last save
+        c3_w         pen_w[u3a_pages >> 5];   //  being saved by pid_i
+        c3_i         pid_i;                     //  snapshot child, or 0
         u3e_image  nor_u;                     //  north segment
         u3e_image  sou_u;                     //  south segment
       } u3e_pool;
@@ -59,15 +94,28 @@
   /** Functions.
   **/
     /* u3e_fault(): handle a memory event with libsigsegv protocol.
+    **              unused where the loom is tracked with soft-dirty bits.
     */
       c3_i
       u3e_fault(void* adr_v, c3_i ser_i);
 
-    /* u3e_save():
+    /* u3e_save(): save current changes.
     */
       void
       u3e_save(void);
 
+    /* u3e_fork(): save current changes from a forked child process,
+    **             producing c3y if the child is still saving.
+    */
+      c3_o
+      u3e_fork(void);
+
+    /* u3e_wait(): reap the snapshot child, if any; block iff [hol_o].
+    **             produces c3y if no snapshot is in progress.
+    */
+      c3_o
+      u3e_wait(c3_o hol_o);
+
     /* u3e_live(): start the persistence system.  Return c3y if no image.
     */
       c3_o
@@ -97,3 +145,16 @@
     */
       c3_o
       u3e_wipe(void);
+
+    /* u3e_pack_save(): write the loom to a compressed image at [pax_c].
+    */
+      c3_o
+      u3e_pack_save(c3_c* pax_c);
+
+    /* u3e_pack_load(): read a compressed image at [pax_c] into loom-shaped
+    **                  [bas_w], producing its header in [hed_u].
+    **
+    **   every page is checked; on c3n, [bas_w] holds a partial image.
+    */
+      c3_o
+      u3e_pack_load(c3_c* pax_c, c3_w* bas_w, u3e_pack_head* hed_u);
@@ -15,8 +15,9 @@
     ***  the root node.
     ***
     ***  We store an extra "freshly warm" bit for a simple
-    ***  clock-algorithm reclamation policy, not yet implemented.
-    ***  Search "clock algorithm" to figure it out.
+    ***  clock-algorithm reclamation policy.  Every hit warms its
+    ***  entry; the clock arm (u3h_trim_to()) cools warm entries
+    ***  and evicts cold ones.  Search "clock algorithm" for more.
     **/
       /* u3h_slot: map slot.
       **
@@ -77,8 +78,8 @@
 #     define  u3h_slot_is_node(sot)  ((1 == ((sot) >> 30)) ? c3y : c3n)
 #     define  u3h_slot_is_noun(sot)  ((1 == ((sot) >> 31)) ? c3y : c3n)
 #     define  u3h_slot_is_warm(sot)  (((sot) & 0x40000000) ? c3y : c3n)
-#     define  u3h_slot_to_node(sot)  (u3a_into((sot) & 0x3fffffff))
-#     define  u3h_node_to_slot(ptr)  (u3a_outa(ptr) | 0x40000000)
+#     define  u3h_slot_to_node(sot)  (u3a_into(((sot) & 0x3fffffff) << u3a_vits))
+#     define  u3h_node_to_slot(ptr)  ((u3a_outa(ptr) >> u3a_vits) | 0x40000000)
 #     define  u3h_noun_be_warm(sot)  ((sot) | 0x40000000)
 #     define  u3h_noun_be_cold(sot)  ((sot) & ~0x40000000)
 #     define  u3h_slot_to_noun(sot)  (0x40000000 | (sot))
@@ -86,7 +87,7 @@
 
     /**  Functions.
     ***
-    ***  Needs: delete and merge functions; clock reclamation function.
+    ***  Needs: merge function.
     **/
       /* u3h_new_cache(): create hashtable with bounded size.
       */
@@ -124,6 +125,13 @@
         u3_weak
         u3h_git(u3p(u3h_root) har_p, u3_noun key);
 
+      /* u3h_del(): delete from hashtable, producing yes if [key] was present.
+      **
+      ** `key` is RETAINED.
+      */
+        c3_o
+        u3h_del(u3p(u3h_root) har_p, u3_noun key);
+
       /* u3h_trim_to(): trim to n key-value pairs
       */
         void
@@ -139,6 +147,11 @@
         c3_w
         u3h_mark(u3p(u3h_root) har_p);
 
+      /* u3h_rewrite(): rewrite hashtable for compaction.
+      */
+        void
+        u3h_rewrite(u3p(u3h_root) har_p);
+
       /* u3h_count(): count hashtable for gc.
       */
         c3_w
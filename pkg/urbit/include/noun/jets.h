@@ -105,8 +105,13 @@
       } u3j_rite;
 
     /* u3j_site: site of a kick (nock 9), used to cache call target.
+    **
+    **   the fields below are the most recent target; older
+    **   targets of a polymorphic site are kept in pic_p.
+    **   (pic_p fills what was trailing padding.)
     */
       struct _u3n_prog;
+      struct _u3j_pice;
       typedef struct {
         u3p(struct _u3n_prog) pog_p;  //  program for formula
         u3_noun       axe;            //  axis
@@ -119,8 +124,28 @@
         u3j_core*     cop_u;          //  jet core
         u3j_harm*     ham_u;          //  jet arm
         u3p(u3j_fink) fin_p;          //  fine check
+        u3p(struct _u3j_pice) pic_p;  //  older targets, or 0
       } u3j_site;
 
+    /* u3j_pice: polymorphic inline cache, older targets of a u3j_site.
+    **
+    **   once u3j_pice_meg targets have been evicted, the site is
+    **   megamorphic: its targets are left as they are, and misses
+    **   are resolved through the road's megamorphic cache, u3R->meg_p,
+    **   which is keyed by battery and axis.
+    */
+#       define u3j_pice_no   3        //  older targets per site
+#       define u3j_pice_meg  32       //  evictions before megamorphic
+#       define u3j_pice_mag  0x65636970  //  "pice", checked on ream
+
+      typedef struct _u3j_pice {
+        c3_w          mag_w;          //  u3j_pice_mag
+        u3p(u3j_site) sit_p;          //  owning site
+        c3_w          len_w;          //  targets in use
+        c3_w          mis_w;          //  targets evicted
+        u3j_site      sit_u[u3j_pice_no];  //  targets, most recent first
+      } u3j_pice;
+
   /** Globals.
   **/
     /* u3_Dash: jet dashboard.
@@ -243,9 +268,14 @@
         u3j_site_ream(u3j_site* sit_u);
 
       /* u3j_site_kick(): kick a core with a u3j_site cache.
+       *
+       *   if there's no jet, produces u3_none, and the program
+       *   to run on cor at *pog_p.
        */
         u3_weak
-        u3j_site_kick(u3_noun cor, u3j_site* sit_u);
+        u3j_site_kick(u3_noun cor,
+                      u3j_site* sit_u,
+                      u3p(struct _u3n_prog)* pog_p);
 
       /* u3j_gate_prep(): prepare a locally cached gate to call repeatedly.
        */
@@ -287,6 +317,11 @@
         c3_w
         u3j_mark(FILE* fil_u);
 
+      /* u3j_rewrite_compact(): rewrite jet state for compaction.
+      */
+        void
+        u3j_rewrite_compact(void);
+
       /* u3j_free_hank(): free an entry from the hank cache.
       */
         void
@@ -64,9 +64,12 @@
       /* u3m_soft(): system soft wrapper.  unifies unix and nock errors.
       **
       **  Produces [%$ result] or [%error (list tank)].
+      **
+      **  [fag_w] is u3a_flag bits for the inner road; pass u3a_flag_sand
+      **  for short-lived computations whose garbage can die with the road.
       */
         u3_noun
-        u3m_soft(c3_w sec_w, u3_funk fun_f, u3_noun arg);
+        u3m_soft(c3_w sec_w, c3_w fag_w, u3_funk fun_f, u3_noun arg);
 
       /* u3m_soft_slam: top-level call.
       */
@@ -141,6 +144,11 @@
         void
         u3m_reclaim(void);
 
+      /* u3m_pack(): compact the home road in place, producing words reclaimed.
+      */
+        c3_w
+        u3m_pack(void);
+
       /* u3m_rock_stay(): jam state into [dir_c] at [evt_d]
       */
         c3_o
@@ -117,6 +117,11 @@
       c3_w
       u3n_mark(FILE* fil_u);
 
+    /* u3n_rewrite_compact(): rewrite the bytecode cache for compaction.
+     */
+      void
+      u3n_rewrite_compact(void);
+
     /* u3n_free(): free bytecode cache.
      */
       void
@@ -126,3 +131,19 @@
     */
       void
       u3n_ream(void);
+
+    /* u3n_stay(): extract bytecode cache keys, as (list [mug [pre fol]]).
+    */
+      u3_noun
+      u3n_stay(void);
+
+    /* u3n_load(): recompile bytecode cache keys from u3n_stay(),
+    **             producing the number of programs compiled.
+    */
+      c3_w
+      u3n_load(u3_noun lis);
+
+    /* u3n_damp(): print and clear the dispatch-pair histogram.
+     */
+      void
+      u3n_damp(FILE* fil_u);
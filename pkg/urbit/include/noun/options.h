@@ -30,7 +30,10 @@
         u3o_dryrun =        0x20,             //  don't touch checkpoint
         u3o_quiet =         0x40,             //  disable ~&
         u3o_hashless =      0x80,             //  disable hashboard
-        u3o_trace =         0x100             //  enables trace dumping
+        u3o_trace =         0x100,            //  enables trace dumping
+        u3o_fork_save =     0x200,            //  snapshot from a child process
+        u3o_lazy_load =     0x400,            //  map the snapshot at boot
+        u3o_pack_exit =     0x800             //  packed snapshot on exit
       };
 
   /** Globals.
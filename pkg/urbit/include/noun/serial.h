@@ -4,6 +4,10 @@
     /*  Noun serialization. All noun arguments RETAINED.
     */
 
+      /* u3s_bak: jam backref table, off the loom (opaque).
+      */
+        typedef struct _u3s_bak u3s_bak;
+
       /* u3s_jam_fib(): jam without atom allocation.
       **
       **   returns atom-suitable words, and *bit_w will have
@@ -13,24 +17,67 @@
         u3s_jam_fib(u3_noun a, c3_w* bit_w);
 
       /* u3s_jam_met(): measure a noun for jam, calculating backrefs
+      **
+      **   *bak_u is the caller's until released with u3s_jam_free();
+      **   other jams may run meanwhile.
       */
         c3_d
-        u3s_jam_met(u3_noun a, u3p(u3h_root)* bak_p);
+        u3s_jam_met(u3_noun a, u3s_bak** bak_u);
+
+      /* u3s_jam_free(): release backrefs from u3s_jam_met()
+      */
+        void
+        u3s_jam_free(u3s_bak* bak_u);
 
       /* u3s_jam_buf(): jam [a] into [buf_w], without allocation
       **
-      **   using backrefs in [bak_p], as computed by u3s_jam_met
+      **   using backrefs in [bak_u], as computed by u3s_jam_met
       **   can only encode up to c3_w bits
       */
         void
-        u3s_jam_buf(u3_noun a, u3p(u3h_root) bak_p, c3_w* buf_w);
+        u3s_jam_buf(u3_noun a, u3s_bak* bak_u, c3_w* buf_w);
+
+      /* u3s_jam_flow(): jam [a] in one pass, through a [len_w]-byte [buf_y].
+      **
+      **   each time [buf_y] fills (and once at the end), its contents
+      **   are handed to [fun_f]; a c3n from [fun_f] stops the jam.
+      **   *bit_d will have the length (in bits).
+      */
+        c3_o
+        u3s_jam_flow(u3_noun a,
+                     c3_w    len_w,
+                     c3_y*   buf_y,
+                     c3_o  (*fun_f)(void*, c3_w, c3_y*),
+                     void*   ptr_v,
+                     c3_d*   bit_d);
+
+      /* u3s_jam_fd(): jam [a] to [fid_i], in one pass with bounded memory.
+      */
+        c3_o
+        u3s_jam_fd(u3_noun a, c3_i fid_i);
 
       /* u3s_jam_file(): jam [a] into a file, overwriting
       */
         c3_o
         u3s_jam_file(u3_noun a, c3_c* pas_c);
 
+      /* u3s_cue_bytes(): cue [len_d] bytes at [byt_y], little-endian.
+      **
+      **   backrefs are kept off the loom; [byt_y] may be any buffer
+      **   (such as an LMDB value or newt frame), and is only read.
+      */
+        u3_noun
+        u3s_cue_bytes(c3_d len_d, const c3_y* byt_y);
+
       /* u3s_cue(): cue [a]
       */
         u3_noun
         u3s_cue(u3_atom a);
+
+      /* u3s_cue_file(): cue the contents of a file, mapping it read-only.
+      **
+      **   the file is never copied onto the loom.
+      **   produces u3_none if the file can't be read, or isn't a valid jam.
+      */
+        u3_weak
+        u3s_cue_file(c3_c* pas_c);
@@ -316,6 +316,31 @@
         struct _u3_moor* nex_u;
       } u3_moor;
 
+    /* u3_ring: one-way message stream over shared memory.
+    **
+    **   the mapping holds a single-producer, single-consumer ring
+    **   of message records; eventfds carry wakeups.  one process
+    **   writes, the other reads.
+    */
+      typedef struct _u3_ring {
+        uv_poll_t        pol_u;             //  wakeup watcher
+        u3_bail          bal_f;             //  error response function
+        void*            vod_p;             //  callback pointer
+        u3_poke          pok_f;             //  action function
+        struct _u3_rung* rug_u;             //  shared control block
+        c3_y*            dat_y;             //  shared records
+        c3_d             siz_d;             //  record capacity, power of 2
+        c3_d             max_d;             //  largest unfragmented record
+        c3_d             pos_d;             //  local head (w) or tail (r)
+        c3_i             dat_i;             //  eventfd, records published
+        c3_i             spa_i;             //  eventfd, records released
+        c3_o             wan_o;             //  writer awaiting space
+        c3_d             fra_d;             //  fragmented message length
+        c3_y*            fra_y;             //  fragmented message so far
+        struct _u3_rack* ext_u;             //  exit of pending writes
+        struct _u3_rack* ent_u;             //  entry of pending writes
+      } u3_ring;
+
     /* u3_dent: directory entry.
     */
       typedef struct _u3_dent {
@@ -354,6 +379,7 @@
         uv_signal_t sil_u;                  //  child signal
         c3_d        req_d;                  //  requested at evt_d
         c3_d        dun_d;                  //  completed at evt_d
+        c3_d        dur_d;                  //  reported durable at evt_d
         c3_w        pid_w;                  //  pid of checkpoint process
       } u3_save;
 
@@ -555,10 +581,12 @@
         c3_o    dem;                        //  -d, daemon
         c3_c*   eth_c;                      //  -e, ethereum node url
         c3_c*   fak_c;                      //  -F, fake ship
+        c3_o    fos;                        //  -f, snapshot in the background
         c3_c*   gen_c;                      //  -G, czar generator
         c3_o    gab;                        //  -g, test garbage collection
         c3_c*   dns_c;                      //  -H, ames bootstrap domain
         c3_c*   jin_c;                      //  -I, inject raw event
+        c3_w    gro_w;                      //  -b, group commit wait (ms)
         c3_w    hap_w;                      //  -C, cap memo cache
         c3_c*   lit_c;                      //  -J, ivory (fastboot) kernel
         c3_o    tra;                        //  -j, json trace
@@ -566,6 +594,7 @@
         c3_c*   key_c;                      //  -k, private key file
         c3_o    net;                        //  -L, local-only networking
         c3_o    lit;                        //  -l, lite mode
+        c3_o    map;                        //  -m, map snapshot on demand
         c3_o    pro;                        //  -P, profile
         c3_s    por_s;                      //  -p, ames port
         c3_o    qui;                        //  -q, quiet
@@ -575,8 +604,10 @@
         c3_o    git;                        //  -s, pill url from arvo git hash
         c3_c*   url_c;                      //  -u, pill url
         c3_o    veb;                        //  -v, verbose (inverse of -q)
+        c3_o    shm;                        //  -W, worker i/o in shared memory
         c3_c*   who_c;                      //  -w, begin with ticket
         c3_o    tex;                        //  -x, exit after loading
+        c3_o    zip;                        //  -z, packed snapshot on exit
       } u3_opts;
 
     /* u3_host: entire host.
@@ -621,10 +652,12 @@
         typedef struct _u3_controller {
           uv_process_t         cub_u;           //  process handle
           uv_process_options_t ops_u;           //  process configuration
-          uv_stdio_container_t cod_u[3];        //  process options
+          uv_stdio_container_t cod_u[9];        //  process options
           time_t               wen_t;           //  process creation time
           u3_mojo              inn_u;           //  client's stdin
           u3_moat              out_u;           //  client's stdout
+          u3_ring*             shi_u;           //  shared input, or 0
+          u3_ring*             sho_u;           //  shared output, or 0
           c3_o                 liv_o;           //  live
           c3_d                 sen_d;           //  last event dispatched
           c3_d                 dun_d;           //  last event completed
@@ -648,6 +681,16 @@
           MDB_env*          db_u;               //  lmdb environment.
           c3_d             moc_d;               //  commit requested
           c3_d             com_d;               //  committed
+          c3_d             red_d;               //  replay read through
+          c3_o             red_o;               //  replay read in progress
+          uv_timer_t       gro_u;               //  group commit timer
+          c3_o             gro_o;               //  group commit due
+          c3_d             cos_d;               //  commit start (ns)
+          c3_d             cun_d;               //  commits completed
+          c3_d             cev_d;               //  events committed
+          c3_d             cby_d;               //  bytes committed
+          c3_d             cat_d;               //  total commit latency (ns)
+          c3_d             cax_d;               //  max commit latency (ns)
           struct _u3_pier* pir_u;               //  pier backpointer
         } u3_disk;
 
@@ -694,6 +737,8 @@
           u3_save*         sav_u;               //  autosave
           u3_writ*         ent_u;               //  entry of queue
           u3_writ*         ext_u;               //  exit of queue
+          u3_writ**        dex_u;               //  queue by event number
+          c3_d             dex_d;               //  index size, power of 2
           uv_prepare_t     pep_u;               //  preloop registration
           uv_idle_t        idl_u;               //  postloop registration
         } u3_pier;
@@ -1191,11 +1236,52 @@
                       u3_atom  mat,
                       void*    vod_p);
 
+      /* u3_newt_jam(): jam noun to stream; free noun.
+      */
+        void
+        u3_newt_jam(u3_mojo* moj_u,
+                    u3_noun  som,
+                    void*    vod_p);
+
       /* u3_newt_read(): activate reading on input stream.
       */
         void
         u3_newt_read(u3_moat* mot_u);
 
+      /* u3_newt_ring_make(): create a shared ring of [siz_d] bytes,
+      **                      producing its three descriptors.
+      */
+        c3_o
+        u3_newt_ring_make(c3_d siz_d, c3_i* fid_i);
+
+      /* u3_newt_ring_open(): map a shared ring from its descriptors,
+      **                      to write to it if [wri_o], else to read.
+      **
+      **   the ring takes the eventfds; the memfd stays with the caller.
+      */
+        u3_ring*
+        u3_newt_ring_open(uv_loop_t* lup_u, c3_i* fid_i, c3_o wri_o);
+
+      /* u3_newt_ring_read(): activate reading on shared ring.
+      */
+        void
+        u3_newt_ring_read(u3_ring* rin_u);
+
+      /* u3_newt_ring_write(): write atom to shared ring; free atom.
+      */
+        void
+        u3_newt_ring_write(u3_ring* rin_u, u3_atom mat);
+
+      /* u3_newt_ring_jam(): jam noun to shared ring; free noun.
+      */
+        void
+        u3_newt_ring_jam(u3_ring* rin_u, u3_noun som);
+
+      /* u3_newt_ring_close(): unmap shared ring, dropping pending writes.
+      */
+        void
+        u3_newt_ring_close(u3_ring* rin_u);
+
     /** Pier control.
     **/
       /* u3_pier_db_shutdown(): close the log.
@@ -1362,6 +1448,23 @@
                                                     c3_d id,
                                                     u3_noun mat));
 
+      /* u3_lmdb_read_events_async(): Reads events back from the database
+      **
+      ** Reads back up to |len_d| events starting with |first_event_d| on a
+      ** worker thread. On the main loop thread, each event is then passed to
+      ** |on_event_read|, until it returns c3n, and |on_complete| is called
+      ** with the number of events passed.
+      */
+      void u3_lmdb_read_events_async(u3_pier* pir_u,
+                                     c3_d first_event_d,
+                                     c3_d len_d,
+                                     c3_o(*on_event_read)(u3_pier* pir_u,
+                                                          c3_d id,
+                                                          u3_noun mat),
+                                     void (*on_complete)(c3_o success,
+                                                         u3_pier*,
+                                                         c3_d, c3_d));
+
       /* u3_lmdb_write_identity(): Writes log identity
       **
       ** Returns c3y on complete success; c3n on any error.
@@ -58,6 +58,8 @@ _box_make(void* box_v, c3_w siz_w, c3_w use_w)
   c3_w*    box_w = box_v;
 
   c3_assert(siz_w >= u3a_minimum);
+  c3_assert(0 == (siz_w & (u3a_walign - 1)));
+  c3_assert(0 == (u3a_outa(box_w) & (u3a_walign - 1)));
 
   box_w[0] = siz_w;
   box_w[siz_w - 1] = siz_w;
@@ -266,7 +268,7 @@ _ca_box_make_hat(c3_w len_w, c3_w ald_w, c3_w alp_w, c3_w use_w)
   if ( c3y == u3a_is_north(u3R) ) {
     all_p = u3R->hat_p;
     pad_w = _me_align_pad(all_p, ald_w, alp_w);
-    siz_w = (len_w + pad_w);
+    siz_w = u3a_walign_up(len_w + pad_w);
 
     //  hand-inlined: siz_w >= u3a_open(u3R)
     //
@@ -278,8 +280,8 @@ _ca_box_make_hat(c3_w len_w, c3_w ald_w, c3_w alp_w, c3_w use_w)
   else {
     all_p = (u3R->hat_p - len_w);
     pad_w = _me_align_dap(all_p, ald_w, alp_w);
-    siz_w = (len_w + pad_w);
-    all_p -= pad_w;
+    siz_w = u3a_walign_up(len_w + pad_w);
+    all_p = (u3R->hat_p - siz_w);
 
     //  hand-inlined: siz_w >= u3a_open(u3R)
     //
@@ -291,6 +293,142 @@ _ca_box_make_hat(c3_w len_w, c3_w ald_w, c3_w alp_w, c3_w use_w)
   return _box_make(u3a_into(all_p), siz_w, use_w);
 }
 
+/* _ca_sab_hit_d, _ca_sab_mis_d: slab statistics, across all roads.
+*/
+static c3_d _ca_sab_hit_d[u3a_sabs_no];
+static c3_d _ca_sab_mis_d[u3a_sabs_no];
+
+/* _ca_slab_on(): yes iff small boxes in u3R come from slabs.
+**
+**  As with the cell allocator, there are no slabs on the home road,
+**  and sand roads have no use for free lists.
+*/
+static __inline__ c3_o
+_ca_slab_on(void)
+{
+#ifdef U3_MEMORY_DEBUG
+  if ( u3C.wag_w & u3o_debug_ram ) {
+    return c3n;
+  }
+#endif
+
+  return __( (u3R != &(u3H->rod_u)) &&
+             !(u3R->how.fag_w & u3a_flag_sand) );
+}
+
+/* _ca_slab_some(): yes iff any slab in u3R has a spare box.
+*/
+static c3_o
+_ca_slab_some(void)
+{
+  c3_w sel_w;
+
+  for ( sel_w = 0; sel_w < u3a_sabs_no; sel_w++ ) {
+    if ( u3R->sab_p[sel_w] ) {
+      return c3y;
+    }
+  }
+  return c3n;
+}
+
+/* _ca_slab_block(): refill a slab with boxes carved from the hat.
+*/
+static c3_o
+_ca_slab_block(c3_w sel_w)
+{
+  c3_w    siz_w = u3a_minimum + (sel_w << 1);
+  c3_w    num_w = u3a_sabs_blok / siz_w;
+  u3_post hat_p = u3R->hat_p;
+  u3_post sab_p = u3R->sab_p[sel_w];
+  c3_w    i_w;
+
+  if ( c3y == u3a_is_north(u3R) ) {
+    if ( u3R->cap_p <= (hat_p + (num_w * siz_w)) ) {
+      return c3n;
+    }
+  }
+  else {
+    if ( (u3R->cap_p + (num_w * siz_w)) >= hat_p ) {
+      return c3n;
+    }
+  }
+
+  for ( i_w = 0; i_w < num_w; i_w++ ) {
+    u3_post       all_p;
+    u3p(u3a_fbox) fre_p;
+
+    if ( c3y == u3a_is_north(u3R) ) {
+      all_p  = hat_p;
+      hat_p += siz_w;
+    }
+    else {
+      all_p = (hat_p -= siz_w);
+    }
+
+    fre_p = u3of(u3a_fbox, _box_make(u3a_into(all_p), siz_w, 1));
+    u3to(u3a_fbox, fre_p)->nex_p = sab_p;
+    sab_p = fre_p;
+  }
+
+  u3R->hat_p = hat_p;
+  u3R->sab_p[sel_w] = sab_p;
+
+  _box_count(num_w * siz_w);
+  return c3y;
+}
+
+/* _ca_slab_alloc(): allocate a box of at least [siz_w] words from a slab.
+**
+**  Slab boxes keep a use count of 1 while they're spare, so that
+**  neighboring boxes will never coalesce with them.
+*/
+static void*
+_ca_slab_alloc(c3_w siz_w)
+{
+  c3_w          sel_w = (siz_w - u3a_minimum + 1) >> 1;
+  u3p(u3a_fbox) sab_p = u3R->sab_p[sel_w];
+
+  if ( sab_p ) {
+    _ca_sab_hit_d[sel_w]++;
+  }
+  else {
+    _ca_sab_mis_d[sel_w]++;
+
+    if ( c3n == _ca_slab_block(sel_w) ) {
+      return 0;
+    }
+    sab_p = u3R->sab_p[sel_w];
+  }
+
+  {
+    u3a_box* box_u = &(u3to(u3a_fbox, sab_p)->box_u);
+
+    u3R->sab_p[sel_w] = u3to(u3a_fbox, sab_p)->nex_p;
+    box_u->use_w = 1;
+
+#ifdef U3_MEMORY_DEBUG
+    box_u->cod_w = u3_Code;
+#endif
+
+    _box_count(-(box_u->siz_w));
+    return u3a_boxto(box_u);
+  }
+}
+
+/* _ca_slab_free(): return a box to the slab for its size.
+*/
+static void
+_ca_slab_free(u3a_box* box_u)
+{
+  c3_w          sel_w = (box_u->siz_w - u3a_minimum) >> 1;
+  u3p(u3a_fbox) fre_p = u3of(u3a_fbox, box_u);
+
+  _box_count(box_u->siz_w);
+
+  u3to(u3a_fbox, fre_p)->nex_p = u3R->sab_p[sel_w];
+  u3R->sab_p[sel_w] = fre_p;
+}
+
 #if 0
 /* _me_road_all_hat(): in u3R, allocate directly on the hat.
 */
@@ -353,12 +491,13 @@ u3a_sane(void)
 }
 #endif
 
-/* u3a_reflux(): dump 1K cells from the cell list into regular memory.
+/* u3a_reflux(): dump 1K cells from the cell list, and 1K boxes from
+** each slab, into regular memory.
 */
 void
 u3a_reflux(void)
 {
-  c3_w i_w;
+  c3_w i_w, sel_w;
 
   for ( i_w = 0; u3R->all.cel_p && (i_w < 1024); i_w++ ) {
     u3_post  cel_p = u3R->all.cel_p;
@@ -372,6 +511,18 @@ u3a_reflux(void)
     _box_free(box_u);
 
   }
+
+  for ( sel_w = 0; sel_w < u3a_sabs_no; sel_w++ ) {
+    for ( i_w = 0; u3R->sab_p[sel_w] && (i_w < 1024); i_w++ ) {
+      u3_post  sab_p = u3R->sab_p[sel_w];
+      u3a_box* box_u = &(u3to(u3a_fbox, sab_p)->box_u);
+
+      u3R->sab_p[sel_w] = u3to(u3a_fbox, sab_p)->nex_p;
+
+      _box_count(-(box_u->siz_w));
+      _box_free(box_u);
+    }
+  }
 }
 
 /* u3a_reclaim(): reclaim from memoization cache.
@@ -407,11 +558,22 @@ u3a_reclaim(void)
 static void*
 _ca_willoc(c3_w len_w, c3_w ald_w, c3_w alp_w)
 {
-  c3_w siz_w = c3_max(u3a_minimum, u3a_boxed(len_w));
+  c3_w siz_w = u3a_walign_up(c3_max(u3a_minimum, u3a_boxed(len_w)));
   c3_w sel_w = _box_slot(siz_w);
 
   alp_w = (alp_w + c3_wiseof(u3a_box)) % ald_w;
 
+  //  sand roads never free, so there is nothing to search or reclaim
+  //
+  if ( c3y == u3a_is_sand(u3R) ) {
+    u3a_box* box_u = _ca_box_make_hat(siz_w, ald_w, alp_w, 1);
+
+    if ( 0 == box_u ) {
+      u3m_bail(c3__meme);
+    }
+    return u3a_boxto(box_u);
+  }
+
   //  XX: this logic is totally bizarre, but preserve it.
   //
   if ( (sel_w != 0) && (sel_w != u3a_fbox_no - 1) ) {
@@ -438,10 +600,10 @@ _ca_willoc(c3_w len_w, c3_w ald_w, c3_w alp_w)
           // if ( (u3a_open(u3R) + u3R->all.fre_w) < 65536 ) { u3a_reclaim(); }
           box_u = _ca_box_make_hat(siz_w, ald_w, alp_w, 1);
 
-          /* Flush a bunch of cell cache, then try again.
+          /* Flush a bunch of cell and slab cache, then try again.
           */
           if ( 0 == box_u ) {
-            if ( u3R->all.cel_p ) {
+            if ( u3R->all.cel_p || (c3y == _ca_slab_some()) ) {
               u3a_reflux();
 
               return _ca_willoc(len_w, ald_w, alp_w);
@@ -471,7 +633,7 @@ _ca_willoc(c3_w len_w, c3_w ald_w, c3_w alp_w)
           /* We have found a free block of adequate size.  Remove it
           ** from the free list.
           */
-          siz_w += pad_w;
+          siz_w = u3a_walign_up(siz_w + pad_w);
           _box_count(-(box_u->siz_w));
           {
             if ( (0 != u3to(u3a_fbox, *pfr_p)->pre_p) &&
@@ -545,6 +707,16 @@ void*
 u3a_walloc(c3_w len_w)
 {
   void* ptr_v;
+  c3_w  siz_w = c3_max(u3a_minimum, u3a_boxed(len_w));
+
+  //  small boxes come from exact-size slabs, when we have them
+  //
+  if ( (siz_w <= u3a_sabs_max) &&
+       (c3y == _ca_slab_on()) &&
+       (0 != (ptr_v = _ca_slab_alloc(siz_w))) )
+  {
+    return ptr_v;
+  }
 
   ptr_v = _ca_walloc(len_w, 1, 0);
 
@@ -657,7 +829,25 @@ u3a_peek(c3_w len_w)
 void
 u3a_wfree(void* tox_v)
 {
-  _box_free(u3a_botox(tox_v));
+  //  sand roads are discarded wholesale
+  //
+  if ( c3y == u3a_is_sand(u3R) ) {
+    return;
+  }
+
+  {
+    u3a_box* box_u = u3a_botox(tox_v);
+
+    if ( (1 == box_u->use_w) &&
+         (box_u->siz_w <= u3a_sabs_max) &&
+         (c3y == _ca_slab_on()) )
+    {
+      _ca_slab_free(box_u);
+    }
+    else {
+      _box_free(box_u);
+    }
+  }
 }
 
 /* u3a_calloc(): allocate and zero-initialize array
@@ -803,6 +993,10 @@ u3a_celloc(void)
 
   u3p(u3a_fbox) cel_p;
 
+  if ( c3y == u3a_is_sand(u3R) ) {
+    return u3a_walloc(c3_wiseof(u3a_cell));
+  }
+
   if ( !(cel_p = u3R->all.cel_p) ) {
     if ( u3R == &(u3H->rod_u) ) {
       // no cell allocator on home road
@@ -841,6 +1035,10 @@ u3a_cfree(c3_w* cel_w)
   }
 #endif
 
+  if ( c3y == u3a_is_sand(u3R) ) {
+    return;
+  }
+
   if ( u3R == &(u3H->rod_u) ) {
     return u3a_wfree(cel_w);
   }
@@ -1461,7 +1659,9 @@ u3a_gain(u3_noun som)
   u3t_on(mal_o);
   c3_assert(u3_none != som);
 
-  if ( !_(u3a_is_cat(som)) ) {
+  //  sand roads don't count references (see u3a_is_mutable())
+  //
+  if ( !_(u3a_is_cat(som)) && !_(u3a_is_sand(u3R)) ) {
     som = _(u3a_is_north(u3R))
               ? _me_gain_north(som)
               : _me_gain_south(som);
@@ -1477,7 +1677,7 @@ void
 u3a_lose(u3_noun som)
 {
   u3t_on(mal_o);
-  if ( !_(u3a_is_cat(som)) ) {
+  if ( !_(u3a_is_cat(som)) && !_(u3a_is_sand(u3R)) ) {
     if ( _(u3a_is_north(u3R)) ) {
       _me_lose_north(som);
     } else {
@@ -1878,13 +2078,13 @@ u3a_print_memory(FILE* fil_u, c3_c* cap_c, c3_w wor_w)
 {
   c3_assert( 0 != fil_u );
 
-  c3_w byt_w = (wor_w * 4);
-  c3_w gib_w = (byt_w / 1000000000);
-  c3_w mib_w = (byt_w % 1000000000) / 1000000;
-  c3_w kib_w = (byt_w % 1000000) / 1000;
-  c3_w bib_w = (byt_w % 1000);
+  c3_d byt_d = ((c3_d)wor_w * 4);
+  c3_w gib_w = (byt_d / 1000000000);
+  c3_w mib_w = (byt_d % 1000000000) / 1000000;
+  c3_w kib_w = (byt_d % 1000000) / 1000;
+  c3_w bib_w = (byt_d % 1000);
 
-  if ( byt_w ) {
+  if ( byt_d ) {
     if ( gib_w ) {
       fprintf(fil_u, "%s: GB/%d.%03d.%03d.%03d\r\n",
           cap_c, gib_w, mib_w, kib_w, bib_w);
@@ -1912,6 +2112,266 @@ u3a_maid(FILE* fil_u, c3_c* cap_c, c3_w wor_w)
   return wor_w;
 }
 
+/* _ca_meld_frame: a noun waiting to be melded.
+*/
+typedef struct {
+  u3_noun* pot;                             //  referring slot
+  u3_noun  som;                             //  noun, retained
+  c3_y     sat_y;                           //  0: fresh, 1: head, 2: tail
+} _ca_meld_frame;
+
+/* _ca_meld_stack: meld traversal state.  Off-loom, so it does not
+** survive a restart; u3a_meld() then starts over from u3R->mel.
+*/
+static struct {
+  c3_t            liv_t;                    //  stack is current
+  c3_w            len_w;                    //  frames allocated
+  c3_w            dep_w;                    //  frames in use
+  _ca_meld_frame* fam_u;                    //  frames
+} _ca_meld_u;
+
+/* _ca_meld_push(): push [som] (transferred), referred to from [pot].
+*/
+static void
+_ca_meld_push(u3_noun* pot, u3_noun som)
+{
+  if ( _ca_meld_u.dep_w == _ca_meld_u.len_w ) {
+    _ca_meld_u.len_w = ( 0 == _ca_meld_u.len_w ) ? 1024 : (2 * _ca_meld_u.len_w);
+    _ca_meld_u.fam_u = c3_realloc(_ca_meld_u.fam_u,
+                                  _ca_meld_u.len_w * sizeof(_ca_meld_frame));
+  }
+
+  {
+    _ca_meld_frame* fam_u = &(_ca_meld_u.fam_u[_ca_meld_u.dep_w++]);
+
+    fam_u->pot   = pot;
+    fam_u->som   = som;
+    fam_u->sat_y = 0;
+  }
+}
+
+/* _ca_meld_now(): microsecond clock.
+*/
+static c3_d
+_ca_meld_now(void)
+{
+  struct timeval tim_tv;
+
+  gettimeofday(&tim_tv, 0);
+  return (1000000ULL * tim_tv.tv_sec) + tim_tv.tv_usec;
+}
+
+/* _ca_meld_free(): words that losing the last reference to [som] releases.
+**
+**  Exact for trees; sharing within [som] is not counted.
+*/
+static c3_w
+_ca_meld_free(u3_noun som)
+{
+  c3_w siz_w = 0;
+
+  while ( (c3y == u3a_is_dog(som)) && (1 == u3a_use(som)) ) {
+    siz_w += u3a_botox(u3a_to_ptr(som))->siz_w;
+
+    if ( c3n == u3a_is_cell(som) ) {
+      break;
+    }
+    siz_w += _ca_meld_free(u3h(som));
+    som = u3t(som);
+  }
+
+  return siz_w;
+}
+
+/* _ca_meld_swap(): replace [som] at [pot] with its canonical copy [can].
+**
+**  Both are transferred.  The slot may have changed since [som] was
+**  read from it (u3r_sing() unifies in place), in which case it is
+**  left alone.
+*/
+static c3_w
+_ca_meld_swap(u3_noun* pot, u3_noun som, u3_noun can)
+{
+  c3_w siz_w = 0;
+
+  if ( (can != som) && (som == *pot) ) {
+    u3z(som);
+    siz_w = _ca_meld_free(som);
+    *pot  = can;
+    u3z(som);
+  }
+  else {
+    u3z(can);
+    u3z(som);
+  }
+
+  return siz_w;
+}
+
+/* _ca_meld_step(): advance the top frame of the meld stack.
+*/
+static c3_w
+_ca_meld_step(u3p(u3h_root) har_p)
+{
+  _ca_meld_frame* fam_u = &(_ca_meld_u.fam_u[_ca_meld_u.dep_w - 1]);
+  u3_noun         som   = fam_u->som;
+
+  switch ( fam_u->sat_y ) {
+    default: c3_assert(0);
+
+    case 0: {
+      u3_weak can = u3h_get(har_p, som);
+
+      if ( u3_none != can ) {
+        _ca_meld_u.dep_w--;
+        return _ca_meld_swap(fam_u->pot, som, can);
+      }
+      else if ( c3n == u3a_is_cell(som) ) {
+        _ca_meld_u.dep_w--;
+        u3h_put(har_p, som, som);
+        return 0;
+      }
+      else {
+        u3a_cell* cel_u = u3a_to_ptr(som);
+
+        fam_u->sat_y = 1;
+        if ( c3y == u3a_is_dog(cel_u->hed) ) {
+          _ca_meld_push(&(cel_u->hed), u3k(cel_u->hed));
+        }
+        return 0;
+      }
+    }
+
+    case 1: {
+      u3a_cell* cel_u = u3a_to_ptr(som);
+
+      fam_u->sat_y = 2;
+      if ( c3y == u3a_is_dog(cel_u->tel) ) {
+        _ca_meld_push(&(cel_u->tel), u3k(cel_u->tel));
+      }
+      return 0;
+    }
+
+    case 2: {
+      _ca_meld_u.dep_w--;
+      u3h_put(har_p, som, som);
+      return 0;
+    }
+  }
+}
+
+/* u3a_meld_start(): begin canonicalizing [som] on the home road.
+*/
+void
+u3a_meld_start(u3_noun som)
+{
+  c3_assert( &(u3H->rod_u) == u3R );
+  c3_assert( c3n == u3a_meld_live() );
+
+  u3R->mel   = som;
+  u3R->mel_p = u3h_new();
+}
+
+/* u3a_meld_live(): c3y if a meld is in progress.
+*/
+c3_o
+u3a_meld_live(void)
+{
+  return __(0 != u3R->mel_p);
+}
+
+/* _ca_meld_room: contiguous words a meld step must leave free.
+**
+**  A step allocates at most a few table nodes, but running out of
+**  loom on the home road is fatal, so we stop well short of it.
+*/
+#define _ca_meld_room  (1 << 16)
+
+/* u3a_meld(): meld for at most [mil_w] milliseconds (0 for no limit),
+**             adding words released to [sav_w].  c3y if finished.
+**
+**  Each distinct cell and indirect atom reachable from u3R->mel is
+**  entered in a table, by value; each later duplicate is replaced by
+**  the entry, and released.  Everything is retained from the root
+**  down to the current noun, so events may run between slices.
+**
+**  If the loom is too full to go on, the meld is abandoned (freeing
+**  its table) and c3n produced, with u3a_meld_live() then c3n.
+*/
+c3_o
+u3a_meld(c3_w mil_w, c3_w* sav_w)
+{
+  c3_d end_d = _ca_meld_now() + (1000ULL * mil_w);
+  c3_w i_w   = 0;
+
+  c3_assert( c3y == u3a_meld_live() );
+
+  //  start from the root, or resume from it if our stack was lost
+  //
+  if ( !_ca_meld_u.liv_t ) {
+    _ca_meld_u.liv_t = 1;
+
+    if ( c3y == u3a_is_dog(u3R->mel) ) {
+      _ca_meld_push(&(u3R->mel), u3k(u3R->mel));
+    }
+  }
+
+  while ( 0 != _ca_meld_u.dep_w ) {
+    if ( u3a_open(u3R) < _ca_meld_room ) {
+      u3a_meld_stop();
+      return c3n;
+    }
+
+    *sav_w += _ca_meld_step(u3R->mel_p);
+
+    if ( (0 != mil_w) && (0 == (++i_w % 1024)) && (_ca_meld_now() > end_d) ) {
+      return c3n;
+    }
+  }
+
+  return c3y;
+}
+
+/* u3a_meld_stop(): finish or abandon a meld, releasing its state.
+*/
+void
+u3a_meld_stop(void)
+{
+  while ( 0 != _ca_meld_u.dep_w ) {
+    u3z(_ca_meld_u.fam_u[--_ca_meld_u.dep_w].som);
+  }
+  _ca_meld_u.liv_t = 0;
+
+  if ( 0 != u3R->mel_p ) {
+    u3h_free(u3R->mel_p);
+    u3R->mel_p = 0;
+  }
+
+  u3z(u3R->mel);
+  u3R->mel = u3_nul;
+}
+
+/* _ca_mark_meld(): mark meld state for gc.
+*/
+static c3_w
+_ca_mark_meld(void)
+{
+  c3_w tot_w = 0;
+
+  if ( c3y == u3a_meld_live() ) {
+    c3_w i_w;
+
+    tot_w += u3a_mark_noun(u3R->mel);
+    tot_w += u3h_mark(u3R->mel_p);
+
+    for ( i_w = 0; i_w < _ca_meld_u.dep_w; i_w++ ) {
+      tot_w += u3a_mark_noun(_ca_meld_u.fam_u[i_w].som);
+    }
+  }
+
+  return tot_w;
+}
+
 /* u3a_mark_road(): mark ad-hoc persistent road structures.
 */
 c3_w
@@ -1925,6 +2385,7 @@ u3a_mark_road(FILE* fil_u)
   tot_w += u3a_maid(fil_u, "  profile doss", u3a_mark_noun(u3R->pro.day));
   tot_w += u3a_maid(fil_u, "  new profile trace", u3a_mark_noun(u3R->pro.trace));
   tot_w += u3a_maid(fil_u, "  memoization cache", u3h_mark(u3R->cax.har_p));
+  tot_w += u3a_maid(fil_u, "  meld state", _ca_mark_meld());
   return   u3a_maid(fil_u, "total road stuff", tot_w);
 }
 
@@ -2057,6 +2518,47 @@ u3a_idle(u3a_road* rod_u)
   return fre_w;
 }
 
+/* u3a_idle_slabs(): measure slab lists in [rod_u]
+*/
+c3_w
+u3a_idle_slabs(u3a_road* rod_u)
+{
+  c3_w sel_w, fre_w = 0;
+
+  for ( sel_w = 0; sel_w < u3a_sabs_no; sel_w++ ) {
+    u3p(u3a_fbox) fre_p = rod_u->sab_p[sel_w];
+
+    while ( fre_p ) {
+      u3a_fbox* fox_u = u3to(u3a_fbox, fre_p);
+
+      fre_w += fox_u->box_u.siz_w;
+      fre_p  = fox_u->nex_p;
+    }
+  }
+
+  return fre_w;
+}
+
+/* u3a_print_slabs(): print slab hits and misses.
+*/
+void
+u3a_print_slabs(FILE* fil_u)
+{
+  c3_w sel_w;
+
+  c3_assert( 0 != fil_u );
+
+  for ( sel_w = 0; sel_w < u3a_sabs_no; sel_w++ ) {
+    c3_d hit_d = _ca_sab_hit_d[sel_w];
+    c3_d mis_d = _ca_sab_mis_d[sel_w];
+
+    if ( hit_d || mis_d ) {
+      fprintf(fil_u, "  slab %2u words: %" PRIu64 " hit, %" PRIu64 " miss\r\n",
+                     u3a_minimum + (sel_w << 1), hit_d, mis_d);
+    }
+  }
+}
+
 /* u3a_sweep(): sweep a fully marked road.
 */
 c3_w
@@ -2180,6 +2682,159 @@ u3a_sweep(void)
   return neg_w;
 }
 
+/* u3a_pack_seek(): sweep the heap, recording new addresses in boxes.
+**
+**  Every live box is assigned the lowest address not taken by the
+**  live boxes below it.  That address is kept in the trailing size
+**  word of the box until u3a_pack_move() restores it.
+*/
+void
+u3a_pack_seek(u3a_road* rod_u)
+{
+  c3_w*   box_w = u3a_into(rod_u->rut_p);
+  c3_w*   end_w = u3a_into(rod_u->hat_p);
+  u3_post new_p = rod_u->rut_p;
+
+  c3_assert( c3y == u3a_is_north(rod_u) );
+  c3_assert( 0 == rod_u->all.cel_p );
+  c3_assert( 0 == u3a_idle_slabs(rod_u) );
+
+  while ( box_w < end_w ) {
+    u3a_box* box_u = (void *)box_w;
+    c3_w     siz_w = box_u->siz_w;
+
+    if ( box_u->use_w ) {
+      box_w[siz_w - 1] = new_p;
+      new_p += siz_w;
+    }
+    box_w += siz_w;
+  }
+}
+
+/* u3a_pack_move(): sweep the heap, sliding boxes to their new addresses.
+*/
+void
+u3a_pack_move(u3a_road* rod_u)
+{
+  c3_w*   box_w = u3a_into(rod_u->rut_p);
+  c3_w*   end_w = u3a_into(rod_u->hat_p);
+  u3_post new_p = rod_u->rut_p;
+  c3_w    i_w;
+
+  c3_assert( c3y == u3a_is_north(rod_u) );
+
+  while ( box_w < end_w ) {
+    u3a_box* box_u = (void *)box_w;
+    c3_w     siz_w = box_u->siz_w;
+
+    if ( box_u->use_w ) {
+      c3_w* new_w = u3a_into(new_p);
+
+      c3_assert( new_p == box_w[siz_w - 1] );
+
+      box_u->use_w &= 0x7fffffff;
+      box_w[siz_w - 1] = siz_w;
+
+      if ( new_w != box_w ) {
+        memmove(new_w, box_w, (siz_w << 2));
+      }
+      new_p += siz_w;
+    }
+    box_w += siz_w;
+  }
+
+  //  the free lists are gone; everything above [new_p] is wilderness
+  //
+  for ( i_w = 0; i_w < u3a_fbox_no; i_w++ ) {
+    rod_u->all.fre_p[i_w] = 0;
+  }
+  rod_u->all.fre_w = 0;
+  rod_u->hat_p = new_p;
+}
+
+/* u3a_rewrite_ptr(): mark a pointer as rewritten; c3n if it already was.
+*/
+c3_o
+u3a_rewrite_ptr(void* ptr_v)
+{
+  u3a_box* box_u = u3a_botox(ptr_v);
+
+  if ( box_u->use_w & 0x80000000 ) {
+    return c3n;
+  }
+
+  box_u->use_w |= 0x80000000;
+  return c3y;
+}
+
+/* u3a_rewritten(): new location of the allocation at [ptr_p].
+*/
+u3_post
+u3a_rewritten(u3_post ptr_p)
+{
+  u3a_box* box_u = u3a_botox(u3a_into(ptr_p));
+  c3_w*    box_w = (c3_w *)(void *)box_u;
+
+  return box_w[box_u->siz_w - 1] + c3_wiseof(u3a_box);
+}
+
+/* u3a_rewritten_noun(): new reference to [som].
+*/
+u3_noun
+u3a_rewritten_noun(u3_noun som)
+{
+  if ( (u3_none == som) || _(u3a_is_cat(som)) ) {
+    return som;
+  }
+  else {
+    u3_post som_p = u3a_rewritten(u3a_to_off(som));
+
+    return _(u3a_is_pom(som)) ? u3a_to_pom(som_p) : u3a_to_pug(som_p);
+  }
+}
+
+/* u3a_rewrite_noun(): rewrite the references inside [som].
+*/
+void
+u3a_rewrite_noun(u3_noun som)
+{
+  while ( (u3_none != som) && _(u3a_is_cell(som)) ) {
+    u3a_cell* cel_u = u3a_to_ptr(som);
+
+    if ( c3n == u3a_rewrite_ptr(cel_u) ) {
+      return;
+    }
+
+    u3a_rewrite_noun(cel_u->hed);
+    som = cel_u->tel;
+
+    cel_u->hed = u3a_rewritten_noun(cel_u->hed);
+    cel_u->tel = u3a_rewritten_noun(cel_u->tel);
+  }
+}
+
+/* u3a_rewrite_compact(): rewrite ad-hoc persistent road structures.
+*/
+void
+u3a_rewrite_compact(void)
+{
+  u3a_rewrite_noun(u3R->ski.gul);
+  u3a_rewrite_noun(u3R->bug.tax);
+  u3a_rewrite_noun(u3R->bug.mer);
+  u3a_rewrite_noun(u3R->pro.don);
+  u3a_rewrite_noun(u3R->pro.day);
+  u3a_rewrite_noun(u3R->pro.trace);
+  u3h_rewrite(u3R->cax.har_p);
+
+  u3R->ski.gul   = u3a_rewritten_noun(u3R->ski.gul);
+  u3R->bug.tax   = u3a_rewritten_noun(u3R->bug.tax);
+  u3R->bug.mer   = u3a_rewritten_noun(u3R->bug.mer);
+  u3R->pro.don   = u3a_rewritten_noun(u3R->pro.don);
+  u3R->pro.day   = u3a_rewritten_noun(u3R->pro.day);
+  u3R->pro.trace = u3a_rewritten_noun(u3R->pro.trace);
+  u3R->cax.har_p = u3a_rewritten(u3R->cax.har_p);
+}
+
 /* u3a_slab(): create a length-bounded proto-atom.
 */
 c3_w*
@@ -2328,16 +2983,19 @@ u3a_mint(c3_w* sal_w, c3_w len_w)
     c3_w old_w = nov_u->len_w;
     c3_w dif_w = (old_w - len_w);
 
-    if ( dif_w >= u3a_minimum ) {
+    if ( (dif_w >= u3a_minimum) && !_(u3a_is_sand(u3R)) ) {
       c3_w* box_w = (void *)u3a_botox(nov_w);
-      c3_w* end_w = (nov_w + c3_wiseof(u3a_atom) + len_w + 1);
-      c3_w  asz_w = (end_w - box_w);
+      c3_w  asz_w = u3a_walign_up((nov_w + c3_wiseof(u3a_atom) + len_w + 1)
+                                  - box_w);
+      c3_w* end_w = (box_w + asz_w);
       c3_w  bsz_w = box_w[0] - asz_w;
 
-      _box_attach(_box_make(end_w, bsz_w, 0));
+      if ( bsz_w >= u3a_minimum ) {
+        _box_attach(_box_make(end_w, bsz_w, 0));
 
-      box_w[0] = asz_w;
-      box_w[asz_w - 1] = asz_w;
+        box_w[0] = asz_w;
+        box_w[asz_w - 1] = asz_w;
+      }
     }
     nov_u->len_w = len_w;
   }
@@ -3,9 +3,15 @@
 */
 #include <errno.h>
 #include <fcntl.h>
+#include <murmur3.h>
+#include <pthread.h>
+#include <stddef.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
+#include <sys/wait.h>
 
 #include "all.h"
+#include <zlib.h>
 
 #ifdef U3_SNAPSHOT_VALIDATION
 /* Image check.
@@ -166,6 +172,190 @@ u3e_fault(void* adr_v, c3_i ser_i)
   return 1;
 }
 
+/* Soft-dirty write tracking.
+
+  Where the kernel supports it, we leave the loom writable and find
+  the pages written since the last snapshot in the soft-dirty bit
+  (55) of their /proc/self/pagemap entries, instead of taking a fault
+  on the first write to each page.  Writing "4" to /proc/self/clear_refs
+  resets the bits.  _ce_soft_scan() folds them into u3P.dit_w, so the
+  rest of the checkpointing system is none the wiser.
+
+  If the bits don't behave as advertised when we try them at boot,
+  we fall back to protecting the loom and handling SIGSEGV.
+*/
+static struct {
+  c3_t bot_t;                             //  tried at boot
+  c3_t sof_t;                             //  using soft-dirty bits
+  c3_i pam_i;                             //  /proc/self/pagemap
+  c3_i cle_i;                             //  /proc/self/clear_refs
+  c3_w per_w;                             //  pagemap entries per page
+} u3W;
+
+#define _ce_soft_bit  (1ULL << 55)
+
+/* _ce_soft_clear(): reset all soft-dirty bits.
+*/
+static c3_o
+_ce_soft_clear(void)
+{
+  ssize_t ret_i;
+
+  do {
+    ret_i = pwrite(u3W.cle_i, "4", 1, 0);
+  }
+  while ( (-1 == ret_i) && (EINTR == errno) );
+
+  return ( 1 == ret_i ) ? c3y : c3n;
+}
+
+/* _ce_soft_read(): read pagemap entries for [len_w] system pages at [adr_v].
+*/
+static c3_o
+_ce_soft_read(void* adr_v, c3_w len_w, c3_d* ent_d)
+{
+  c3_d    off_d = ((c3_d)(c3_p)adr_v / (c3_d)getpagesize()) * sizeof(c3_d);
+  size_t  siz_i = len_w * sizeof(c3_d);
+  ssize_t ret_i;
+
+  do {
+    ret_i = pread(u3W.pam_i, ent_d, siz_i, off_d);
+  }
+  while ( (-1 == ret_i) && (EINTR == errno) );
+
+  return ( siz_i == (size_t)ret_i ) ? c3y : c3n;
+}
+
+/* _ce_soft_probe(): check that soft-dirty bits track writes to [pag_y].
+*/
+static c3_o
+_ce_soft_probe(volatile c3_y* pag_y)
+{
+  c3_d ent_d;
+
+  pag_y[0] = 1;
+
+  if (  (c3n == _ce_soft_clear())
+     || (c3n == _ce_soft_read((void*)pag_y, 1, &ent_d))
+     || (ent_d & _ce_soft_bit) )
+  {
+    return c3n;
+  }
+
+  pag_y[0] = 2;
+
+  if (  (c3n == _ce_soft_read((void*)pag_y, 1, &ent_d))
+     || !(ent_d & _ce_soft_bit) )
+  {
+    return c3n;
+  }
+
+  return c3y;
+}
+
+/* _ce_soft_init(): try to track writes with soft-dirty bits.
+*/
+static c3_o
+_ce_soft_init(void)
+{
+  c3_w  siz_w = getpagesize();
+  void* pag_v;
+  c3_o  ret_o;
+
+  if ( (1 << (u3a_page + 2)) < siz_w ) {
+    return c3n;
+  }
+
+  if ( -1 == (u3W.pam_i = open("/proc/self/pagemap", O_RDONLY)) ) {
+    return c3n;
+  }
+
+  if ( -1 == (u3W.cle_i = open("/proc/self/clear_refs", O_WRONLY)) ) {
+    close(u3W.pam_i);
+    return c3n;
+  }
+
+  pag_v = mmap(0, siz_w, (PROT_READ | PROT_WRITE),
+               (MAP_ANON | MAP_PRIVATE), -1, 0);
+
+  if ( MAP_FAILED == pag_v ) {
+    ret_o = c3n;
+  }
+  else {
+    ret_o = _ce_soft_probe(pag_v);
+    munmap(pag_v, siz_w);
+  }
+
+  if ( c3n == ret_o ) {
+    close(u3W.pam_i);
+    close(u3W.cle_i);
+    return c3n;
+  }
+
+  u3W.per_w = (1 << (u3a_page + 2)) / siz_w;
+  return c3y;
+}
+
+/* _ce_soft_range(): mark written pages in [pag_w, pag_w + len_w) dirty.
+*/
+static void
+_ce_soft_range(c3_w pag_w, c3_w len_w)
+{
+  c3_d ent_d[512];
+  c3_y* adr_y = (c3_y*)(u3_Loom + (pag_w << u3a_page));
+  c3_w  tot_w = len_w * u3W.per_w;
+  c3_w  i_w, j_w, num_w;
+
+  for ( i_w = 0; i_w < tot_w; i_w += num_w ) {
+    num_w = c3_min(512, tot_w - i_w);
+
+    if ( c3n == _ce_soft_read(adr_y + ((c3_d)i_w * getpagesize()),
+                              num_w, ent_d) )
+    {
+      fprintf(stderr, "loom: pagemap read: %s\r\n", strerror(errno));
+      c3_assert(0);
+    }
+
+    for ( j_w = 0; j_w < num_w; j_w++ ) {
+      if ( ent_d[j_w] & _ce_soft_bit ) {
+        c3_w dit_w = pag_w + ((i_w + j_w) / u3W.per_w);
+
+        u3P.dit_w[dit_w >> 5] |= (1 << (dit_w & 31));
+      }
+    }
+  }
+}
+
+/* _ce_soft_scan(): collect pages written since the last scan.
+
+  Only pages within the watermarks are collected; as with
+  _ce_patch_junk_page(), writes to the rest of the loom are forgotten.
+*/
+static void
+_ce_soft_scan(void)
+{
+  c3_w nwr_w, swu_w, nor_w, sou_w;
+
+  if ( !u3W.sof_t ) {
+    return;
+  }
+
+  u3m_water(&nwr_w, &swu_w);
+
+  nor_w = (nwr_w + ((1 << u3a_page) - 1)) >> u3a_page;
+  sou_w = (swu_w + ((1 << u3a_page) - 1)) >> u3a_page;
+
+  _ce_soft_range(0, nor_w);
+  _ce_soft_range(u3a_pages - sou_w, sou_w);
+
+  //  nothing else writes to the loom, so no write is lost in between
+  //
+  if ( c3n == _ce_soft_clear() ) {
+    fprintf(stderr, "loom: clear_refs: %s\r\n", strerror(errno));
+    c3_assert(0);
+  }
+}
+
 /* _ce_image_open(): open or create image.
 */
 static c3_o
@@ -301,44 +491,109 @@ _ce_patch_delete(void)
   unlink(ful_c);
 }
 
+/* _ce_batch: most pages per vectored read or write.
+*/
+#define _ce_batch  256
+
+/* _ce_io_all(): vectored read or write at [off_d], resuming if short.
+*/
+static c3_o
+_ce_io_all(c3_o          wri_o,
+           c3_i          fid_i,
+           struct iovec* iov_u,
+           c3_i          cnt_i,
+           c3_d          off_d)
+{
+  while ( cnt_i ) {
+    ssize_t ret_i = ( c3y == wri_o )
+                    ? pwritev(fid_i, iov_u, cnt_i, off_d)
+                    : preadv(fid_i, iov_u, cnt_i, off_d);
+
+    if ( -1 == ret_i ) {
+      if ( EINTR == errno ) {
+        continue;
+      }
+      return c3n;
+    }
+    else if ( 0 == ret_i ) {
+      errno = EIO;
+      return c3n;
+    }
+
+    off_d += ret_i;
+
+    while ( cnt_i && ((size_t)ret_i >= iov_u->iov_len) ) {
+      ret_i -= iov_u->iov_len;
+      iov_u++;
+      cnt_i--;
+    }
+
+    if ( cnt_i ) {
+      iov_u->iov_base = (c3_y*)iov_u->iov_base + ret_i;
+      iov_u->iov_len -= ret_i;
+    }
+  }
+
+  return c3y;
+}
+
+/* _ce_patch_read_pages(): read [pgs_w] pages of patch memory from [pgc_w].
+*/
+static c3_o
+_ce_patch_read_pages(u3_ce_patch* pat_u,
+                     c3_w         pgc_w,
+                     c3_w         pgs_w,
+                     c3_w*        mem_w)
+{
+  struct iovec iov_u;
+
+  iov_u.iov_base = mem_w;
+  iov_u.iov_len  = (size_t)pgs_w << (u3a_page + 2);
+
+  return _ce_io_all(c3n, pat_u->mem_i, &iov_u, 1,
+                    ((c3_d)pgc_w << (u3a_page + 2)));
+}
+
 /* _ce_patch_verify(): check patch data mug.
 */
 static c3_o
 _ce_patch_verify(u3_ce_patch* pat_u)
 {
-  c3_w i_w;
+  c3_w* mem_w = c3_malloc((size_t)_ce_batch << (u3a_page + 2));
+  c3_w  i_w, j_w, len_w;
 
-  for ( i_w = 0; i_w < pat_u->con_u->pgs_w; i_w++ ) {
-    c3_w pag_w = pat_u->con_u->mem_u[i_w].pag_w;
-    c3_w mug_w = pat_u->con_u->mem_u[i_w].mug_w;
-    c3_w mem_w[1 << u3a_page];
+  for ( i_w = 0; i_w < pat_u->con_u->pgs_w; i_w += len_w ) {
+    len_w = c3_min(_ce_batch, pat_u->con_u->pgs_w - i_w);
 
-    if ( -1 == lseek(pat_u->mem_i, (i_w << (u3a_page + 2)), SEEK_SET) ) {
-      fprintf(stderr, "loom: patch seek: %s\r\n", strerror(errno));
-      c3_assert(0);
-      return c3n;
-    }
-    if ( -1 == read(pat_u->mem_i, mem_w, (1 << (u3a_page + 2))) ) {
+    if ( c3n == _ce_patch_read_pages(pat_u, i_w, len_w, mem_w) ) {
       fprintf(stderr, "loom: patch read: %s\r\n", strerror(errno));
       c3_assert(0);
+      c3_free(mem_w);
       return c3n;
     }
-    {
-      c3_w nug_w = u3r_mug_words(mem_w, (1 << u3a_page));
+
+    for ( j_w = 0; j_w < len_w; j_w++ ) {
+      c3_w pag_w = pat_u->con_u->mem_u[i_w + j_w].pag_w;
+      c3_w mug_w = pat_u->con_u->mem_u[i_w + j_w].mug_w;
+      c3_w nug_w = u3r_mug_words(mem_w + (j_w << u3a_page),
+                                 (1 << u3a_page));
 
       if ( mug_w != nug_w ) {
         fprintf(stderr, "loom: patch mug mismatch %d/%d; (%x, %x)\r\n",
-                        pag_w, i_w, mug_w, nug_w);
+                        pag_w, (i_w + j_w), mug_w, nug_w);
         c3_assert(0);
+        c3_free(mem_w);
         return c3n;
       }
 #if 0
       else {
-        u3l_log("verify: patch %d/%d, %x\r\n", pag_w, i_w, mug_w);
+        u3l_log("verify: patch %d/%d, %x\r\n", pag_w, (i_w + j_w), mug_w);
       }
 #endif
     }
   }
+
+  c3_free(mem_w);
   return c3y;
 }
 
@@ -393,6 +648,13 @@ _ce_patch_open(void)
     _ce_patch_delete();
     return 0;
   }
+  //  a patch from a build with another shift is valid, but not for us
+  //
+  if ( u3a_vits != pat_u->con_u->vit_w ) {
+    fprintf(stderr, "boot: patch has loom shift %u, but this build has %u\r\n",
+                    pat_u->con_u->vit_w, u3a_vits);
+    exit(1);
+  }
   if ( c3n == _ce_patch_verify(pat_u) ) {
     _ce_patch_free(pat_u);
     _ce_patch_delete();
@@ -401,19 +663,52 @@ _ce_patch_open(void)
   return pat_u;
 }
 
-/* _ce_patch_write_page(): write a page of patch memory.
+/* _ce_patch_write_pages(): write the patch's pages, in order, from the loom.
+
+  Patch memory is contiguous, so we write it in batches of iovecs,
+  one per run of adjacent loom pages.
 */
 static void
-_ce_patch_write_page(u3_ce_patch* pat_u,
-                     c3_w         pgc_w,
-                     c3_w*        mem_w)
+_ce_patch_write_pages(u3_ce_patch* pat_u)
 {
-  if ( -1 == lseek(pat_u->mem_i, (pgc_w << (u3a_page + 2)), SEEK_SET) ) {
-    c3_assert(0);
+  struct iovec iov_u[_ce_batch];
+  c3_d         off_d = 0;
+  c3_d         len_d = 0;
+  c3_w         i_w, cnt_w = 0;
+
+  for ( i_w = 0; i_w < pat_u->con_u->pgs_w; i_w++ ) {
+    c3_w  pag_w = pat_u->con_u->mem_u[i_w].pag_w;
+    c3_y* mem_y = (c3_y*)(u3_Loom + (pag_w << u3a_page));
+
+    if (  cnt_w
+       && (mem_y == ((c3_y*)iov_u[cnt_w - 1].iov_base +
+                     iov_u[cnt_w - 1].iov_len)) )
+    {
+      iov_u[cnt_w - 1].iov_len += (1 << (u3a_page + 2));
+    }
+    else {
+      if ( _ce_batch == cnt_w ) {
+        if ( c3n == _ce_io_all(c3y, pat_u->mem_i, iov_u, cnt_w, off_d) ) {
+          fprintf(stderr, "loom: patch write: %s\r\n", strerror(errno));
+          c3_assert(0);
+        }
+        off_d += len_d;
+        len_d = 0;
+        cnt_w = 0;
+      }
+
+      iov_u[cnt_w].iov_base = mem_y;
+      iov_u[cnt_w].iov_len  = (1 << (u3a_page + 2));
+      cnt_w++;
+    }
+
+    len_d += (1 << (u3a_page + 2));
   }
-  if ( (1 << (u3a_page + 2)) !=
-       write(pat_u->mem_i, mem_w, (1 << (u3a_page + 2))) )
+
+  if ( cnt_w &&
+       (c3n == _ce_io_all(c3y, pat_u->mem_i, iov_u, cnt_w, off_d)) )
   {
+    fprintf(stderr, "loom: patch write: %s\r\n", strerror(errno));
     c3_assert(0);
   }
 }
@@ -453,11 +748,10 @@ _ce_patch_save_page(u3_ce_patch* pat_u,
 #if 0
     u3l_log("protect a: page %d\r\n", pag_w);
 #endif
-    _ce_patch_write_page(pat_u, pgc_w, mem_w);
-
-    if ( -1 == mprotect(u3_Loom + (pag_w << u3a_page),
-                        (1 << (u3a_page + 2)),
-                        PROT_READ) )
+    if (  !u3W.sof_t
+       && (-1 == mprotect(u3_Loom + (pag_w << u3a_page),
+                          (1 << (u3a_page + 2)),
+                          PROT_READ)) )
     {
       c3_assert(0);
     }
@@ -478,9 +772,10 @@ _ce_patch_junk_page(u3_ce_patch* pat_u,
   c3_w bit_w = (pag_w & 31);
 
   // u3l_log("protect b: page %d\r\n", pag_w);
-  if ( -1 == mprotect(u3_Loom + (pag_w << u3a_page),
-                      (1 << (u3a_page + 2)),
-                      PROT_READ) )
+  if (  !u3W.sof_t
+     && (-1 == mprotect(u3_Loom + (pag_w << u3a_page),
+                        (1 << (u3a_page + 2)),
+                        PROT_READ)) )
   {
     c3_assert(0);
   }
@@ -496,6 +791,8 @@ u3e_dirty(void)
   c3_w nor_w = 0;
   c3_w sou_w = 0;
 
+  _ce_soft_scan();
+
   /* Calculate number of saved pages, north and south.
   */
   {
@@ -533,6 +830,8 @@ _ce_patch_compose(void)
   c3_w nor_w = 0;
   c3_w sou_w = 0;
 
+  _ce_soft_scan();
+
   /* Calculate number of saved pages, north and south.
   */
   {
@@ -586,7 +885,9 @@ _ce_patch_compose(void)
     pat_u->con_u->nor_w = nor_w;
     pat_u->con_u->sou_w = sou_w;
     pat_u->con_u->pgs_w = pgc_w;
+    pat_u->con_u->vit_w = u3a_vits;
 
+    _ce_patch_write_pages(pat_u);
     _ce_patch_write_control(pat_u);
     return pat_u;
   }
@@ -609,6 +910,66 @@ _ce_image_sync(u3e_image* img_u)
   c3_sync(img_u->fid_i);
 }
 
+/* _ce_image_map(): map north image onto the loom, copy-on-write.
+
+  Pages are read in from the file when first touched.  Written pages
+  become private, so the image can be patched underneath us; a page we
+  haven't written is one the patch doesn't touch.
+*/
+static void
+_ce_image_map(u3e_image* img_u)
+{
+  void* map_v;
+
+  if ( 0 == img_u->pgs_w ) {
+    return;
+  }
+
+  map_v = mmap((void *)u3_Loom,
+               ((size_t)img_u->pgs_w << (u3a_page + 2)),
+               (PROT_READ | PROT_WRITE),
+               (MAP_FIXED | MAP_PRIVATE),
+               img_u->fid_i, 0);
+
+  if ( MAP_FAILED == map_v ) {
+    fprintf(stderr, "loom: image map: %s\r\n", strerror(errno));
+    c3_assert(0);
+  }
+
+  img_u->map_w = img_u->pgs_w;
+}
+
+/* _ce_image_unmap(): replace pages mapped from [img_u] at and above
+**                    [pag_w] with fresh anonymous memory.
+*/
+static void
+_ce_image_unmap(u3e_image* img_u, c3_w pag_w)
+{
+  c3_w  blk_w;
+  void* map_v;
+
+  if ( pag_w >= img_u->map_w ) {
+    return;
+  }
+
+  map_v = mmap((void *)(u3_Loom + (pag_w << u3a_page)),
+               ((size_t)(img_u->map_w - pag_w) << (u3a_page + 2)),
+               ( u3W.sof_t ) ? (PROT_READ | PROT_WRITE) : PROT_READ,
+               (MAP_ANON | MAP_FIXED | MAP_PRIVATE),
+               -1, 0);
+
+  if ( MAP_FAILED == map_v ) {
+    fprintf(stderr, "loom: image unmap: %s\r\n", strerror(errno));
+    c3_assert(0);
+  }
+
+  for ( blk_w = pag_w; blk_w < img_u->map_w; blk_w++ ) {
+    u3P.dit_w[blk_w >> 5] &= ~(1 << (blk_w & 31));
+  }
+
+  img_u->map_w = pag_w;
+}
+
 /* _ce_patch_apply(): apply patch to image.
 */
 static void
@@ -619,9 +980,14 @@ _ce_patch_apply(u3_ce_patch* pat_u)
   //u3l_log("image: nor_w %d, new %d\r\n", u3P.nor_u.pgs_w, pat_u->con_u->nor_w);
   //u3l_log("image: sou_w %d, new %d\r\n", u3P.sou_u.pgs_w, pat_u->con_u->sou_w);
 
+  //  pages mapped from beyond the new end of the image would fault
+  //
+  _ce_image_unmap(&u3P.nor_u, pat_u->con_u->nor_w);
+
   if ( u3P.nor_u.pgs_w > pat_u->con_u->nor_w ) {
     c3_w ret_w;
-    ret_w = ftruncate(u3P.nor_u.fid_i, u3P.nor_u.pgs_w << (u3a_page + 2));
+    ret_w = ftruncate(u3P.nor_u.fid_i,
+                      (c3_d)pat_u->con_u->nor_w << (u3a_page + 2));
     if (ret_w){
       fprintf(stderr, "loom: patch apply truncate north: %s\r\n", strerror(errno));
       c3_assert(0);
@@ -631,7 +997,8 @@ _ce_patch_apply(u3_ce_patch* pat_u)
 
   if ( u3P.sou_u.pgs_w > pat_u->con_u->sou_w ) {
     c3_w ret_w;
-    ret_w = ftruncate(u3P.sou_u.fid_i, u3P.sou_u.pgs_w << (u3a_page + 2));
+    ret_w = ftruncate(u3P.sou_u.fid_i,
+                      (c3_d)pat_u->con_u->sou_w << (u3a_page + 2));
     if (ret_w){
       fprintf(stderr, "loom: patch apply truncate south: %s\r\n", strerror(errno));
       c3_assert(0);
@@ -639,46 +1006,72 @@ _ce_patch_apply(u3_ce_patch* pat_u)
   }
   u3P.sou_u.pgs_w = pat_u->con_u->sou_w;
 
-  if ( (-1 == lseek(pat_u->mem_i, 0, SEEK_SET)) ||
-       (-1 == lseek(u3P.nor_u.fid_i, 0, SEEK_SET)) ||
-       (-1 == lseek(u3P.sou_u.fid_i, 0, SEEK_SET)) )
+  //  read patch memory in batches, and write each run of pages
+  //  adjacent in the same image with one call
+  //
   {
-    fprintf(stderr, "loom: patch apply seek 0: %s\r\n", strerror(errno));
-    c3_assert(0);
-  }
+    c3_w* mem_w = c3_malloc((size_t)_ce_batch << (u3a_page + 2));
+    c3_w  len_w, j_w, run_w;
 
-  for ( i_w = 0; i_w < pat_u->con_u->pgs_w; i_w++ ) {
-    c3_w pag_w = pat_u->con_u->mem_u[i_w].pag_w;
-    c3_w mem_w[1 << u3a_page];
-    c3_i fid_i;
-    c3_w off_w;
-
-    if ( pag_w < pat_u->con_u->nor_w ) {
-      fid_i = u3P.nor_u.fid_i;
-      off_w = pag_w;
-    }
-    else {
-      fid_i = u3P.sou_u.fid_i;
-      off_w = (u3a_pages - (pag_w + 1));
-    }
+    for ( i_w = 0; i_w < pat_u->con_u->pgs_w; i_w += len_w ) {
+      len_w = c3_min(_ce_batch, pat_u->con_u->pgs_w - i_w);
 
-    if ( -1 == read(pat_u->mem_i, mem_w, (1 << (u3a_page + 2))) ) {
-      fprintf(stderr, "loom: patch apply read: %s\r\n", strerror(errno));
-      c3_assert(0);
-    }
-    else {
-      if ( -1 == lseek(fid_i, (off_w << (u3a_page + 2)), SEEK_SET) ) {
-        fprintf(stderr, "loom: patch apply seek: %s\r\n", strerror(errno));
+      if ( c3n == _ce_patch_read_pages(pat_u, i_w, len_w, mem_w) ) {
+        fprintf(stderr, "loom: patch apply read: %s\r\n", strerror(errno));
         c3_assert(0);
       }
-      if ( -1 == write(fid_i, mem_w, (1 << (u3a_page + 2))) ) {
-        fprintf(stderr, "loom: patch apply write: %s\r\n", strerror(errno));
-        c3_assert(0);
-      }
-    }
+
+      for ( j_w = 0; j_w < len_w; j_w += run_w ) {
+        struct iovec iov_u;
+        c3_i         fid_i;
+        c3_w         off_w;
+
+        {
+          c3_w pag_w = pat_u->con_u->mem_u[i_w + j_w].pag_w;
+
+          if ( pag_w < pat_u->con_u->nor_w ) {
+            fid_i = u3P.nor_u.fid_i;
+            off_w = pag_w;
+          }
+          else {
+            fid_i = u3P.sou_u.fid_i;
+            off_w = (u3a_pages - (pag_w + 1));
+          }
+        }
+
+        //  north pages ascend, and south pages descend, in the patch
+        //
+        for ( run_w = 1; (j_w + run_w) < len_w; run_w++ ) {
+          c3_w pag_w = pat_u->con_u->mem_u[i_w + j_w + run_w].pag_w;
+
+          if ( fid_i == u3P.nor_u.fid_i ) {
+            if ( (pag_w >= pat_u->con_u->nor_w) || (pag_w != off_w + run_w) ) {
+              break;
+            }
+          }
+          else if ( (pag_w < pat_u->con_u->nor_w) ||
+                    ((u3a_pages - (pag_w + 1)) != off_w + run_w) )
+          {
+            break;
+          }
+        }
+
+        iov_u.iov_base = mem_w + (j_w << u3a_page);
+        iov_u.iov_len  = (size_t)run_w << (u3a_page + 2);
+
+        if ( c3n == _ce_io_all(c3y, fid_i, &iov_u, 1,
+                               ((c3_d)off_w << (u3a_page + 2))) )
+        {
+          fprintf(stderr, "loom: patch apply write: %s\r\n", strerror(errno));
+          c3_assert(0);
+        }
 #if 0
-    u3l_log("apply: %d, %x\n", pag_w, u3r_mug_words(mem_w, (1 << u3a_page)));
+        u3l_log("apply: %d pages at %d\n", run_w, off_w);
 #endif
+      }
+    }
+
+    c3_free(mem_w);
   }
 }
 
@@ -710,6 +1103,43 @@ _ce_image_blit(u3e_image* img_u,
   }
 }
 
+/* _ce_image_vits(): the loom shift an image was saved with.
+
+  The home road is at the top of the loom, so it ends the first page
+  of the south image whatever the shift; it records its own.
+*/
+static c3_w
+_ce_image_vits(u3e_image* img_u)
+{
+  c3_w  vit_w;
+  off_t off_i = ((off_t)1 << (u3a_page + 2))
+              - (c3_wiseof(u3v_home) << 2)
+              + offsetof(u3v_home, rod_u.vit_w);
+
+  if ( sizeof(vit_w) != pread(img_u->fid_i, &vit_w, sizeof(vit_w), off_i) ) {
+    fprintf(stderr, "loom: image vits read: %s\r\n", strerror(errno));
+    c3_assert(0);
+  }
+
+  return vit_w;
+}
+
+/* _ce_image_trim(): stop mapping north image pages above the watermark,
+**                   as the image may be truncated beneath them.
+*/
+static void
+_ce_image_trim(void)
+{
+  c3_w nwr_w, swu_w;
+
+  if ( 0 == u3P.nor_u.map_w ) {
+    return;
+  }
+
+  u3m_water(&nwr_w, &swu_w);
+  _ce_image_unmap(&u3P.nor_u, (nwr_w + ((1 << u3a_page) - 1)) >> u3a_page);
+}
+
 #ifdef U3_SNAPSHOT_VALIDATION
 /* _ce_image_fine(): compare image to memory.
 */
@@ -762,9 +1192,8 @@ _ce_image_fine(u3e_image* img_u,
   - Sync the image file.
   - Delete the patchfile and free it.
 
-  Once we've written the dirty pages to disk (and have reset their dirty bits
-  and protection flags), we *could* handle the rest of the checkpointing
-  process in a separate thread, but we'd need to wait until that finishes
+  To checkpoint without blocking, see u3e_fork(), which runs all of
+  this in a child process.  We wait for any such child to finish
   before we try to make another snapshot.
 */
 void
@@ -776,6 +1205,9 @@ u3e_save(void)
     return;
   }
 
+  u3e_wait(c3y);
+  _ce_image_trim();
+
   if ( !(pat_u = _ce_patch_compose()) ) {
     return;
   }
@@ -793,7 +1225,7 @@ u3e_save(void)
                    (1 << u3a_page));
 
     _ce_image_fine(&u3P.sou_u,
-                   (u3_Loom + (1 << u3a_bits) - (1 << u3a_page)),
+                   (u3_Loom + u3a_words - (1 << u3a_page)),
                    -(1 << u3a_page));
 
     c3_assert(u3P.nor_u.pgs_w == u3K.nor_w);
@@ -807,31 +1239,659 @@ u3e_save(void)
   _ce_patch_free(pat_u);
 }
 
-/* u3e_live(): start the checkpointing system.
+/* u3e_fork(): save current changes from a forked child process.
+
+  The child sees the loom as of the fork, copy-on-write, and runs
+  u3e_save() on it, writing the patch and applying it to the image.
+  Meanwhile, we mark the same pages clean and protect them, as
+  _ce_patch_compose() would have, and go on computing.
+
+  Only one child runs at a time, as the patch files have fixed names.
+  Until it has been reaped by u3e_wait(), its pages are remembered in
+  u3P.pen_w, so that they can be saved again if it fails.
 */
 c3_o
-u3e_live(c3_o nuu_o, c3_c* dir_c)
+u3e_fork(void)
 {
-  u3P.dir_c = dir_c;
-  u3P.nor_u.nam_c = "north";
-  u3P.sou_u.nam_c = "south";
+  c3_w nwr_w, swu_w, i_w;
+  c3_i pid_i;
 
-  //  XX review dryrun requirements, enable or remove
-  //
-#if 0
   if ( u3C.wag_w & u3o_dryrun ) {
-    return c3y;
-  } else
-#endif
-  {
-    //  Open image files.
-    //
-    if ( (c3n == _ce_image_open(&u3P.nor_u)) ||
-         (c3n == _ce_image_open(&u3P.sou_u)) )
-    {
-      fprintf(stderr, "boot: image failed\r\n");
-      exit(1);
-    }
+    return c3n;
+  }
+
+  u3e_wait(c3y);
+  _ce_image_trim();
+
+  if ( 0 == u3e_dirty() ) {
+    return c3n;
+  }
+
+  if ( -1 == (pid_i = fork()) ) {
+    fprintf(stderr, "loom: fork: %s\r\n", strerror(errno));
+    u3e_save();
+    return c3n;
+  }
+  else if ( 0 == pid_i ) {
+    //  our pagemap is the parent's; the dirty pages are already known
+    //
+    u3W.sof_t = 0;
+    u3e_save();
+    _exit(0);
+  }
+
+  u3P.pid_i = pid_i;
+  memcpy(u3P.pen_w, u3P.dit_w, sizeof(u3P.dit_w));
+
+  for ( i_w = 0; i_w < u3a_pages; i_w++ ) {
+    if ( u3P.dit_w[i_w >> 5] & (1 << (i_w & 31)) ) {
+      _ce_patch_junk_page(0, i_w);
+    }
+  }
+
+  //  as _ce_patch_apply() will, in the child
+  //
+  u3m_water(&nwr_w, &swu_w);
+  u3P.nor_u.pgs_w = (nwr_w + ((1 << u3a_page) - 1)) >> u3a_page;
+  u3P.sou_u.pgs_w = (swu_w + ((1 << u3a_page) - 1)) >> u3a_page;
+
+  return c3y;
+}
+
+/* u3e_wait(): reap the snapshot child, if any; block iff [hol_o].
+
+  If the child failed, its patch is discarded, its pages are marked
+  dirty again, and they are saved here and now.
+*/
+c3_o
+u3e_wait(c3_o hol_o)
+{
+  c3_i sat_i, ret_i;
+  c3_w i_w;
+
+  if ( 0 == u3P.pid_i ) {
+    return c3y;
+  }
+
+  do {
+    ret_i = waitpid(u3P.pid_i, &sat_i, ( c3y == hol_o ) ? 0 : WNOHANG);
+  }
+  while ( (-1 == ret_i) && (EINTR == errno) );
+
+  if ( 0 == ret_i ) {
+    return c3n;
+  }
+
+  u3P.pid_i = 0;
+
+  if ( (-1 != ret_i) && WIFEXITED(sat_i) && (0 == WEXITSTATUS(sat_i)) ) {
+    return c3y;
+  }
+
+  fprintf(stderr, "loom: snapshot child failed, saving again\r\n");
+
+  for ( i_w = 0; i_w < u3a_pages; i_w++ ) {
+    c3_w blk_w = (i_w >> 5);
+    c3_w bit_w = (i_w & 31);
+
+    if ( (u3P.pen_w[blk_w] & (1 << bit_w)) &&
+         !(u3P.dit_w[blk_w] & (1 << bit_w)) )
+    {
+      if ( -1 == mprotect((void *)(u3_Loom + (i_w << u3a_page)),
+                          (1 << (u3a_page + 2)),
+                          (PROT_READ | PROT_WRITE)) )
+      {
+        fprintf(stderr, "loom: wait mprotect: %s\r\n", strerror(errno));
+        c3_assert(0);
+      }
+      u3P.dit_w[blk_w] |= (1 << bit_w);
+    }
+  }
+
+  _ce_patch_delete();
+  u3e_save();
+
+  return c3y;
+}
+
+/* _ce_image_fill(): write [pgs_w] pages of memory to image.
+*/
+static void
+_ce_image_fill(u3e_image* img_u,
+               c3_w*      ptr_w,
+               c3_ws      stp_ws,
+               c3_w       pgs_w)
+{
+  struct iovec iov_u[_ce_batch];
+  c3_w         i_w, j_w;
+
+  for ( i_w = 0; i_w < pgs_w; i_w += j_w ) {
+    for ( j_w = 0; (j_w < _ce_batch) && ((i_w + j_w) < pgs_w); j_w++ ) {
+      iov_u[j_w].iov_base = ptr_w;
+      iov_u[j_w].iov_len  = (1 << (u3a_page + 2));
+      ptr_w += stp_ws;
+    }
+
+    if ( c3n == _ce_io_all(c3y, img_u->fid_i, iov_u, j_w,
+                           ((c3_d)i_w << (u3a_page + 2))) )
+    {
+      fprintf(stderr, "loom: image fill: %s\r\n", strerror(errno));
+      c3_assert(0);
+    }
+  }
+
+  img_u->pgs_w = pgs_w;
+}
+
+/* Packed images.
+
+  For backup and migration, u3e_pack_save() writes the loom within its
+  watermarks as one file: zero pages are elided, the rest compressed
+  one by one with zlib, and every page checksummed with 64 bits of
+  murmur3.
+
+  If there is no image at boot, but there is a packed one in the
+  checkpoint directory, we boot from that, decompressing in parallel.
+*/
+
+/* _ce_pack_hash(): 64-bit checksum.
+*/
+static c3_d
+_ce_pack_hash(const void* buf_v, size_t len_i)
+{
+  c3_d out_d[2];
+
+  MurmurHash3_x64_128(buf_v, len_i, 0xcafebabe, out_d);
+  return out_d[0];
+}
+
+/* _ce_pack_page(): address of packed page [i_w] in loom-shaped [bas_w].
+*/
+static c3_w*
+_ce_pack_page(c3_w* bas_w, c3_w nor_w, c3_w i_w)
+{
+  if ( i_w < nor_w ) {
+    return bas_w + (i_w << u3a_page);
+  }
+  else {
+    return bas_w + ((u3a_pages - (1 + (i_w - nor_w))) << u3a_page);
+  }
+}
+
+/* _ce_pack_zero(): c3y if page is all zeros.
+*/
+static c3_o
+_ce_pack_zero(c3_w* mem_w)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < (1 << u3a_page); i_w++ ) {
+    if ( mem_w[i_w] ) {
+      return c3n;
+    }
+  }
+  return c3y;
+}
+
+/* _ce_pack_meta(): bytes of bitmap, and of bitmap and lines.
+*/
+static void
+_ce_pack_meta(u3e_pack_head* hed_u, size_t* zer_i, size_t* met_i)
+{
+  c3_w pgs_w = hed_u->nor_w + hed_u->sou_w;
+
+  //  in whole double words, to align the lines
+  //
+  *zer_i = (size_t)((pgs_w + 63) >> 6) << 3;
+  *met_i = *zer_i + ((size_t)hed_u->num_w * sizeof(u3e_pack_line));
+}
+
+/* _ce_pack_flush(): write out buffered page data.
+*/
+static c3_o
+_ce_pack_flush(c3_i fid_i, c3_y* buf_y, size_t* len_i, c3_d* off_d)
+{
+  struct iovec iov_u;
+
+  if ( 0 == *len_i ) {
+    return c3y;
+  }
+
+  iov_u.iov_base = buf_y;
+  iov_u.iov_len  = *len_i;
+
+  if ( c3n == _ce_io_all(c3y, fid_i, &iov_u, 1, *off_d) ) {
+    return c3n;
+  }
+
+  *off_d += *len_i;
+  *len_i  = 0;
+  return c3y;
+}
+
+/* u3e_pack_save(): write the loom to a compressed image at [pax_c].
+*/
+c3_o
+u3e_pack_save(c3_c* pax_c)
+{
+  u3e_pack_head  hed_u;
+  u3e_pack_line* lin_u;
+  c3_w*          zer_w;
+  c3_y*          met_y;
+  c3_y*          buf_y;
+  size_t         zer_i, met_i, len_i, siz_i;
+  c3_w           pgs_w, i_w, j_w;
+  c3_d           off_d, dat_d;
+  c3_c*          tmp_c;
+  c3_i           fid_i;
+
+  {
+    c3_w nwr_w, swu_w;
+
+    u3m_water(&nwr_w, &swu_w);
+
+    memset(&hed_u, 0, sizeof(hed_u));
+    hed_u.mag_w = u3e_pack_magic;
+    hed_u.ver_w = u3e_pack_version;
+    hed_u.zip_w = u3e_pack_zlib;
+    hed_u.vit_w = u3a_vits;
+    hed_u.nor_w = (nwr_w + ((1 << u3a_page) - 1)) >> u3a_page;
+    hed_u.sou_w = (swu_w + ((1 << u3a_page) - 1)) >> u3a_page;
+    pgs_w = hed_u.nor_w + hed_u.sou_w;
+  }
+
+  //  find zero pages
+  //
+  met_y = c3_calloc(((size_t)((pgs_w + 63) >> 6) << 3) +
+                    ((size_t)pgs_w * sizeof(u3e_pack_line)));
+  zer_w = (c3_w*)met_y;
+
+  for ( i_w = 0; i_w < pgs_w; i_w++ ) {
+    if ( c3y == _ce_pack_zero(_ce_pack_page(u3_Loom, hed_u.nor_w, i_w)) ) {
+      zer_w[i_w >> 5] |= (1 << (i_w & 31));
+    }
+    else {
+      hed_u.num_w++;
+    }
+  }
+
+  _ce_pack_meta(&hed_u, &zer_i, &met_i);
+  lin_u = (u3e_pack_line*)(met_y + zer_i);
+
+  {
+    size_t tmp_i = strlen(pax_c) + sizeof(".tmp");
+
+    tmp_c = c3_malloc(tmp_i);
+    snprintf(tmp_c, tmp_i, "%s.tmp", pax_c);
+  }
+
+  if ( -1 == (fid_i = open(tmp_c, O_RDWR | O_CREAT | O_TRUNC, 0666)) ) {
+    u3l_log("loom: pack open %s: %s\r\n", tmp_c, strerror(errno));
+    c3_free(tmp_c);
+    c3_free(met_y);
+    return c3n;
+  }
+
+  //  compress pages, into a buffer with room for a worst case page
+  //
+  siz_i = ((size_t)_ce_batch << (u3a_page + 2)) +
+          compressBound(1 << (u3a_page + 2));
+  buf_y = c3_malloc(siz_i);
+  len_i = 0;
+  dat_d = off_d = sizeof(hed_u) + met_i;
+
+  for ( i_w = 0, j_w = 0; i_w < pgs_w; i_w++ ) {
+    c3_w* mem_w = _ce_pack_page(u3_Loom, hed_u.nor_w, i_w);
+    uLongf zip_i = siz_i - len_i;
+
+    if ( zer_w[i_w >> 5] & (1 << (i_w & 31)) ) {
+      continue;
+    }
+
+    lin_u[j_w].has_d = _ce_pack_hash(mem_w, (1 << (u3a_page + 2)));
+    lin_u[j_w].off_d = dat_d;
+
+    if ( (Z_OK != compress2(buf_y + len_i, &zip_i, (const Bytef*)mem_w,
+                            (1 << (u3a_page + 2)), Z_BEST_SPEED)) ||
+         (zip_i >= (1 << (u3a_page + 2))) )
+    {
+      zip_i = (1 << (u3a_page + 2));
+      memcpy(buf_y + len_i, mem_w, zip_i);
+    }
+
+    lin_u[j_w].len_w = zip_i;
+    len_i += zip_i;
+    dat_d += zip_i;
+    j_w++;
+
+    if ( ((siz_i - len_i) < compressBound(1 << (u3a_page + 2))) &&
+         (c3n == _ce_pack_flush(fid_i, buf_y, &len_i, &off_d)) )
+    {
+      break;
+    }
+  }
+
+  //  write data, then metadata, then rename into place
+  //
+  {
+    struct iovec iov_u[2];
+    c3_o         ret_o;
+
+    hed_u.has_d = _ce_pack_hash(met_y, met_i);
+
+    iov_u[0].iov_base = &hed_u;
+    iov_u[0].iov_len  = sizeof(hed_u);
+    iov_u[1].iov_base = met_y;
+    iov_u[1].iov_len  = met_i;
+
+    ret_o = ( (j_w == hed_u.num_w)
+            && (c3y == _ce_pack_flush(fid_i, buf_y, &len_i, &off_d))
+            && (c3y == _ce_io_all(c3y, fid_i, iov_u, 2, 0))
+            && (0 == c3_sync(fid_i)) )
+            ? c3y : c3n;
+
+    c3_free(buf_y);
+    c3_free(met_y);
+    close(fid_i);
+
+    if ( (c3n == ret_o) || (0 != rename(tmp_c, pax_c)) ) {
+      u3l_log("loom: pack write %s: %s\r\n", pax_c, strerror(errno));
+      unlink(tmp_c);
+      c3_free(tmp_c);
+      return c3n;
+    }
+
+    c3_free(tmp_c);
+
+    u3l_log("loom: packed %u pages (%u zero) into %" PRIu64 "MB\r\n",
+            pgs_w, (pgs_w - hed_u.num_w), (dat_d >> 20));
+    return c3y;
+  }
+}
+
+/* _ce_pack_work: packed image, decompression thread.
+*/
+typedef struct _ce_pack_work {
+  pthread_t      tid_u;                   //  thread
+  c3_i           fid_i;                   //  packed image
+  c3_w*          bas_w;                   //  loom-shaped destination
+  c3_w           nor_w;                   //  pages north
+  c3_w           num_w;                   //  nonzero pages
+  u3e_pack_line* lin_u;                   //  nonzero pages
+  c3_w*          pag_w;                   //  packed page index, per line
+  c3_w           fir_w;                   //  first line
+  c3_w           tot_w;                   //  line stride
+  c3_o           ret_o;                   //  success
+} _ce_pack_work;
+
+/* _ce_pack_unzip(): decompress every [tot_w]th page from [fir_w].
+*/
+static void*
+_ce_pack_unzip(void* vod_p)
+{
+  _ce_pack_work* wok_u = vod_p;
+  c3_y*          buf_y = c3_malloc(1 << (u3a_page + 2));
+  c3_w           i_w;
+
+  wok_u->ret_o = c3y;
+
+  for ( i_w = wok_u->fir_w; i_w < wok_u->num_w; i_w += wok_u->tot_w ) {
+    u3e_pack_line* lin_u = &wok_u->lin_u[i_w];
+    c3_w*          mem_w = _ce_pack_page(wok_u->bas_w,
+                                         wok_u->nor_w,
+                                         wok_u->pag_w[i_w]);
+    uLongf         len_i = (1 << (u3a_page + 2));
+    struct iovec   iov_u;
+
+    if ( lin_u->len_w > (1 << (u3a_page + 2)) ) {
+      wok_u->ret_o = c3n;
+      break;
+    }
+
+    iov_u.iov_base = ( lin_u->len_w == (1 << (u3a_page + 2)) )
+                     ? (void*)mem_w : (void*)buf_y;
+    iov_u.iov_len  = lin_u->len_w;
+
+    if ( c3n == _ce_io_all(c3n, wok_u->fid_i, &iov_u, 1, lin_u->off_d) ) {
+      wok_u->ret_o = c3n;
+      break;
+    }
+
+    if ( (iov_u.iov_base == (void*)buf_y) &&
+         ( (Z_OK != uncompress((Bytef*)mem_w, &len_i, buf_y, lin_u->len_w)) ||
+           (len_i != (1 << (u3a_page + 2))) ) )
+    {
+      wok_u->ret_o = c3n;
+      break;
+    }
+
+    if ( lin_u->has_d != _ce_pack_hash(mem_w, (1 << (u3a_page + 2))) ) {
+      wok_u->ret_o = c3n;
+      break;
+    }
+  }
+
+  c3_free(buf_y);
+  return 0;
+}
+
+/* u3e_pack_load(): read a compressed image at [pax_c] into loom-shaped
+**                  [bas_w], producing its header in [hed_u].
+*/
+c3_o
+u3e_pack_load(c3_c* pax_c, c3_w* bas_w, u3e_pack_head* hed_u)
+{
+  u3e_pack_line* lin_u;
+  c3_w*          zer_w;
+  c3_y*          met_y;
+  c3_w*          pag_w;
+  size_t         zer_i, met_i;
+  c3_w           pgs_w, i_w, j_w, tot_w;
+  c3_i           fid_i;
+  c3_o           ret_o = c3y;
+
+  if ( -1 == (fid_i = open(pax_c, O_RDONLY)) ) {
+    u3l_log("loom: unpack open %s: %s\r\n", pax_c, strerror(errno));
+    return c3n;
+  }
+
+  {
+    struct iovec iov_u;
+
+    iov_u.iov_base = hed_u;
+    iov_u.iov_len  = sizeof(*hed_u);
+
+    if (  (c3n == _ce_io_all(c3n, fid_i, &iov_u, 1, 0))
+       || (u3e_pack_magic != hed_u->mag_w)
+       || (u3e_pack_version != hed_u->ver_w) )
+    {
+      u3l_log("loom: unpack %s: bad header\r\n", pax_c);
+      close(fid_i);
+      return c3n;
+    }
+
+    if ( u3a_vits != hed_u->vit_w ) {
+      u3l_log("loom: unpack %s: loom shift %u, but this build has %u\r\n",
+              pax_c, hed_u->vit_w, u3a_vits);
+      close(fid_i);
+      return c3n;
+    }
+
+    if (  (u3e_pack_zlib != hed_u->zip_w)
+       || (hed_u->nor_w > u3a_pages)
+       || (hed_u->sou_w > (u3a_pages - hed_u->nor_w))
+       || (hed_u->num_w > (hed_u->nor_w + hed_u->sou_w)) )
+    {
+      u3l_log("loom: unpack %s: bad header\r\n", pax_c);
+      close(fid_i);
+      return c3n;
+    }
+  }
+
+  pgs_w = hed_u->nor_w + hed_u->sou_w;
+  _ce_pack_meta(hed_u, &zer_i, &met_i);
+  met_y = c3_malloc(met_i);
+
+  {
+    struct iovec iov_u;
+
+    iov_u.iov_base = met_y;
+    iov_u.iov_len  = met_i;
+
+    if (  (c3n == _ce_io_all(c3n, fid_i, &iov_u, 1, sizeof(*hed_u)))
+       || (hed_u->has_d != _ce_pack_hash(met_y, met_i)) )
+    {
+      u3l_log("loom: unpack %s: bad metadata\r\n", pax_c);
+      c3_free(met_y);
+      close(fid_i);
+      return c3n;
+    }
+  }
+
+  zer_w = (c3_w*)met_y;
+  lin_u = (u3e_pack_line*)(met_y + zer_i);
+  pag_w = c3_malloc(((size_t)hed_u->num_w + 1) * sizeof(c3_w));
+
+  for ( i_w = 0, j_w = 0; i_w < pgs_w; i_w++ ) {
+    if ( zer_w[i_w >> 5] & (1 << (i_w & 31)) ) {
+      memset(_ce_pack_page(bas_w, hed_u->nor_w, i_w),
+             0,
+             (1 << (u3a_page + 2)));
+    }
+    else if ( j_w < hed_u->num_w ) {
+      pag_w[j_w++] = i_w;
+    }
+    else {
+      ret_o = c3n;
+      break;
+    }
+  }
+
+  if ( j_w != hed_u->num_w ) {
+    u3l_log("loom: unpack %s: bad bitmap\r\n", pax_c);
+    ret_o = c3n;
+  }
+
+  //  decompress in parallel
+  //
+  if ( c3y == ret_o ) {
+    _ce_pack_work* wok_u;
+    c3_l           cpu_l = sysconf(_SC_NPROCESSORS_ONLN);
+
+    tot_w = c3_max(1, c3_min(16, cpu_l));
+    wok_u = c3_calloc(tot_w * sizeof(*wok_u));
+
+    for ( i_w = 0; i_w < tot_w; i_w++ ) {
+      wok_u[i_w].fid_i = fid_i;
+      wok_u[i_w].bas_w = bas_w;
+      wok_u[i_w].nor_w = hed_u->nor_w;
+      wok_u[i_w].num_w = hed_u->num_w;
+      wok_u[i_w].lin_u = lin_u;
+      wok_u[i_w].pag_w = pag_w;
+      wok_u[i_w].fir_w = i_w;
+      wok_u[i_w].tot_w = tot_w;
+
+      if ( (0 == i_w) ||
+           (0 != pthread_create(&wok_u[i_w].tid_u, 0,
+                                _ce_pack_unzip, &wok_u[i_w])) )
+      {
+        wok_u[i_w].tid_u = pthread_self();
+      }
+    }
+
+    //  the first slice, and any we couldn't start a thread for, run here
+    //
+    for ( i_w = 0; i_w < tot_w; i_w++ ) {
+      if ( pthread_equal(wok_u[i_w].tid_u, pthread_self()) ) {
+        _ce_pack_unzip(&wok_u[i_w]);
+      }
+    }
+
+    for ( i_w = 0; i_w < tot_w; i_w++ ) {
+      if ( !pthread_equal(wok_u[i_w].tid_u, pthread_self()) ) {
+        pthread_join(wok_u[i_w].tid_u, 0);
+      }
+      if ( c3n == wok_u[i_w].ret_o ) {
+        ret_o = c3n;
+      }
+    }
+
+    c3_free(wok_u);
+
+    if ( c3n == ret_o ) {
+      u3l_log("loom: unpack %s: bad page\r\n", pax_c);
+    }
+  }
+
+  c3_free(pag_w);
+  c3_free(met_y);
+  close(fid_i);
+
+  return ret_o;
+}
+
+/* _ce_pack_boot(): with no image, boot from a packed one, if present.
+*/
+static void
+_ce_pack_boot(void)
+{
+  u3e_pack_head hed_u;
+  c3_c          pax_c[8193];
+
+  snprintf(pax_c, 8192, "%s/.urb/chk/image.pak", u3P.dir_c);
+
+  if ( 0 != access(pax_c, R_OK) ) {
+    return;
+  }
+
+  u3l_log("boot: unpacking %s\r\n", pax_c);
+
+  //  the loom is writable, and not yet in use
+  //
+  if ( c3n == u3e_pack_load(pax_c, u3_Loom, &hed_u) ) {
+    fprintf(stderr, "boot: unpack failed\r\n");
+    exit(1);
+  }
+
+  _ce_image_fill(&u3P.nor_u,
+                 u3_Loom,
+                 (1 << u3a_page),
+                 hed_u.nor_w);
+
+  _ce_image_fill(&u3P.sou_u,
+                 (u3_Loom + u3a_words - (1 << u3a_page)),
+                 -(1 << u3a_page),
+                 hed_u.sou_w);
+
+  _ce_image_sync(&u3P.nor_u);
+  _ce_image_sync(&u3P.sou_u);
+}
+
+/* u3e_live(): start the checkpointing system.
+*/
+c3_o
+u3e_live(c3_o nuu_o, c3_c* dir_c)
+{
+  u3P.dir_c = dir_c;
+  u3P.nor_u.nam_c = "north";
+  u3P.sou_u.nam_c = "south";
+
+  //  XX review dryrun requirements, enable or remove
+  //
+#if 0
+  if ( u3C.wag_w & u3o_dryrun ) {
+    return c3y;
+  } else
+#endif
+  {
+    //  Open image files.
+    //
+    if ( (c3n == _ce_image_open(&u3P.nor_u)) ||
+         (c3n == _ce_image_open(&u3P.sou_u)) )
+    {
+      fprintf(stderr, "boot: image failed\r\n");
+      exit(1);
+    }
     else {
       u3_ce_patch* pat_u;
 
@@ -845,23 +1905,67 @@ u3e_live(c3_o nuu_o, c3_c* dir_c)
         _ce_patch_free(pat_u);
       }
 
+      /* If there's no image, look for a packed one, on first boot only.
+      */
+      if ( !u3W.bot_t && (0 == u3P.nor_u.pgs_w) && (0 == u3P.sou_u.pgs_w) ) {
+        _ce_pack_boot();
+      }
+
+      /* Refuse an image whose nouns we'd misread.
+      */
+      if ( 0 != u3P.sou_u.pgs_w ) {
+        c3_w vit_w = _ce_image_vits(&u3P.sou_u);
+
+        if ( u3a_vits != vit_w ) {
+          fprintf(stderr, "boot: image has loom shift %u, "
+                          "but this build has %u\r\n",
+                          vit_w, u3a_vits);
+          exit(1);
+        }
+      }
+
       /* Write image files to memory; reinstate protection.
+      **
+      ** With u3o_lazy_load, the north image is mapped instead, and
+      ** paged in as it's used.  The south image is small; we read it.
       */
       {
-        _ce_image_blit(&u3P.nor_u,
-                       u3_Loom,
-                       (1 << u3a_page));
+        _ce_image_unmap(&u3P.nor_u, 0);
+
+        if ( u3C.wag_w & u3o_lazy_load ) {
+          _ce_image_map(&u3P.nor_u);
+        }
+        else {
+          _ce_image_blit(&u3P.nor_u,
+                         u3_Loom,
+                         (1 << u3a_page));
+        }
 
         _ce_image_blit(&u3P.sou_u,
-                       (u3_Loom + (1 << u3a_bits) - (1 << u3a_page)),
+                       (u3_Loom + u3a_words - (1 << u3a_page)),
                        -(1 << u3a_page));
 
-        if ( 0 != mprotect((void *)u3_Loom, u3a_bytes, PROT_READ) ) {
-          u3l_log("loom: live mprotect: %s\r\n", strerror(errno));
-          c3_assert(0);
+        if ( !u3W.bot_t ) {
+          u3W.bot_t = 1;
+          u3W.sof_t = ( c3y == _ce_soft_init() ) ? 1 : 0;
+        }
+
+        if ( u3W.sof_t ) {
+          if ( c3n == _ce_soft_clear() ) {
+            u3l_log("loom: live clear_refs: %s\r\n", strerror(errno));
+            c3_assert(0);
+          }
+
+          u3l_log("boot: tracking loom with soft-dirty bits\r\n");
         }
+        else {
+          if ( 0 != mprotect((void *)u3_Loom, u3a_bytes, PROT_READ) ) {
+            u3l_log("loom: live mprotect: %s\r\n", strerror(errno));
+            c3_assert(0);
+          }
 
-        u3l_log("boot: protected loom\r\n");
+          u3l_log("boot: protected loom\r\n");
+        }
       }
 
       /* If the images were empty, we are logically booting.
@@ -910,6 +2014,8 @@ _ce_image_move(u3e_image* img_u, c3_o bak_o)
 c3_o
 u3e_hold(void)
 {
+  u3e_wait(c3y);
+
   if ( (c3n == _ce_image_move(&u3P.nor_u, c3y)) ||
        (c3n == _ce_image_move(&u3P.sou_u, c3y)) )
   {
@@ -940,6 +2046,8 @@ _ce_image_drop(u3e_image* img_u)
 c3_o
 u3e_drop(void)
 {
+  u3e_wait(c3y);
+
   if ( (c3n == _ce_image_drop(&u3P.nor_u)) ||
        (c3n == _ce_image_drop(&u3P.sou_u)) )
   {
@@ -954,6 +2062,8 @@ u3e_drop(void)
 c3_o
 u3e_fall(void)
 {
+  u3e_wait(c3y);
+
   if ( (c3n == _ce_image_move(&u3P.nor_u, c3n)) ||
        (c3n == _ce_image_move(&u3P.sou_u, c3n)) )
   {
@@ -970,8 +2080,14 @@ u3e_fall(void)
 c3_o
 u3e_wipe(void)
 {
+  u3e_wait(c3y);
+
   //  XX ensure no patch files are present
 
+  //  the loom mustn't be mapped from an empty file
+  //
+  _ce_image_unmap(&u3P.nor_u, 0);
+
   if ( 0 != ftruncate(u3P.nor_u.fid_i, 0) ) {
     u3l_log("loom: wipe %s failed: %s\r\n", u3P.nor_u.nam_c, strerror(errno));
     return c3n;
@@ -287,8 +287,20 @@ _ch_trim_node(u3h_root* har_u, u3h_slot* sot_w, c3_w lef_w, c3_w rem_w)
     // shrink!
     c3_w i_w, len_w = _ch_popcount(map_w);
 
-    if ( 2 == len_w ) {
+    if ( 1 == len_w ) {
+      // nothing left, the parent will drop us
+      *sot_w = 0;
+
+      u3a_wfree(han_u);
+    }
+    else if ( (2 == len_w) &&
+              (c3y == u3h_slot_is_noun(han_u->sot_w[ 0 == inx_w ? 1 : 0 ])) )
+    {
       // only one left, pick the other
+      //
+      //   a node can't be moved up, as its slots are indexed
+      //   by the hash bits for its own depth
+      //
       *sot_w = han_u->sot_w[ 0 == inx_w ? 1 : 0 ];
 
       u3a_wfree(han_u);
@@ -383,9 +395,12 @@ _ch_trim_slot(u3h_root* har_u, u3h_slot *sot_w, c3_w lef_w, c3_w rem_w)
     return _ch_trim_some(har_u, sot_w, lef_w, rem_w);
   }
   else if ( _(u3h_slot_is_warm(*sot_w)) ) {
+    //  second chance: cool it, and move the arm past the whole slot,
+    //  so that it isn't evicted until the arm comes around again
+    //
     *sot_w = u3h_noun_be_cold(*sot_w);
     if ( c3n == har_u->arm_u.buc_o ) {
-      har_u->arm_u.mug_w = (har_u->arm_u.mug_w + 1) & 0x7FFFFFFF; // modulo 2^31
+      har_u->arm_u.mug_w = _ch_skip_slot(har_u->arm_u.mug_w, lef_w);
     }
     return c3n;
   }
@@ -434,6 +449,146 @@ u3h_trim_to(u3p(u3h_root) har_p, c3_w n_w)
   }
 }
 
+/* _ch_buck_del(): delete from bucket slot.
+*/
+static c3_o
+_ch_buck_del(u3h_root* har_u, u3h_slot* sot_w, u3_noun key)
+{
+  u3h_buck* hab_u = u3h_slot_to_node(*sot_w);
+  c3_w      len_w = hab_u->len_w;
+  c3_w        i_w;
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    u3_noun kev = u3h_slot_to_noun(hab_u->sot_w[i_w]);
+
+    if ( c3y == u3r_sing(key, u3h(kev)) ) {
+      u3z(kev);
+
+      //  the clock arm may be in this bucket; restart it
+      //
+      har_u->arm_u.inx_w = 0;
+      har_u->arm_u.buc_o = c3n;
+
+      if ( 2 >= len_w ) {
+        *sot_w = ( 2 == len_w ) ? hab_u->sot_w[ (0 == i_w) ? 1 : 0 ] : 0;
+        u3a_wfree(hab_u);
+      }
+      else {
+        // shrink bucket in place, as in _ch_trim_buck()
+        //
+        hab_u->len_w = len_w - 1;
+
+        for ( ; i_w < (len_w - 1); i_w++ ) {
+          hab_u->sot_w[i_w] = hab_u->sot_w[i_w + 1];
+        }
+      }
+      return c3y;
+    }
+  }
+  return c3n;
+}
+
+static c3_o
+_ch_slot_del(u3h_root* har_u, u3h_slot* sot_w, c3_w lef_w, c3_w rem_w, u3_noun key);
+
+/* _ch_node_del(): delete from node slot.
+*/
+static c3_o
+_ch_node_del(u3h_root* har_u, u3h_slot* sot_w, c3_w lef_w, c3_w rem_w, u3_noun key)
+{
+  u3h_node* han_u = u3h_slot_to_node(*sot_w);
+  c3_w      bit_w, map_w, inx_w, len_w, i_w;
+  u3h_slot* tos_w;
+
+  lef_w -= 5;
+  bit_w = (rem_w >> lef_w);
+  rem_w = CUT_END(rem_w, lef_w);
+  map_w = han_u->map_w;
+
+  if ( !BIT_SET(map_w, bit_w) ) {
+    return c3n;
+  }
+
+  inx_w = _ch_popcount(CUT_END(map_w, bit_w));
+  tos_w = &(han_u->sot_w[inx_w]);
+
+  if ( c3n == _ch_slot_del(har_u, tos_w, lef_w, rem_w, key) ) {
+    return c3n;
+  }
+
+  len_w = _ch_popcount(map_w);
+
+  if ( 0 == *tos_w ) {
+    if ( 1 == len_w ) {
+      *sot_w = 0;
+      u3a_wfree(han_u);
+      return c3y;
+    }
+
+    // shrink node in place, as in _ch_trim_node()
+    //
+    han_u->map_w = map_w & ~(1 << bit_w);
+    len_w -= 1;
+
+    for ( i_w = inx_w; i_w < len_w; i_w++ ) {
+      han_u->sot_w[i_w] = han_u->sot_w[i_w + 1];
+    }
+  }
+
+  //  a lone key-value pair moves up (nodes can't, see _ch_trim_node())
+  //
+  if ( (1 == len_w) && (c3y == u3h_slot_is_noun(han_u->sot_w[0])) ) {
+    *sot_w = han_u->sot_w[0];
+    u3a_wfree(han_u);
+  }
+  return c3y;
+}
+
+/* _ch_slot_del(): delete from slot, leaving it empty (0) if nothing's left.
+*/
+static c3_o
+_ch_slot_del(u3h_root* har_u, u3h_slot* sot_w, c3_w lef_w, c3_w rem_w, u3_noun key)
+{
+  if ( c3y == u3h_slot_is_null(*sot_w) ) {
+    return c3n;
+  }
+  else if ( c3y == u3h_slot_is_noun(*sot_w) ) {
+    u3_noun kev = u3h_slot_to_noun(*sot_w);
+
+    if ( c3n == u3r_sing(key, u3h(kev)) ) {
+      return c3n;
+    }
+    *sot_w = 0;
+    u3z(kev);
+    return c3y;
+  }
+  else if ( 0 == lef_w ) {
+    return _ch_buck_del(har_u, sot_w, key);
+  }
+  else {
+    return _ch_node_del(har_u, sot_w, lef_w, rem_w, key);
+  }
+}
+
+/* u3h_del(): delete from hashtable, producing yes if [key] was present.
+**
+** `key` is RETAINED.
+*/
+c3_o
+u3h_del(u3p(u3h_root) har_p, u3_noun key)
+{
+  u3h_root* har_u = u3to(u3h_root, har_p);
+  c3_w      mug_w = u3r_mug(key);
+  c3_w      inx_w = (mug_w >> 25);
+  c3_w      rem_w = CUT_END(mug_w, 25);
+
+  if ( c3y == _ch_slot_del(har_u, &(har_u->sot_w[inx_w]), 25, rem_w, key) ) {
+    har_u->use_w -= 1;
+    return c3y;
+  }
+  return c3n;
+}
+
 /* _ch_buck_hum(): read in bucket.
 */
 static c3_o
@@ -531,6 +686,7 @@ _ch_buck_git(u3h_buck* hab_u, u3_noun key)
   for ( i_w = 0; i_w < hab_u->len_w; i_w++ ) {
     u3_noun kev = u3h_slot_to_noun(hab_u->sot_w[i_w]);
     if ( _(u3r_sing(key, u3h(kev))) ) {
+      hab_u->sot_w[i_w] = u3h_noun_be_warm(hab_u->sot_w[i_w]);
       return u3t(kev);
     }
   }
@@ -560,6 +716,7 @@ _ch_node_git(u3h_node* han_u, c3_w lef_w, c3_w rem_w, u3_noun key)
       u3_noun kev = u3h_slot_to_noun(sot_w);
 
       if ( _(u3r_sing(key, u3h(kev))) ) {
+        han_u->sot_w[inx_w] = u3h_noun_be_warm(sot_w);
         return u3t(kev);
       }
       else {
@@ -942,6 +1099,103 @@ u3h_mark(u3p(u3h_root) har_p)
   return tot_w;
 }
 
+/* _ch_rewrite_kev(): rewrite a key-value slot, keeping its clock bit.
+*/
+static u3h_slot
+_ch_rewrite_kev(u3h_slot sot_w)
+{
+  u3_noun kev = u3h_slot_to_noun(sot_w);
+
+  u3a_rewrite_noun(kev);
+  kev = u3a_rewritten_noun(kev);
+
+  return _(u3h_slot_is_warm(sot_w)) ? u3h_noun_be_warm(kev)
+                                    : u3h_noun_be_cold(kev);
+}
+
+/* _ch_rewrite_buck(): rewrite bucket for compaction.
+*/
+static void
+_ch_rewrite_buck(u3h_buck* hab_u)
+{
+  c3_w i_w;
+
+  if ( c3n == u3a_rewrite_ptr(hab_u) ) {
+    return;
+  }
+
+  for ( i_w = 0; i_w < hab_u->len_w; i_w++ ) {
+    hab_u->sot_w[i_w] = _ch_rewrite_kev(hab_u->sot_w[i_w]);
+  }
+}
+
+/* _ch_rewrite_node(): rewrite node for compaction.
+*/
+static void
+_ch_rewrite_node(u3h_node* han_u, c3_w lef_w)
+{
+  c3_w len_w = _ch_popcount(han_u->map_w);
+  c3_w i_w;
+
+  if ( c3n == u3a_rewrite_ptr(han_u) ) {
+    return;
+  }
+
+  lef_w -= 5;
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    c3_w sot_w = han_u->sot_w[i_w];
+
+    if ( _(u3h_slot_is_noun(sot_w)) ) {
+      han_u->sot_w[i_w] = _ch_rewrite_kev(sot_w);
+    }
+    else {
+      void* hav_v = u3h_slot_to_node(sot_w);
+
+      if ( 0 == lef_w ) {
+        _ch_rewrite_buck(hav_v);
+      } else {
+        _ch_rewrite_node(hav_v, lef_w);
+      }
+
+      han_u->sot_w[i_w] =
+        u3h_node_to_slot(u3a_into(u3a_rewritten(u3a_outa(hav_v))));
+    }
+  }
+}
+
+/* u3h_rewrite(): rewrite hashtable for compaction.
+**
+**  Only the contents are rewritten; the caller replaces [har_p]
+**  with u3a_rewritten(har_p).
+*/
+void
+u3h_rewrite(u3p(u3h_root) har_p)
+{
+  u3h_root* har_u = u3to(u3h_root, har_p);
+  c3_w        i_w;
+
+  if ( c3n == u3a_rewrite_ptr(har_u) ) {
+    return;
+  }
+
+  for ( i_w = 0; i_w < 64; i_w++ ) {
+    c3_w sot_w = har_u->sot_w[i_w];
+
+    if ( _(u3h_slot_is_noun(sot_w)) ) {
+      har_u->sot_w[i_w] = _ch_rewrite_kev(sot_w);
+    }
+    else if ( _(u3h_slot_is_node(sot_w)) ) {
+      u3h_node* han_u = u3h_slot_to_node(sot_w);
+
+      _ch_rewrite_node(han_u, 25);
+
+      har_u->sot_w[i_w] =
+        u3h_node_to_slot(u3a_into(u3a_rewritten(u3a_outa(han_u))));
+    }
+  }
+}
+
 /* _ch_count_buck(): count bucket for gc.
 */
 c3_w
@@ -1161,7 +1161,8 @@ _cj_hank_fill(_cj_hank* han_u, u3_noun tam, u3_noun cor)
     return u3m_bail(c3__fail);
   }
 
-  sit_u->bas = u3_none;
+  sit_u->bas   = u3_none;
+  sit_u->pic_p = 0;
   if ( u3_none == (col = loc = _cj_spot(cor, NULL)) ) {
     return u3m_bail(c3__fail);
   }
@@ -1418,6 +1419,7 @@ u3j_site_take(u3j_site* dst_u, u3j_site* src_u)
   dst_u->bat   = u3_none;
   dst_u->bas   = u3_none;
   dst_u->pog_p = 0;
+  dst_u->pic_p = 0;
 
   if ( u3_none == src_u->loc ) {
     dst_u->loc   = u3_none;
@@ -1475,6 +1477,31 @@ u3j_site_merge(u3j_site* dst_u, u3j_site* src_u)
   }
 }
 
+/* _cj_pice_sane(): yes if sit_u->pic_p is really ours.
+**
+**   images written before u3j_pice have garbage in what is
+**   now pic_p, so we check before trusting it on ream.
+*/
+static c3_o
+_cj_pice_sane(u3j_site* sit_u)
+{
+  u3_road*  rod_u = &(u3H->rod_u);
+  u3_post   pic_p = sit_u->pic_p;
+  u3j_pice* pic_u;
+
+  if (  (pic_p < rod_u->rut_p)
+     || ((pic_p + c3_wiseof(u3j_pice)) > rod_u->hat_p) )
+  {
+    return c3n;
+  }
+
+  pic_u = u3to(u3j_pice, pic_p);
+
+  return __(  (u3j_pice_mag == pic_u->mag_w)
+           && (u3of(u3j_site, sit_u) == pic_u->sit_p)
+           && (u3j_pice_no >= pic_u->len_w) );
+}
+
 /* u3j_site_ream(): refresh u3j_site after restoring from checkpoint
 */
 void
@@ -1485,6 +1512,166 @@ u3j_site_ream(u3j_site* sit_u)
     sit_u->jet_o = _cj_nail(sit_u->loc, sit_u->axe,
         &(sit_u->lab), &(sit_u->cop_u), &(sit_u->ham_u));
   }
+
+  if ( 0 != sit_u->pic_p ) {
+    if ( c3n == _cj_pice_sane(sit_u) ) {
+      sit_u->pic_p = 0;
+    }
+    else {
+      u3j_pice* pic_u = u3to(u3j_pice, sit_u->pic_p);
+      c3_w      i_w;
+
+      for ( i_w = 0; i_w < pic_u->len_w; i_w++ ) {
+        u3j_site_ream(&(pic_u->sit_u[i_w]));
+      }
+    }
+  }
+}
+
+/* _cj_site_swap(): make the i_w'th older target current,
+**                  the current target the most recent older one.
+*/
+static void
+_cj_site_swap(u3j_site* sit_u, u3j_pice* pic_u, c3_w i_w)
+{
+  u3j_site old_u = pic_u->sit_u[i_w];
+
+  if ( (u3_none == sit_u->loc) && (u3_none == sit_u->bat) ) {
+    memmove(&(pic_u->sit_u[i_w]), &(pic_u->sit_u[i_w + 1]),
+            (pic_u->len_w - (i_w + 1)) * sizeof(u3j_site));
+    pic_u->len_w--;
+
+    u3z(sit_u->axe);
+    if ( u3_none != sit_u->bas ) {
+      u3z(sit_u->bas);
+    }
+  }
+  else {
+    memmove(&(pic_u->sit_u[1]), &(pic_u->sit_u[0]), i_w * sizeof(u3j_site));
+    pic_u->sit_u[0]       = *sit_u;
+    pic_u->sit_u[0].pic_p = 0;
+  }
+
+  old_u.pic_p = sit_u->pic_p;
+  *sit_u      = old_u;
+}
+
+/* _cj_site_find(): an older target that matches cor, or NULL:
+**                  located targets by fine check (loc_o), others
+**                  by battery.
+*/
+static u3j_site*
+_cj_site_find(u3_noun cor, u3j_site* sit_u, c3_o loc_o)
+{
+  u3j_pice* pic_u;
+  c3_w      i_w;
+
+  if ( 0 == sit_u->pic_p ) {
+    return NULL;
+  }
+
+  pic_u = u3to(u3j_pice, sit_u->pic_p);
+
+  for ( i_w = 0; i_w < pic_u->len_w; i_w++ ) {
+    u3j_site* old_u = &(pic_u->sit_u[i_w]);
+    c3_o      hit_o;
+
+    if ( c3y == loc_o ) {
+      hit_o = ( u3_none == old_u->loc )
+              ? c3n
+              : _cj_fine(cor, old_u->fin_p);
+    }
+    else {
+      hit_o = ( (u3_none != old_u->loc) || (u3_none == old_u->bat) )
+              ? c3n
+              : u3r_sing(old_u->bat, u3h(cor));
+    }
+
+    if ( c3y == hit_o ) {
+      return old_u;
+    }
+  }
+
+  return NULL;
+}
+
+/* _cj_site_pick(): make current an older target that matches cor,
+**                  as found by _cj_site_find().
+*/
+static c3_o
+_cj_site_pick(u3_noun cor, u3j_site* sit_u, c3_o loc_o)
+{
+  u3j_site* old_u = _cj_site_find(cor, sit_u, loc_o);
+
+  if ( NULL == old_u ) {
+    return c3n;
+  }
+  else {
+    u3j_pice* pic_u = u3to(u3j_pice, sit_u->pic_p);
+
+    _cj_site_swap(sit_u, pic_u, old_u - pic_u->sit_u);
+    return c3y;
+  }
+}
+
+/* _cj_site_mega(): yes if sit_u has seen too many targets to cache.
+*/
+static c3_o
+_cj_site_mega(u3j_site* sit_u)
+{
+  return __( (0 != sit_u->pic_p) &&
+             (u3j_pice_meg <= u3to(u3j_pice, sit_u->pic_p)->mis_w) );
+}
+
+/* _cj_site_push(): make the current target the most recent older one,
+**                  evicting the oldest, and clear the current target.
+*/
+static void
+_cj_site_push(u3j_site* sit_u)
+{
+  u3j_pice* pic_u;
+
+  if ( (u3_none == sit_u->loc) && (u3_none == sit_u->bat) ) {
+    return;
+  }
+
+  if ( 0 == sit_u->pic_p ) {
+    pic_u = u3a_walloc(c3_wiseof(u3j_pice));
+    pic_u->mag_w = u3j_pice_mag;
+    pic_u->sit_p = u3of(u3j_site, sit_u);
+    pic_u->len_w = 0;
+    pic_u->mis_w = 0;
+    sit_u->pic_p = u3of(u3j_pice, pic_u);
+  }
+  else {
+    pic_u = u3to(u3j_pice, sit_u->pic_p);
+  }
+
+  if ( u3j_pice_no == pic_u->len_w ) {
+    pic_u->len_w--;
+    pic_u->mis_w++;
+    u3j_site_lose(&(pic_u->sit_u[pic_u->len_w]));
+  }
+
+  memmove(&(pic_u->sit_u[1]), &(pic_u->sit_u[0]),
+          pic_u->len_w * sizeof(u3j_site));
+  pic_u->sit_u[0]       = *sit_u;
+  pic_u->sit_u[0].pic_p = 0;
+  pic_u->len_w++;
+
+  //  the older target keeps our references
+  //
+  sit_u->axe   = u3k(sit_u->axe);
+  sit_u->pog_p = 0;
+  sit_u->bat   = u3_none;
+  sit_u->bas   = u3_none;
+  sit_u->loc   = u3_none;
+  sit_u->lab   = u3_none;
+  sit_u->jet_o = c3n;
+  sit_u->fon_o = c3n;
+  sit_u->cop_u = NULL;
+  sit_u->ham_u = NULL;
+  sit_u->fin_p = 0;
 }
 
 /* _cj_site_lock(): ensure site has a valid program pointer
@@ -1569,56 +1756,233 @@ _cj_site_kick_hot(u3_noun loc, u3_noun cor, u3j_site* sit_u, c3_o lok_o)
   return pro;
 }
 
+/* _cj_mega_find(): the road's megamorphic target for cor at axe, or NULL.
+**
+**   a located target is checked as at a site.  an unlocated target
+**   stands only while its battery has no cold state, as until then,
+**   no core with that battery can be located.
+*/
+static u3j_site*
+_cj_mega_find(u3_noun cor, u3_noun axe)
+{
+  u3_noun   key;
+  u3_weak   got;
+  u3j_site* tar_u;
+
+  if ( 0 == u3R->meg_p ) {
+    return NULL;
+  }
+
+  key = u3nc(u3k(u3h(cor)), u3k(axe));
+  got = u3h_git(u3R->meg_p, key);
+  u3z(key);
+
+  if ( u3_none == got ) {
+    return NULL;
+  }
+
+  tar_u = u3to(u3j_site, got);
+
+  if ( u3_none != tar_u->loc ) {
+    return ( c3y == _cj_fine(cor, tar_u->fin_p) ) ? tar_u : NULL;
+  }
+  else {
+    u3_weak bar = _cj_find_cold(u3h(cor));
+
+    if ( u3_none == bar ) {
+      return tar_u;
+    }
+
+    u3z(bar);
+    return NULL;
+  }
+}
+
+/* _cj_mega_fill(): resolve cor at axe into a target, replacing the
+**                  road's megamorphic target for its battery and axis.
+**                  loc is TRANSFERRED.
+*/
+static u3j_site*
+_cj_mega_fill(u3_noun cor, u3_noun axe, u3_weak loc)
+{
+  u3j_site* tar_u = u3a_walloc(c3_wiseof(u3j_site));
+  u3_noun   key   = u3nc(u3k(u3h(cor)), u3k(axe));
+  u3_weak   got;
+
+  memset(tar_u, 0, sizeof(*tar_u));
+  tar_u->axe   = u3k(axe);
+  tar_u->bat   = u3k(u3h(cor));
+  tar_u->bas   = u3_none;
+  tar_u->loc   = loc;
+  tar_u->lab   = u3_none;
+  tar_u->jet_o = c3n;
+  tar_u->fon_o = c3n;
+
+  if ( u3_none != loc ) {
+    tar_u->fin_p = _cj_cast(cor, loc);
+    tar_u->fon_o = c3y;
+    tar_u->jet_o = _cj_nail(loc, axe,
+        &(tar_u->lab), &(tar_u->cop_u), &(tar_u->ham_u));
+  }
+
+  tar_u->pog_p = _cj_prog(loc, u3x_at(axe, cor));
+
+  if ( 0 == u3R->meg_p ) {
+    u3R->meg_p = u3h_new();
+  }
+  else if ( u3_none != (got = u3h_git(u3R->meg_p, key)) ) {
+    u3j_site_lose(u3to(u3j_site, got));
+    u3a_wfree(u3to(u3j_site, got));
+  }
+
+  u3h_put(u3R->meg_p, key, u3of(u3j_site, tar_u));
+  u3z(key);
+
+  return tar_u;
+}
+
+/* _cj_kick_once(): execute a kick on core at axe, caching nothing.
+*/
+static u3_weak
+_cj_kick_once(u3_noun cor, u3_noun axe, u3p(u3n_prog)* pog_p)
+{
+  u3j_site tmp_u;
+  u3_weak  loc = _cj_spot(cor, NULL);
+  u3_weak  pro;
+
+  memset(&tmp_u, 0, sizeof(tmp_u));
+  tmp_u.axe   = axe;
+  tmp_u.bat   = u3_none;
+  tmp_u.bas   = u3_none;
+  tmp_u.loc   = loc;
+  tmp_u.lab   = u3_none;
+  tmp_u.jet_o = c3n;
+  tmp_u.pog_p = _cj_prog(loc, u3x_at(axe, cor));
+
+  if ( u3_none != loc ) {
+    tmp_u.jet_o = _cj_nail(loc, axe,
+        &(tmp_u.lab), &(tmp_u.cop_u), &(tmp_u.ham_u));
+  }
+
+  pro = _cj_site_kick_hot(loc, cor, &tmp_u, c3n);
+
+  if ( u3_none == pro ) {
+    *pog_p = tmp_u.pog_p;
+  }
+
+  if ( u3_none != loc ) {
+    u3z(tmp_u.lab);
+    u3z(loc);
+  }
+
+  return pro;
+}
+
+/* _cj_site_kick_mega(): execute a megamorphic site's kick on core.
+**
+**   the site's own targets still hit, but are never displaced;
+**   other cores are resolved through the road's megamorphic cache,
+**   u3R->meg_p.  the home road keeps none, as its programs can be
+**   reclaimed and moved; there, each such kick is resolved afresh.
+*/
+static u3_weak
+_cj_site_kick_mega(u3_noun cor, u3j_site* sit_u, u3p(u3n_prog)* pog_p)
+{
+  u3j_site* tar_u;
+  u3_weak   pro;
+
+  if ( (u3_none != sit_u->loc) && (c3y == _cj_fine(cor, sit_u->fin_p)) ) {
+    tar_u = sit_u;
+  }
+  else {
+    tar_u = _cj_site_find(cor, sit_u, c3y);
+  }
+
+  if ( NULL == tar_u ) {
+    if ( &(u3H->rod_u) == u3R ) {
+      return _cj_kick_once(cor, sit_u->axe, pog_p);
+    }
+    else if ( NULL == (tar_u = _cj_mega_find(cor, sit_u->axe)) ) {
+      tar_u = _cj_mega_fill(cor, sit_u->axe, _cj_spot(cor, NULL));
+    }
+  }
+
+  //  a target's program is only set when it's first run
+  //
+  pro = _cj_site_kick_hot(tar_u->loc, cor, tar_u, c3y);
+
+  if ( u3_none == pro ) {
+    _cj_site_lock(tar_u->loc, cor, tar_u);
+    *pog_p = tar_u->pog_p;
+  }
+
+  return pro;
+}
+
 /* _cj_site_kick(): execute site's kick on core.
+**
+**   the current target is checked first, then older targets in
+**   the site's polymorphic cache (u3j_pice).  a miss displaces the
+**   current target into the cache, unless the site is megamorphic.
  */
 static u3_weak
-_cj_site_kick(u3_noun cor, u3j_site* sit_u)
+_cj_site_kick(u3_noun cor, u3j_site* sit_u, u3p(u3n_prog)* pog_p)
 {
   u3_weak loc, pro;
 
+  if ( c3y == _cj_site_mega(sit_u) ) {
+    return _cj_site_kick_mega(cor, sit_u, pog_p);
+  }
+
   loc = pro = u3_none;
 
-  if ( u3_none != sit_u->loc ) {
-    if ( c3y == _cj_fine(cor, sit_u->fin_p) ) {
-      loc = sit_u->loc;
-      pro = _cj_site_kick_hot(loc, cor, sit_u, c3y);
-    }
+  if ( ((u3_none != sit_u->loc) && (c3y == _cj_fine(cor, sit_u->fin_p)))
+     || (c3y == _cj_site_pick(cor, sit_u, c3y)) )
+  {
+    loc = sit_u->loc;
+    pro = _cj_site_kick_hot(loc, cor, sit_u, c3y);
   }
+  else {
+    c3_o    own_o = __(  (u3_none == sit_u->bat)
+                      || (c3y == u3r_sing(sit_u->bat, u3h(cor))) );
+    u3_weak bas   = u3_none;
+
+    //  the cached bash is only good for the current target's battery
+    //
+    loc = _cj_spot(cor, ( c3y == own_o ) ? &(sit_u->bas) : &bas);
 
-  if ( u3_none == loc ) {
-    loc = _cj_spot(cor, &(sit_u->bas));
     if ( u3_none != loc ) {
-      u3p(u3j_fink) fon_p = 0;
-      u3_weak  lod   = u3_none;
-      u3_weak  lob   = u3_none;
-
-      if ( u3_none != sit_u->loc ) {
-        lod = sit_u->loc;
-        lob = sit_u->lab;
-        if ( c3y == sit_u->fon_o ) {
-          fon_p = sit_u->fin_p;
-        }
-      }
+      _cj_site_push(sit_u);
 
+      if ( u3_none != bas ) {
+        sit_u->bas = bas;
+      }
       sit_u->loc   = loc;
       sit_u->fin_p = _cj_cast(cor, loc);
       sit_u->fon_o = c3y;
       sit_u->jet_o = _cj_nail(loc, sit_u->axe,
           &(sit_u->lab), &(sit_u->cop_u), &(sit_u->ham_u));
       pro = _cj_site_kick_hot(loc, cor, sit_u, c3y);
+    }
+    else if (  (c3n == own_o)
+            && (c3n == _cj_site_pick(cor, sit_u, c3n)) )
+    {
+      _cj_site_push(sit_u);
 
-      if ( u3_none != lod ) {
-        u3z(lod);
-        u3z(lob);
-        if ( 0 != fon_p ) {
-          _cj_fink_free(fon_p);
-        }
+      if ( u3_none != bas ) {
+        sit_u->bas = bas;
+        bas = u3_none;
       }
     }
+
+    if ( u3_none != bas ) {
+      u3z(bas);
+    }
   }
 
   if ( u3_none == pro ) {
     _cj_site_lock(loc, cor, sit_u);
+    *pog_p = sit_u->pog_p;
   }
 
   return pro;
@@ -1627,11 +1991,11 @@ _cj_site_kick(u3_noun cor, u3j_site* sit_u)
 /* u3j_site_kick(): kick a core with a u3j_site cache.
  */
 u3_weak
-u3j_site_kick(u3_noun cor, u3j_site* sit_u)
+u3j_site_kick(u3_noun cor, u3j_site* sit_u, u3p(u3n_prog)* pog_p)
 {
   u3_weak pro;
   u3t_on(glu_o);
-  pro = _cj_site_kick(cor, sit_u);
+  pro = _cj_site_kick(cor, sit_u, pog_p);
   u3t_off(glu_o);
   return pro;
 }
@@ -1645,6 +2009,7 @@ u3j_cook(const c3_c* key_c,
 {
   u3_noun pro, key, tam, inn;
   _cj_hank* han_u;
+  u3p(u3n_prog) pog_p;
 
   u3t_on(glu_o);
   key = u3i_string(key_c);
@@ -1654,9 +2019,9 @@ u3j_cook(const c3_c* key_c,
     _cj_hank_lose(han_u);
     inn = _cj_hank_fill(han_u, tam, cor);
   }
-  pro = _cj_site_kick(u3k(inn), &(han_u->sit_u));
+  pro = _cj_site_kick(u3k(inn), &(han_u->sit_u), &pog_p);
   if ( u3_none == pro ) {
-    pro = _cj_burn(han_u->sit_u.pog_p, inn);
+    pro = _cj_burn(pog_p, inn);
   }
   u3z(cor);
 
@@ -1694,6 +2059,7 @@ u3j_gate_prep(u3j_site* sit_u, u3_noun cor)
     return;
   }
   sit_u->bas   = u3_none;
+  sit_u->pic_p = 0;
   sit_u->axe   = 2;
   sit_u->bat   = cor; // a lie, this isn't really the battery!
   sit_u->loc   = loc = _cj_spot(cor, &(sit_u->bas));
@@ -2252,6 +2618,15 @@ u3j_site_lose(u3j_site* sit_u)
       _cj_fink_free(sit_u->fin_p);
     }
   }
+  if ( 0 != sit_u->pic_p ) {
+    u3j_pice* pic_u = u3to(u3j_pice, sit_u->pic_p);
+    c3_w      i_w;
+
+    for ( i_w = 0; i_w < pic_u->len_w; i_w++ ) {
+      u3j_site_lose(&(pic_u->sit_u[i_w]));
+    }
+    u3a_wfree(pic_u);
+  }
 }
 
 /* u3j_rite_lose(): lose references of u3j_rite (but do not free).
@@ -2297,6 +2672,15 @@ u3j_site_mark(u3j_site* sit_u)
       tot_w += _cj_fink_mark(u3to(u3j_fink, sit_u->fin_p));
     }
   }
+  if ( 0 != sit_u->pic_p ) {
+    u3j_pice* pic_u = u3to(u3j_pice, sit_u->pic_p);
+    c3_w      i_w;
+
+    tot_w += u3a_mark_ptr(pic_u);
+    for ( i_w = 0; i_w < pic_u->len_w; i_w++ ) {
+      tot_w += u3j_site_mark(&(pic_u->sit_u[i_w]));
+    }
+  }
   return tot_w;
 }
 
@@ -2339,6 +2723,32 @@ u3j_mark(FILE* fil_u)
   return u3a_maid(fil_u, "total jet stuff", tot_w);
 }
 
+/* u3j_rewrite_compact(): rewrite jet state for compaction.
+**
+**  The hank cache holds raw pointers into the bytecode cache,
+**  and must be empty (see u3m_reclaim()).
+*/
+void
+u3j_rewrite_compact(void)
+{
+  c3_assert( 0 == u3to(u3h_root, u3R->jed.han_p)->use_w );
+
+  u3h_rewrite(u3R->jed.war_p);
+  u3h_rewrite(u3R->jed.cod_p);
+  u3h_rewrite(u3R->jed.han_p);
+  u3h_rewrite(u3R->jed.bas_p);
+
+  u3R->jed.war_p = u3a_rewritten(u3R->jed.war_p);
+  u3R->jed.cod_p = u3a_rewritten(u3R->jed.cod_p);
+  u3R->jed.han_p = u3a_rewritten(u3R->jed.han_p);
+  u3R->jed.bas_p = u3a_rewritten(u3R->jed.bas_p);
+
+  if ( u3R == &(u3H->rod_u) ) {
+    u3h_rewrite(u3R->jed.hot_p);
+    u3R->jed.hot_p = u3a_rewritten(u3R->jed.hot_p);
+  }
+}
+
 /* u3j_free_hank(): free an entry from the hank cache.
 */
 void
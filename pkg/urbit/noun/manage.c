@@ -71,6 +71,7 @@
         u3_noun
         u3m_soft_top(c3_w    sec_w,                     //  timer seconds
                      c3_w    pad_w,                     //  base memory pad
+                     c3_w    fag_w,                     //  road flags
                      u3_funk fun_f,
                      u3_noun arg);
 
@@ -524,17 +525,18 @@ void
 u3m_pave(c3_o nuu_o, c3_o bug_o)
 {
   if ( c3y == nuu_o ) {
-    u3H = (void *)_pave_north(u3_Loom + 1,
+    u3H = (void *)_pave_north(u3_Loom + u3a_walign,
                               c3_wiseof(u3v_home),
-                              u3a_words - 1);
+                              u3a_words - u3a_walign);
     u3R = &u3H->rod_u;
+    u3R->vit_w = u3a_vits;
 
     _pave_parts();
   }
   else {
-    u3H = (void *)_find_north(u3_Loom + 1,
+    u3H = (void *)_find_north(u3_Loom + u3a_walign,
                               c3_wiseof(u3v_home),
-                              u3a_words - 1);
+                              u3a_words - u3a_walign);
     u3R = &u3H->rod_u;
   }
 }
@@ -733,10 +735,11 @@ u3m_leap(c3_w pad_w)
       pad_w -= u3R->all.fre_w;
     }
 #endif
-    if ( (pad_w + c3_wiseof(u3a_road)) >= u3a_open(u3R) ) {
+    if ( (pad_w + c3_wiseof(u3a_road) + u3a_walign) >= u3a_open(u3R) ) {
       u3m_bail(c3__meme);
     }
-    len_w = u3a_open(u3R) - (pad_w + c3_wiseof(u3a_road));
+    len_w = u3a_open(u3R) - (pad_w + c3_wiseof(u3a_road) + u3a_walign);
+    len_w &= ~(u3a_walign - 1);
   }
 
   /* Allocate a region on the cap.
@@ -744,7 +747,10 @@ u3m_leap(c3_w pad_w)
   {
     u3p(c3_w) bot_p;
 
+    //  the new heap must start on a box boundary
+    //
     if ( c3y == u3a_is_north(u3R) ) {
+      u3R->cap_p &= ~(u3a_walign - 1);
       bot_p = (u3R->cap_p - len_w);
       u3R->cap_p -= len_w;
 
@@ -757,6 +763,7 @@ u3m_leap(c3_w pad_w)
 #endif
     }
     else {
+      u3R->cap_p = u3a_walign_up(u3R->cap_p);
       bot_p = u3R->cap_p;
       u3R->cap_p += len_w;
 
@@ -778,6 +785,12 @@ u3m_leap(c3_w pad_w)
     u3R->kid_p = u3of(u3_road, rod_u);
   }
 
+  /* Inherit allocation mode; everything in a sand road dies with it.
+  */
+  {
+    rod_u->how.fag_w = u3R->how.fag_w;
+  }
+
   /* Set up the new road.
   */
   {
@@ -915,6 +928,7 @@ u3m_water(c3_w* low_w, c3_w* hig_w)
 u3_noun
 u3m_soft_top(c3_w    sec_w,                     //  timer seconds
              c3_w    pad_w,                     //  base memory pad
+             c3_w    fag_w,                     //  road flags
              u3_funk fun_f,
              u3_noun arg)
 {
@@ -943,6 +957,12 @@ u3m_soft_top(c3_w    sec_w,                     //  timer seconds
   */
   u3m_hate(pad_w);
 
+  /* Configure the new road.  Sand roads can't be garbage-collected.
+  */
+  if ( !(u3C.wag_w & u3o_debug_ram) ) {
+    u3R->how.fag_w |= fag_w;
+  }
+
   /* Trap for ordinary nock exceptions.
   */
   if ( 0 == (why = (u3_noun)_setjmp(u3R->esc.buf)) ) {
@@ -991,7 +1011,7 @@ u3m_soft_top(c3_w    sec_w,                     //  timer seconds
 u3_noun
 u3m_soft_sure(u3_funk fun_f, u3_noun arg)
 {
-  u3_noun pro, pru = u3m_soft_top(0, (1 << 18), fun_f, arg);
+  u3_noun pro, pru = u3m_soft_top(0, (1 << 18), 0, fun_f, arg);
 
   c3_assert(_(u3du(pru)));
   pro = u3k(u3t(pru));
@@ -1197,12 +1217,13 @@ u3m_grab(u3_noun som, ...)   // terminate with u3_none
 */
 u3_noun
 u3m_soft(c3_w    sec_w,
+         c3_w    fag_w,
          u3_funk fun_f,
          u3_noun arg)
 {
   u3_noun why;
 
-  why = u3m_soft_top(sec_w, (1 << 20), fun_f, arg);   // 2MB pad
+  why = u3m_soft_top(sec_w, (1 << 20), fag_w, fun_f, arg);   // 2MB pad
 
   if ( 0 == u3h(why) ) {
     return why;
@@ -1594,23 +1615,23 @@ u3m_init(void)
   /* Map at fixed address.
   */
   {
-    c3_w  len_w = u3a_bytes;
-    void* map_v;
+    size_t len_i = u3a_bytes;
+    void*  map_v;
 
     map_v = mmap((void *)u3_Loom,
-                 len_w,
+                 len_i,
                  (PROT_READ | PROT_WRITE),
                  (MAP_ANON | MAP_FIXED | MAP_PRIVATE),
                  -1, 0);
 
     if ( -1 == (c3_ps)map_v ) {
       void* dyn_v = mmap((void *)0,
-                         len_w,
+                         len_i,
                          PROT_READ,
                          MAP_ANON | MAP_PRIVATE,
                          -1, 0);
 
-      u3l_log("boot: mapping %dMB failed\r\n", (len_w / (1024 * 1024)));
+      u3l_log("boot: mapping %zuMB failed\r\n", (len_i / (1024 * 1024)));
       u3l_log("see urbit.org/using/install/#about-swap-space"
               " for adding swap space\r\n");
       if ( -1 != (c3_ps)map_v ) {
@@ -1620,7 +1641,7 @@ u3m_init(void)
       exit(1);
     }
 
-    u3l_log("loom: mapped %dMB\r\n", len_w >> 20);
+    u3l_log("loom: mapped %zuMB\r\n", len_i >> 20);
   }
 }
 
@@ -1746,22 +1767,18 @@ u3m_rock_load(c3_c* dir_c, c3_d evt_d)
     u3_noun dat;
 
     {
-      //  XX u3m_file bails, but we'd prefer to return errors
-      //
-      u3_noun fil = u3m_file(nam_c);
-      u3a_print_memory(stderr, "rock: load", u3r_met(5, fil));
+      struct stat buf_u;
 
-      u3_noun pro = u3m_soft(0, u3ke_cue, fil);
+      if ( 0 == stat(nam_c, &buf_u) ) {
+        u3a_print_memory(stderr, "rock: load", buf_u.st_size >> 2);
+      }
 
-      if ( u3_blip != u3h(pro) ) {
+      //  cue straight from the file, without loading it onto the loom
+      //
+      if ( u3_none == (dat = u3s_cue_file(nam_c)) ) {
         fprintf(stderr, "rock: unable to cue %s\r\n", nam_c);
-        u3z(pro);
         return c3n;
       }
-      else {
-        dat = u3k(u3t(pro));
-        u3z(pro);
-      }
     }
 
     {
@@ -1837,10 +1854,14 @@ u3m_reclaim(void)
   u3z(u3A->yot);
   u3A->yot = u3_nul;
 
-  //  clear the memoization cache
+  //  clear the memoization cache, keeping its bound
   //
-  u3h_free(u3R->cax.har_p);
-  u3R->cax.har_p = u3h_new();
+  {
+    c3_w max_w = u3to(u3h_root, u3R->cax.har_p)->max_w;
+
+    u3h_free(u3R->cax.har_p);
+    u3R->cax.har_p = u3h_new_cache(max_w);
+  }
 
   //  clear the jet battery hash cache
   //
@@ -1867,3 +1888,76 @@ u3m_reclaim(void)
   u3n_free();
   u3R->byc.har_p = u3h_new();
 }
+
+/* u3m_pack(): compact the home road in place, producing words reclaimed.
+**
+**  Live boxes slide down to the bottom of the loom, in address
+**  order, and every persistent reference is rewritten to follow
+**  them.  Nouns held outside the image must be rewritten by the
+**  caller, or released first.  The bytecode cache can't be moved,
+**  so its keys are saved off the loom and recompiled afterwards.
+*/
+c3_w
+u3m_pack(void)
+{
+  c3_w  pre_w = u3a_open(u3R);
+  c3_w  gan_w;
+  c3_w  len_w = 0;
+  c3_w* byc_w = 0;
+
+  c3_assert( &(u3H->rod_u) == u3R );
+
+  //  a meld in progress holds raw pointers too; abandon it
+  //
+  u3a_meld_stop();
+
+  //  keep the bytecode cache keys off the loom, to recompile after
+  //
+  {
+    u3_noun  byc = u3n_stay();
+    u3s_bak* bak_u;
+    c3_d     bit_d = u3s_jam_met(byc, &bak_u);
+
+    if ( bit_d <= 0xffffffffULL ) {
+      len_w = (c3_w)((bit_d + 31) >> 5);
+      byc_w = c3_calloc(len_w * sizeof(c3_w));
+      u3s_jam_buf(byc, bak_u, byc_w);
+    }
+
+    u3s_jam_free(bak_u);
+    u3z(byc);
+  }
+
+  //  the caches hold raw pointers we don't rewrite; drop them
+  //
+  u3m_reclaim();
+
+  //  sweep the heap, recording new locations
+  //
+  u3a_pack_seek(u3R);
+
+  //  rewrite every reference to a live box
+  //
+  u3v_rewrite_compact();
+  u3j_rewrite_compact();
+  u3n_rewrite_compact();
+  u3a_rewrite_compact();
+
+  //  sweep the heap again, relocating boxes
+  //
+  u3a_pack_move(u3R);
+  gan_w = u3a_open(u3R) - pre_w;
+
+  //  re-warm the bytecode cache, so we don't pay for it per-event
+  //
+  if ( byc_w ) {
+    u3_noun byc = u3s_cue_bytes((c3_d)len_w << 2, (c3_y*)byc_w);
+    c3_w  num_w;
+
+    c3_free(byc_w);
+    num_w = u3n_load(byc);
+    u3l_log("pack: compiled %u formulas\r\n", num_w);
+  }
+
+  return gan_w;
+}
@@ -524,7 +524,25 @@ _n_nock_on(u3_noun bus, u3_noun fol)
 #define KUTS 84
 #define KITB 85
 #define KITS 86
-#define LAST 87
+// superinstructions (from _n_fuse)
+// fragment then nock 9
+#define FKIB 87
+#define FKIS 88
+#define FLIB 89
+#define FLIS 90
+#define FTIB 91
+#define FTIS 92
+// test then conditional skip
+#define S0BN 93
+#define S0SN 94
+#define S0WN 95
+#define S1BN 96
+#define S1SN 97
+#define S1WN 98
+#define DEBN 99
+#define DESN 100
+#define DEWN 101
+#define LAST 102
 
 /* _n_arg(): return the size (in bytes) of an opcode's argument
  */
@@ -538,6 +556,7 @@ _n_arg(c3_y cod_y)
     case SLIB: case SKIB: case KICB: case TICB:
     case BUSH: case BAST: case BALT:
     case MUTB: case KUTB: case MITB: case KITB:
+    case S0BN: case S1BN: case DEBN:
       return sizeof(c3_y);
 
     case FASK: case FASL: case FISL: case FISK:
@@ -546,9 +565,15 @@ _n_arg(c3_y cod_y)
     case SLIS: case SKIS: case KICS: case TICS:
     case SUSH: case SAST: case SALT:
     case MUTS: case KUTS: case MITS: case KITS:
+    case S0SN: case S1SN: case DESN:
+    case FKIB: case FLIB: case FTIB:
       return sizeof(c3_s);
 
+    case FKIS: case FLIS: case FTIS:
+      return sizeof(c3_y) + sizeof(c3_s);
+
     case SWIP: case SWIN:
+    case S0WN: case S1WN: case DEWN:
       return sizeof(c3_l);
 
     default:
@@ -601,7 +626,8 @@ _n_melt(u3_noun ops, c3_w* byc_w, c3_w* cal_w,
           siz_y[i_w] = 1 + _n_arg(cod_y);
           break;
 
-        case SBIP: case SBIN: {
+        case SBIP: case SBIN:
+        case S0BN: case S1BN: case DEBN: {
           c3_l tot_l = 0,
                sip_l = u3t(op);
           c3_w j_w, k_w = i_w;
@@ -639,6 +665,8 @@ _n_melt(u3_noun ops, c3_w* byc_w, c3_w* cal_w,
         case SAST: case SALT: case KICS: case TICS:
         case FISK: case FISL: case SUSH: case SANS:
         case LISL: case LISK: case SKIS: case SLIS:
+        case S0SN: case S0WN: case S1SN: case S1WN:
+        case DESN: case DEWN: case FKIS: case FLIS: case FTIS:
           c3_assert(0); //overflows
           break;
 
@@ -656,6 +684,20 @@ _n_melt(u3_noun ops, c3_w* byc_w, c3_w* cal_w,
           }
           break;
 
+        case FKIB: case FLIB: case FTIB:
+          a_w = (*cal_w)++;
+          if ( a_w <= 0xFF ) {
+            siz_y[i_w] = 3;
+          }
+          else if ( a_w <= 0xFFFF ) {
+            siz_y[i_w] = 4;
+          }
+          else {
+            fprintf(stderr, "_n_melt(): over 2^16 call sites.\r\n");
+            c3_assert(0);
+          }
+          break;
+
         case BUSH: case FIBK: case FIBL:
         case SANB: case LIBL: case LIBK:
         case KITB: case MITB:
@@ -773,7 +815,27 @@ _n_prog_asm_inx(c3_y* buf_y, c3_w* i_w, c3_s inx_s, c3_y cod)
   }
 }
 
-/* _n_prog_asm(): assemble list of ops (from _n_comp) into u3n_prog
+/* _n_prog_asm_site(): initialize call site [cal_s] for arm [axe]. RETAIN.
+ */
+static void
+_n_prog_asm_site(u3n_prog* pog_u, c3_s cal_s, u3_noun axe)
+{
+  u3j_site* sit_u = &(pog_u->cal_u.sit_u[cal_s]);
+  sit_u->axe   = u3k(axe);
+  sit_u->pog_p = 0;
+  sit_u->bat   = u3_none;
+  sit_u->bas   = u3_none;
+  sit_u->loc   = u3_none;
+  sit_u->lab   = u3_none;
+  sit_u->jet_o = c3n;
+  sit_u->fon_o = c3n;
+  sit_u->cop_u = NULL;
+  sit_u->ham_u = NULL;
+  sit_u->fin_p = 0;
+  sit_u->pic_p = 0;
+}
+
+/* _n_prog_asm(): assemble list of ops (from _n_fuse) into u3n_prog
  */
 static void
 _n_prog_asm(u3_noun ops, u3n_prog* pog_u, u3_noun sip)
@@ -829,7 +891,8 @@ _n_prog_asm(u3_noun ops, u3n_prog* pog_u, u3_noun sip)
         }
 
         /* skips */
-        case SBIP: case SBIN: {
+        case SBIP: case SBIN:
+        case S0BN: case S1BN: case DEBN: {
           c3_l sip_l  = u3h(sip);
           u3_noun tmp = sip;
           sip = u3k(u3t(sip));
@@ -897,18 +960,25 @@ _n_prog_asm(u3_noun ops, u3n_prog* pog_u, u3_noun sip)
         /* call site index args */
         case TICB: case KICB: {
           _n_prog_asm_inx(buf_y, &i_w, cal_s, cod);
-          u3j_site* sit_u = &(pog_u->cal_u.sit_u[cal_s++]);
-          sit_u->axe   = u3k(u3t(op));
-          sit_u->pog_p = 0;
-          sit_u->bat   = u3_none;
-          sit_u->bas   = u3_none;
-          sit_u->loc   = u3_none;
-          sit_u->lab   = u3_none;
-          sit_u->jet_o = c3n;
-          sit_u->fon_o = c3n;
-          sit_u->cop_u = NULL;
-          sit_u->ham_u = NULL;
-          sit_u->fin_p = 0;
+          _n_prog_asm_site(pog_u, cal_s++, u3t(op));
+          break;
+        }
+
+        /* 8-bit direct arg, then call site index arg */
+        case FKIB: case FLIB: case FTIB: {
+          c3_y fag_y = (c3_y) u3h(u3t(op));
+          if ( cal_s <= 0xFF ) {
+            buf_y[i_w--] = (c3_y) cal_s;
+            buf_y[i_w--] = fag_y;
+            buf_y[i_w]   = (c3_y) cod;
+          }
+          else {
+            buf_y[i_w--] = (c3_y) (cal_s >> 8);
+            buf_y[i_w--] = (c3_y) cal_s;
+            buf_y[i_w--] = fag_y;
+            buf_y[i_w]   = (c3_y) cod + 1;
+          }
+          _n_prog_asm_site(pog_u, cal_s++, u3t(u3t(op)));
           break;
         }
       }
@@ -969,7 +1039,7 @@ static void _n_print_stack(u3p(u3_noun) empty) {
 }
 #endif
 
-#ifdef VERBOSE_BYTECODE
+#if defined(VERBOSE_BYTECODE) || defined(U3_CPU_DEBUG)
 // match to OPCODE TABLE
 static char* opcode_names[] = {
   "halt", "bail",
@@ -1001,6 +1071,11 @@ static char* opcode_names[] = {
   "musm", "kusm",
   "mutb", "muts", "mitb", "mits",
   "kutb", "kuts", "kitb", "kits",
+  "fkib", "fkis", "flib", "flis",
+  "ftib", "ftis",
+  "s0bn", "s0sn", "s0wn",
+  "s1bn", "s1sn", "s1wn",
+  "debn", "desn", "dewn",
 };
 #endif
 
@@ -1337,6 +1412,157 @@ _n_comp(u3_noun* ops, u3_noun fol, c3_o los_o, c3_o tel_o)
   return tot_w;
 }
 
+/* _n_fuse_pair(): superinstruction for [one two], or u3_none. RETAIN.
+ *
+ *    fusion candidates are taken from the dispatch-pair
+ *    histogram printed by u3n_damp() (see U3_CPU_DEBUG)
+ */
+static u3_weak
+_n_fuse_pair(u3_noun one, u3_noun two)
+{
+  if ( c3n == u3du(two) ) {
+    return u3_none;
+  }
+
+  switch ( u3h(two) ) {
+    default:
+      return u3_none;
+
+    //  fragment then kick
+    //
+    case KICB: case TICB: {
+      c3_y op_y;
+
+      if ( c3n == u3du(one) ) {
+        return u3_none;
+      }
+      else if ( FABL == u3h(one) ) {
+        op_y = (KICB == u3h(two)) ? FLIB : FTIB;
+      }
+      else if ( (FABK == u3h(one)) && (KICB == u3h(two)) ) {
+        op_y = FKIB;
+      }
+      else {
+        return u3_none;
+      }
+      return u3nt(op_y, u3t(one), u3k(u3t(two)));
+    }
+
+    //  test then conditional skip
+    //
+    case SBIN:
+      switch ( one ) {
+        default:   return u3_none;
+        case SAM0: return u3nc(S0BN, u3t(two));
+        case SAM1: return u3nc(S1BN, u3t(two));
+        case DEEP: return u3nc(DEBN, u3t(two));
+      }
+  }
+}
+
+/* _n_fuse_skip(): if [op] skips, produce yes and set *sip_w to the
+ *                 number of instructions it skips over.
+ */
+static c3_o
+_n_fuse_skip(u3_noun op, c3_w* sip_w)
+{
+  if ( c3y == u3du(op) ) {
+    switch ( u3h(op) ) {
+      case SBIP: case SBIN:
+      case S0BN: case S1BN: case DEBN:
+        *sip_w = u3t(op);
+        return c3y;
+
+      case SKIB: case SLIB:
+        *sip_w = u3h(u3t(op));
+        return c3y;
+    }
+  }
+  return c3n;
+}
+
+/* _n_fuse(): peephole pass, fusing common instruction pairs.
+ *            ops: reversed opcode list (from _n_comp). TRANSFER.
+ *            return: reversed opcode list, with skips adjusted
+ */
+static u3_noun
+_n_fuse(u3_noun ops)
+{
+  c3_w     len_w = u3qb_lent(ops),
+           i_w, j_w, sip_w;
+  u3_noun* lis   = u3a_malloc(sizeof(u3_noun) * (len_w + 1)),
+         * nex   = u3a_malloc(sizeof(u3_noun) * (len_w + 1));
+  c3_w*    nix_w = u3a_malloc(sizeof(c3_w) * (len_w + 1)),
+      *    org_w = u3a_malloc(sizeof(c3_w) * (len_w + 1));
+  c3_y*    jum_y = u3a_malloc(len_w + 1);
+  u3_noun  pro   = u3_nul,
+           tmp   = ops,
+           fus;
+
+  //  instructions in order; mark skip targets, which must stay put
+  //
+  memset(jum_y, 0, len_w + 1);
+
+  for ( i_w = len_w; i_w > 0; i_w-- ) {
+    lis[i_w - 1] = u3h(tmp);
+    tmp = u3t(tmp);
+  }
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    if ( c3y == _n_fuse_skip(lis[i_w], &sip_w) ) {
+      c3_assert( (i_w + 1 + sip_w) <= len_w );
+      jum_y[i_w + 1 + sip_w] = 1;
+    }
+  }
+
+  //  fuse pairs, recording where each instruction went
+  //
+  for ( i_w = 0, j_w = 0; i_w < len_w; j_w++ ) {
+    if ( (i_w + 1 < len_w) &&
+         !jum_y[i_w + 1] &&
+         (u3_none != (fus = _n_fuse_pair(lis[i_w], lis[i_w + 1]))) )
+    {
+      nix_w[i_w] = nix_w[i_w + 1] = j_w;
+      org_w[j_w] = i_w + 1;
+      nex[j_w]   = fus;
+      i_w += 2;
+    }
+    else {
+      nix_w[i_w] = j_w;
+      org_w[j_w] = i_w;
+      nex[j_w]   = u3k(lis[i_w]);
+      i_w += 1;
+    }
+  }
+  nix_w[len_w] = j_w;
+
+  //  recount skips, and reverse
+  //
+  for ( i_w = 0; i_w < j_w; i_w++ ) {
+    if ( c3y == _n_fuse_skip(nex[i_w], &sip_w) ) {
+      c3_w nip_w = nix_w[org_w[i_w] + 1 + sip_w] - (i_w + 1);
+
+      if ( nip_w != sip_w ) {
+        u3_noun op = nex[i_w];
+
+        nex[i_w] = ( (SKIB == u3h(op)) || (SLIB == u3h(op)) )
+                 ? u3nt(u3h(op), nip_w, u3k(u3t(u3t(op))))
+                 : u3nc(u3h(op), nip_w);
+        u3z(op);
+      }
+    }
+    pro = u3nc(nex[i_w], pro);
+  }
+
+  u3a_free(lis);
+  u3a_free(nex);
+  u3a_free(nix_w);
+  u3a_free(org_w);
+  u3a_free(jum_y);
+  u3z(ops);
+  return pro;
+}
+
 /* _n_push(): push a noun onto the stack. RETAIN
  *            mov: -1 north, 1 south
  *            off: 0 north, -1 south
@@ -1474,6 +1700,12 @@ _n_print_byc(c3_y* pog, c3_w her_w)
         fprintf(stderr, "%u]", _n_resh(pog, &ip_w));
         break;
 
+      case 3:
+        fprintf(stderr, "[%s ", opcode_names[pog[ip_w++]]);
+        fprintf(stderr, "%u ", pog[ip_w++]);
+        fprintf(stderr, "%u]", _n_resh(pog, &ip_w));
+        break;
+
       case 4:
         fprintf(stderr, "[%s", opcode_names[pog[ip_w++]]);
         fprintf(stderr, "%u]", _n_rewo(pog, &ip_w));
@@ -1493,7 +1725,7 @@ static inline u3n_prog*
 _n_bite(u3_noun fol) {
   u3_noun ops  = u3_nul;
   _n_comp(&ops, fol, c3y, c3y);
-  return _n_prog_from_ops(ops);
+  return _n_prog_from_ops(_n_fuse(ops));
 }
 
 /* _n_find(): return prog for given formula with prefix (u3_nul for none).
@@ -1525,6 +1757,7 @@ _n_find(u3_noun pre, u3_noun fol)
           sit_u->bat   = u3_none;
           sit_u->pog_p = 0;
           sit_u->fon_o = c3n;
+          sit_u->pic_p = 0;
         }
         u3h_put(u3R->byc.har_p, key, u3a_outa(old));
         u3z(key);
@@ -1570,11 +1803,11 @@ _n_swap(c3_ys mov, c3_ys off)
 /* _n_kick(): stop tracing noc and kick a u3j_site.
  */
 static u3_weak
-_n_kick(u3_noun cor, u3j_site* sit_u)
+_n_kick(u3_noun cor, u3j_site* sit_u, u3p(u3n_prog)* pog_p)
 {
   u3_weak pro;
   u3t_off(noc_o);
-  pro = u3j_site_kick(cor, sit_u);
+  pro = u3j_site_kick(cor, sit_u, pog_p);
   u3t_on(noc_o);
   return pro;
 }
@@ -1595,6 +1828,12 @@ typedef struct {
   c3_w     ip_w;
 } burnframe;
 
+#ifdef U3_CPU_DEBUG
+/* _n_pair_d: dispatch-pair histogram, [previous][next].
+ */
+static c3_d _n_pair_d[LAST][LAST];
+#endif
+
 /* _n_burn(): pog: program
  *            bus: subject (TRANSFER)
  *            mov: -1 north, 1 south
@@ -1634,17 +1873,26 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
     &&do_musm, &&do_kusm,
     &&do_mutb, &&do_muts, &&do_mitb, &&do_mits,
     &&do_kutb, &&do_kuts, &&do_kitb, &&do_kits,
+    &&do_fkib, &&do_fkis, &&do_flib, &&do_flis,
+    &&do_ftib, &&do_ftis,
+    &&do_s0bn, &&do_s0sn, &&do_s0wn,
+    &&do_s1bn, &&do_s1sn, &&do_s1wn,
+    &&do_debn, &&do_desn, &&do_dewn,
   };
 
   u3j_site* sit_u;
   u3j_rite* rit_u;
   u3n_memo* mem_u;
+  u3p(u3n_prog) pog_p;
   c3_y *pog = pog_u->byc_u.ops_y;
   c3_w sip_w, ip_w = 0;
   u3_noun* top;
   u3_noun x, o;
   u3p(void) empty;
   burnframe* fam;
+#ifdef U3_CPU_DEBUG
+  c3_y las_y = HALT;
+#endif
 
   empty = u3R->cap_p;
   _n_push(mov, off, bus);
@@ -1654,6 +1902,8 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
 #endif
 #ifdef VERBOSE_BYTECODE
   #define BURN() fprintf(stderr, "%s ", opcode_names[pog[ip_w]]); goto *lab[pog[ip_w++]]
+#elif defined(U3_CPU_DEBUG)
+  #define BURN() _n_pair_d[las_y][pog[ip_w]]++; las_y = pog[ip_w]; goto *lab[pog[ip_w++]]
 #else
   #define BURN() goto *lab[pog[ip_w++]]
 #endif
@@ -2012,7 +2262,7 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
       sit_u = &(pog_u->cal_u.sit_u[x]);
       top   = _n_peek(off);
       o     = *top;
-      *top = _n_kick(o, sit_u);
+      *top = _n_kick(o, sit_u, &pog_p);
       if ( u3_none == *top ) {
         _n_toss(mov, off);
 
@@ -2021,7 +2271,7 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
         fam->ip_w   = ip_w;
         fam->pog_u  = pog_u;
 
-        pog_u = u3to(u3n_prog, sit_u->pog_p);
+        pog_u = u3to(u3n_prog, pog_p);
         pog   = pog_u->byc_u.ops_y;
         ip_w  = 0;
 #ifdef U3_CPU_DEBUG
@@ -2050,10 +2300,10 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
       sit_u = &(pog_u->cal_u.sit_u[x]);
       top   = _n_peek(off);
       o     = *top;
-      *top = _n_kick(o, sit_u);
+      *top = _n_kick(o, sit_u, &pog_p);
       if ( u3_none == *top ) {
         *top  = o;
-        pog_u = u3to(u3n_prog, sit_u->pog_p);
+        pog_u = u3to(u3n_prog, pog_p);
         pog   = pog_u->byc_u.ops_y;
         ip_w  = 0;
 #ifdef U3_CPU_DEBUG
@@ -2302,6 +2552,110 @@ _n_burn(u3n_prog* pog_u, u3_noun bus, c3_ys mov, c3_ys off)
     edit_in:
       *top = u3i_edit(*top, x, o);
       BURN();
+
+    do_fkis:                   // fabk, kics
+      x   = pog[ip_w++];
+      top = _n_peek(off);
+      _n_push(mov, off, u3k(u3x_at(x, *top)));
+      x   = _n_resh(pog, &ip_w);
+      goto kick_in;
+
+    do_fkib:                   // fabk, kicb
+      x   = pog[ip_w++];
+      top = _n_peek(off);
+      _n_push(mov, off, u3k(u3x_at(x, *top)));
+      x   = pog[ip_w++];
+      goto kick_in;
+
+    do_flis:                   // fabl, kics
+      x    = pog[ip_w++];
+      top  = _n_peek(off);
+      o    = *top;
+      *top = u3k(u3x_at(x, o));
+      u3z(o);
+      x    = _n_resh(pog, &ip_w);
+      goto kick_in;
+
+    do_flib:                   // fabl, kicb
+      x    = pog[ip_w++];
+      top  = _n_peek(off);
+      o    = *top;
+      *top = u3k(u3x_at(x, o));
+      u3z(o);
+      x    = pog[ip_w++];
+      goto kick_in;
+
+    do_ftis:                   // fabl, tics
+      x    = pog[ip_w++];
+      top  = _n_peek(off);
+      o    = *top;
+      *top = u3k(u3x_at(x, o));
+      u3z(o);
+      x    = _n_resh(pog, &ip_w);
+      goto tick_in;
+
+    do_ftib:                   // fabl, ticb
+      x    = pog[ip_w++];
+      top  = _n_peek(off);
+      o    = *top;
+      *top = u3k(u3x_at(x, o));
+      u3z(o);
+      x    = pog[ip_w++];
+      goto tick_in;
+
+    do_s0wn:                   // sam0, swin
+      sip_w = _n_rewo(pog, &ip_w);
+      goto s0in_in;
+
+    do_s0sn:                   // sam0, sins
+      sip_w = _n_resh(pog, &ip_w);
+      goto s0in_in;
+
+    do_s0bn:                   // sam0, sbin
+      sip_w = pog[ip_w++];
+    s0in_in:
+      x = _n_pep(mov, off);
+      if ( 0 != x ) {
+        u3z(x);
+        ip_w += sip_w;
+      }
+      BURN();
+
+    do_s1wn:                   // sam1, swin
+      sip_w = _n_rewo(pog, &ip_w);
+      goto s1in_in;
+
+    do_s1sn:                   // sam1, sins
+      sip_w = _n_resh(pog, &ip_w);
+      goto s1in_in;
+
+    do_s1bn:                   // sam1, sbin
+      sip_w = pog[ip_w++];
+    s1in_in:
+      x = _n_pep(mov, off);
+      if ( 1 != x ) {
+        u3z(x);
+        ip_w += sip_w;
+      }
+      BURN();
+
+    do_dewn:                   // deep, swin
+      sip_w = _n_rewo(pog, &ip_w);
+      goto dein_in;
+
+    do_desn:                   // deep, sins
+      sip_w = _n_resh(pog, &ip_w);
+      goto dein_in;
+
+    do_debn:                   // deep, sbin
+      sip_w = pog[ip_w++];
+    dein_in:
+      x = _n_pep(mov, off);
+      if ( c3n == u3du(x) ) {
+        ip_w += sip_w;
+      }
+      u3z(x);
+      BURN();
   }
 }
 
@@ -2547,6 +2901,76 @@ u3n_ream()
   u3h_walk(u3R->byc.har_p, _n_ream);
 }
 
+/* _n_stay_cb(): u3h_walk_with helper for u3n_stay
+ */
+static void
+_n_stay_cb(u3_noun kev, void* dat)
+{
+  u3_noun* lis = dat;
+  u3_noun  key = u3h(kev);
+
+  *lis = u3nc(u3nc(u3r_mug(key), u3k(key)), *lis);
+}
+
+/* u3n_stay(): extract bytecode cache keys, as (list [mug [pre fol]]).
+*/
+u3_noun
+u3n_stay(void)
+{
+  u3_noun lis = u3_nul;
+  c3_assert(u3R == &(u3H->rod_u));
+  u3h_walk_with(u3R->byc.har_p, _n_stay_cb, &lis);
+  return lis;
+}
+
+/* _n_load_one(): compile [pre fol] into the bytecode cache (for u3m_soft).
+*/
+static u3_noun
+_n_load_one(u3_noun key)
+{
+  _n_find(u3h(key), u3t(key));
+  u3z(key);
+  return u3_nul;
+}
+
+/* u3n_load(): recompile bytecode cache keys from u3n_stay(),
+**             producing the number of programs compiled.
+**
+**   entries whose mug doesn't match are skipped, as are
+**   formulas already present (u3h compares with u3r_sing).
+**   call and registration sites are warmed lazily, on first use.
+*/
+c3_w
+u3n_load(u3_noun lis)
+{
+  u3_noun sil = lis;
+  c3_w  num_w = 0;
+
+  c3_assert(u3R == &(u3H->rod_u));
+
+  while ( c3y == u3du(lis) ) {
+    u3_noun mug, key;
+
+    if (  (c3y == u3r_cell(u3h(lis), &mug, &key))
+       && (c3y == u3du(key))
+       && (mug == u3r_mug(key))
+       && (u3_none == u3h_git(u3R->byc.har_p, key)) )
+    {
+      u3_noun pro = u3m_soft(0, 0, _n_load_one, u3k(key));
+
+      if ( u3_blip == u3h(pro) ) {
+        num_w++;
+      }
+      u3z(pro);
+    }
+
+    lis = u3t(lis);
+  }
+
+  u3z(sil);
+  return num_w;
+}
+
 /* _n_prog_mark(): mark program for gc.
 */
 static c3_w
@@ -2597,6 +3021,20 @@ u3n_mark(FILE* fil_u)
   return  u3a_maid(fil_u, "total nock stuff", bam_w + har_w);
 }
 
+/* u3n_rewrite_compact(): rewrite the bytecode cache for compaction.
+**
+**  Programs are full of raw pointers, so the cache must be
+**  empty (see u3m_reclaim()).
+*/
+void
+u3n_rewrite_compact(void)
+{
+  c3_assert( 0 == u3to(u3h_root, u3R->byc.har_p)->use_w );
+
+  u3h_rewrite(u3R->byc.har_p);
+  u3R->byc.har_p = u3a_rewritten(u3R->byc.har_p);
+}
+
 /* _n_feb(): u3h_walk helper for u3n_free
  */
 static void
@@ -2615,6 +3053,56 @@ u3n_free()
   u3h_free(har_p);
 }
 
+/* u3n_damp(): print and clear the dispatch-pair histogram.
+ */
+void
+u3n_damp(FILE* fil_u)
+{
+#ifdef U3_CPU_DEBUG
+  c3_d tot_d = 0;
+  c3_w i_w, j_w, k_w;
+
+  for ( i_w = 0; i_w < LAST; i_w++ ) {
+    for ( j_w = 0; j_w < LAST; j_w++ ) {
+      tot_d += _n_pair_d[i_w][j_w];
+    }
+  }
+
+  if ( 0 == tot_d ) {
+    return;
+  }
+
+  fprintf(fil_u, "dispatch pairs:\r\n");
+
+  //  the most frequent pairs are the candidates for _n_fuse_pair()
+  //
+  for ( k_w = 0; k_w < 16; k_w++ ) {
+    c3_d max_d = 0;
+    c3_w max_w = 0;
+
+    for ( i_w = 0; i_w < (LAST * LAST); i_w++ ) {
+      if ( _n_pair_d[i_w / LAST][i_w % LAST] > max_d ) {
+        max_d = _n_pair_d[i_w / LAST][i_w % LAST];
+        max_w = i_w;
+      }
+    }
+
+    if ( 0 == max_d ) {
+      break;
+    }
+
+    fprintf(fil_u, "  %s %s: %" PRIu64 " (%" PRIu64 "%%)\r\n",
+                   opcode_names[max_w / LAST],
+                   opcode_names[max_w % LAST],
+                   max_d,
+                   (100 * max_d) / tot_d);
+    _n_pair_d[max_w / LAST][max_w % LAST] = 0;
+  }
+
+  memset(_n_pair_d, 0, sizeof(_n_pair_d));
+#endif
+}
+
 /* u3n_kick_on(): fire `gat` without changing the sample.
 */
 u3_noun
@@ -2,7 +2,10 @@
 **
 */
 #include "all.h"
-#include <murmur3.h>
+
+#if defined(__SSE4_1__)
+#  include <smmintrin.h>
+#endif
 
 /* _frag_word(): fast fragment/branch prediction for top word.
 */
@@ -1311,6 +1314,147 @@ u3r_tape(u3_noun a)
   return a_y;
 }
 
+/*  MurmurHash3_x86_32, inlined.
+**
+**    mugs are consensus-visible: these must agree exactly with
+**    the reference implementation (as used by u3r_mug_bytes()
+**    before they were inlined), which the mug tests check.
+*/
+#define _cr_mur_c1  0xcc9e2d51
+#define _cr_mur_c2  0x1b873593
+
+/* _cr_mur_rotl(): rotate left.
+*/
+static inline c3_w
+_cr_mur_rotl(c3_w x_w, c3_y r_y)
+{
+  return (x_w << r_y) | (x_w >> (32 - r_y));
+}
+
+/* _cr_mur_load(): load a native-order block.
+*/
+static inline c3_w
+_cr_mur_load(const c3_y* buf_y)
+{
+  c3_w k_w;
+  memcpy(&k_w, buf_y, 4);
+  return k_w;
+}
+
+/* _cr_mur_kmix(): premix a block (independent of the hash state).
+*/
+static inline c3_w
+_cr_mur_kmix(c3_w k_w)
+{
+  k_w *= _cr_mur_c1;
+  k_w  = _cr_mur_rotl(k_w, 15);
+  return k_w * _cr_mur_c2;
+}
+
+/* _cr_mur_hmix(): fold a premixed block into the hash state.
+*/
+static inline c3_w
+_cr_mur_hmix(c3_w h_w, c3_w k_w)
+{
+  h_w ^= k_w;
+  h_w  = _cr_mur_rotl(h_w, 13);
+  return (h_w * 5) + 0xe6546b64;
+}
+
+/* _cr_mur_fmix(): finalize the hash state.
+*/
+static inline c3_w
+_cr_mur_fmix(c3_w h_w, c3_w len_w)
+{
+  h_w ^= len_w;
+  h_w ^= h_w >> 16;
+  h_w *= 0x85ebca6b;
+  h_w ^= h_w >> 13;
+  h_w *= 0xc2b2ae35;
+  h_w ^= h_w >> 16;
+  return h_w;
+}
+
+/* _cr_mur_tail(): fold the last [len_w & 3] bytes at [tal_y].
+*/
+static inline c3_w
+_cr_mur_tail(c3_w h_w, const c3_y* tal_y, c3_w len_w)
+{
+  c3_w k_w = 0;
+
+  switch ( len_w & 3 ) {
+    case 3: k_w ^= (c3_w)tal_y[2] << 16;
+    case 2: k_w ^= (c3_w)tal_y[1] << 8;
+    case 1: k_w ^= (c3_w)tal_y[0];
+            h_w ^= _cr_mur_kmix(k_w);
+  }
+
+  return h_w;
+}
+
+/* _cr_mur(): MurmurHash3_x86_32 of [len_w] bytes at [buf_y].
+**
+**   the per-block premix doesn't depend on the hash state, so we
+**   premix four blocks at once (with SSE4.1 if available),
+**   leaving only the state chain serial.
+*/
+static inline c3_w
+_cr_mur(const c3_y* buf_y, c3_w len_w, c3_w syd_w)
+{
+  c3_w h_w   = syd_w;
+  c3_w blo_w = len_w >> 2;
+  c3_w i_w   = 0;
+
+  for ( ; (i_w + 4) <= blo_w; i_w += 4 ) {
+    c3_w k_w[4];
+
+#if defined(__SSE4_1__)
+    {
+      __m128i k_i = _mm_loadu_si128((const __m128i*)(buf_y + (i_w << 2)));
+
+      k_i = _mm_mullo_epi32(k_i, _mm_set1_epi32(_cr_mur_c1));
+      k_i = _mm_or_si128(_mm_slli_epi32(k_i, 15), _mm_srli_epi32(k_i, 17));
+      k_i = _mm_mullo_epi32(k_i, _mm_set1_epi32(_cr_mur_c2));
+      _mm_storeu_si128((__m128i*)k_w, k_i);
+    }
+#else
+    k_w[0] = _cr_mur_kmix(_cr_mur_load(buf_y + (i_w << 2)));
+    k_w[1] = _cr_mur_kmix(_cr_mur_load(buf_y + (i_w << 2) + 4));
+    k_w[2] = _cr_mur_kmix(_cr_mur_load(buf_y + (i_w << 2) + 8));
+    k_w[3] = _cr_mur_kmix(_cr_mur_load(buf_y + (i_w << 2) + 12));
+#endif
+
+    h_w = _cr_mur_hmix(h_w, k_w[0]);
+    h_w = _cr_mur_hmix(h_w, k_w[1]);
+    h_w = _cr_mur_hmix(h_w, k_w[2]);
+    h_w = _cr_mur_hmix(h_w, k_w[3]);
+  }
+
+  for ( ; i_w < blo_w; i_w++ ) {
+    h_w = _cr_mur_hmix(h_w, _cr_mur_kmix(_cr_mur_load(buf_y + (i_w << 2))));
+  }
+
+  h_w = _cr_mur_tail(h_w, buf_y + (blo_w << 2), len_w);
+
+  return _cr_mur_fmix(h_w, len_w);
+}
+
+/* _cr_mug_fold(): 31-bit fold of a murmur hash (zero if we must reseed).
+*/
+static inline c3_w
+_cr_mug_fold(c3_w haz_w)
+{
+  return (haz_w >> 31) ^ (haz_w & 0x7fffffff);
+}
+
+/* _cr_met3_w(): byte-width of a word.
+*/
+static inline c3_w
+_cr_met3_w(c3_w wor_w)
+{
+  return ( 0 == wor_w ) ? 0 : (39 - __builtin_clz(wor_w)) >> 3;
+}
+
 /* u3r_mug_bytes(): Compute the mug of `buf`, `len`, LSW first.
 */
 c3_w
@@ -1321,9 +1465,7 @@ u3r_mug_bytes(const c3_y *buf_y,
   c3_w ham_w = 0;
 
   while ( 1 ) {
-    c3_w haz_w;
-    MurmurHash3_x86_32(buf_y, len_w, syd_w, &haz_w);
-    ham_w = (haz_w >> 31) ^ (haz_w & 0x7fffffff);
+    ham_w = _cr_mug_fold(_cr_mur(buf_y, len_w, syd_w));
 
     if ( 0 == ham_w ) {
       syd_w++;
@@ -1334,6 +1476,38 @@ u3r_mug_bytes(const c3_y *buf_y,
   }
 }
 
+/* _cr_mug_cat(): the mug of a direct atom (or any word as an atom).
+**
+**   equivalent to u3r_mug_bytes() on its significant bytes,
+**   as a single (partial) block.
+*/
+static inline c3_w
+_cr_mug_cat(c3_w cat_w)
+{
+  c3_w len_w = _cr_met3_w(cat_w);
+  c3_w h_w   = 0xcafebabe;
+  c3_w ham_w;
+
+  if ( 4 == len_w ) {
+    h_w = _cr_mur_hmix(h_w, _cr_mur_kmix(cat_w));
+  }
+  else if ( 0 != len_w ) {
+    //  the high bytes are already zero
+    //
+    h_w ^= _cr_mur_kmix(cat_w);
+  }
+
+  ham_w = _cr_mug_fold(_cr_mur_fmix(h_w, len_w));
+
+  //  reseed on the slow path
+  //
+  if ( 0 == ham_w ) {
+    return u3r_mug_bytes((c3_y*)&cat_w, len_w);
+  }
+
+  return ham_w;
+}
+
 /* u3r_mug_chub(): Compute the mug of `num`, LSW first.
 */
 c3_w
@@ -1356,16 +1530,21 @@ u3r_mug_string(const c3_c *a_c)
 }
 
 /* u3r_mug_words(): 31-bit nonzero MurmurHash3 on raw words.
+**
+**   NB: the length is the sum of the byte-widths of each word,
+**   not the byte-width of the whole; mugs depend on this.
 */
 c3_w
 u3r_mug_words(const c3_w* key_w, c3_w len_w)
 {
   c3_w byt_w = 0;
-  c3_w wor_w;
+
+  if ( 1 == len_w ) {
+    return _cr_mug_cat(key_w[0]);
+  }
 
   while ( 0 < len_w ) {
-    wor_w  = key_w[--len_w];
-    byt_w += _(u3a_is_cat(wor_w)) ? u3r_met(3, wor_w) : 4;
+    byt_w += _cr_met3_w(key_w[--len_w]);
   }
 
   return u3r_mug_bytes((c3_y*)key_w, byt_w);
@@ -1376,9 +1555,7 @@ u3r_mug_words(const c3_w* key_w, c3_w len_w)
 c3_w
 u3r_mug_both(c3_w lef_w, c3_w rit_w)
 {
-  c3_w ham_w = lef_w ^ (0x7fffffff ^ rit_w);
-
-  return u3r_mug_words(&ham_w, (0 == ham_w) ? 0 : 1);
+  return _cr_mug_cat(lef_w ^ (0x7fffffff ^ rit_w));
 }
 
 /* u3r_mug_cell(): Compute the mug of the cell `[hed tel]`.
@@ -1451,6 +1628,40 @@ _mug_pop(c3_ys mov, c3_ys off)
   return *fam_u;
 }
 
+/* _cr_mug_pug(): mug and memoize an indirect atom.
+*/
+static inline c3_w
+_cr_mug_pug(u3a_atom* vat_u)
+{
+  c3_w len_w = vat_u->len_w;
+  c3_w byt_w = ((len_w - 1) << 2) + _cr_met3_w(vat_u->buf_w[len_w - 1]);
+
+  return vat_u->mug_w = u3r_mug_bytes((c3_y*)vat_u->buf_w, byt_w);
+}
+
+/* _cr_mug_peek(): the mug of [som] if available without recursion, or 0.
+*/
+static inline c3_w
+_cr_mug_peek(u3_noun som)
+{
+  if ( _(u3a_is_cat(som)) ) {
+    return _cr_mug_cat(som);
+  }
+  else {
+    u3a_noun* som_u = u3a_to_ptr(som);
+
+    if ( 0 != som_u->mug_w ) {
+      return som_u->mug_w;
+    }
+    else if ( _(u3a_is_atom(som)) ) {
+      return _cr_mug_pug((u3a_atom*)som_u);
+    }
+    else {
+      return 0;
+    }
+  }
+}
+
 //  u3r_mug(): statefully mug a noun using a 31-bit MurmurHash3
 //
 c3_w
@@ -1486,7 +1697,7 @@ u3r_mug(u3_noun veb)
     //  veb is a direct atom, mug is not memoized
     //
     if ( _(u3a_is_cat(veb)) ) {
-      mug_w = u3r_mug_bytes((c3_y*)&veb, u3r_met(3, veb));
+      mug_w = _cr_mug_cat(veb);
       goto retreat;
     }
     //  veb is indirect, a pointer into the loom
@@ -1503,19 +1714,35 @@ u3r_mug(u3_noun veb)
       //  veb is an indirect atom, mug its bytes and memoize
       //
       else if ( _(u3a_is_atom(veb)) ) {
-        u3a_atom* vat_u = (u3a_atom*)veb_u;
-        mug_w = u3r_mug_bytes((c3_y*)vat_u->buf_w, u3r_met(3, veb));
-        vat_u->mug_w = mug_w;
+        mug_w = _cr_mug_pug((u3a_atom*)veb_u);
         goto retreat;
       }
-      //  veb is a cell, push a stack frame to mark head-recursion
-      //  and read the head
+      //  veb is a cell: if either side is already known,
+      //  skip the frames we'd otherwise push for it
       //
       else {
         u3a_cell* cel_u = (u3a_cell*)veb_u;
-        _mug_push(mov, off, MUG_HEAD, cel_u, 0);
-        veb = cel_u->hed;
-        goto advance;
+        c3_w      hed_w = _cr_mug_peek(cel_u->hed);
+
+        if ( 0 == hed_w ) {
+          _mug_push(mov, off, MUG_HEAD, cel_u, 0);
+          veb = cel_u->hed;
+          goto advance;
+        }
+        else {
+          c3_w tel_w = _cr_mug_peek(cel_u->tel);
+
+          if ( 0 == tel_w ) {
+            _mug_push(mov, off, MUG_TAIL, cel_u, hed_w);
+            veb = cel_u->tel;
+            goto advance;
+          }
+          else {
+            mug_w = u3r_mug_both(hed_w, tel_w);
+            cel_u->mug_w = mug_w;
+            goto retreat;
+          }
+        }
       }
     }
   }
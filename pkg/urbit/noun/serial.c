@@ -4,6 +4,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/stat.h>
 
 #include "all.h"
 
@@ -14,10 +15,243 @@ _cs_met0_w(c3_w wid_w) {
   return ( wid_w >> 31 ) ? 32 : u3r_met(0, wid_w);
 }
 
+/* _cs_met0_d(): bitwidth for any c3_d
+*/
+static inline c3_w
+_cs_met0_d(c3_d wid_d) {
+  return ( 0 == wid_d ) ? 0 : 64 - __builtin_clzll(wid_d);
+}
+
+/* u3s_bak_slot: jam backref table entry.
+*/
+typedef struct _u3s_bak_slot {
+  u3_noun som;                          //  noun
+  c3_w    mug_w;                        //  mug of som
+  c3_w    gen_w;                        //  generation, empty if stale
+  c3_d    bit_d;                        //  cursor of first occurrence
+} u3s_bak_slot;
+
+/* u3s_bak: jam backref table, open-addressed by mug, off the loom.
+**
+**   each jam has a table of its own.  one idle table is kept
+**   between jams; a new jam empties it by bumping its generation.
+**   keys are not retained, as they're all part of the noun being
+**   jammed.
+*/
+struct _u3s_bak {
+  c3_w          gen_w;                  //  current generation
+  c3_d          wid_d;                  //  capacity, a power of 2
+  c3_d          len_d;                  //  entries
+  u3s_bak_slot* sot_u;                  //  slots
+  c3_w          dep_w;                  //  comparison stack capacity
+  u3_noun*      sak;                    //  comparison stack
+};
+
+#define JAM_BAK_MIN   (1ULL << 8)       //  initial capacity
+#define JAM_BAK_KEEP  (1ULL << 16)      //  max capacity kept between jams
+
+/* _cs_jam_bak_u: the idle backref table, if any.
+**
+**   a jam in progress (or held from u3s_jam_met()) owns its table,
+**   so a nested jam takes a fresh one.  a bail leaks the table of
+**   the jam it unwinds.
+*/
+static u3s_bak* _cs_jam_bak_u;
+
+/* _cs_jam_bak_take(): take an empty backref table for a new jam.
+*/
+static u3s_bak*
+_cs_jam_bak_take(void)
+{
+  u3s_bak* bak_u = _cs_jam_bak_u;
+
+  if ( bak_u ) {
+    _cs_jam_bak_u = 0;
+  }
+  else {
+    bak_u = c3_calloc(sizeof(*bak_u));
+  }
+
+  if ( !bak_u->sot_u ) {
+    bak_u->wid_d = JAM_BAK_MIN;
+    bak_u->gen_w = 0;
+    bak_u->sot_u = c3_calloc(bak_u->wid_d * sizeof(u3s_bak_slot));
+  }
+
+  bak_u->len_d = 0;
+  bak_u->gen_w++;
+
+  //  on wraparound, clear stale generations
+  //
+  if ( 0 == bak_u->gen_w ) {
+    memset(bak_u->sot_u, 0, bak_u->wid_d * sizeof(u3s_bak_slot));
+    bak_u->gen_w = 1;
+  }
+
+  return bak_u;
+}
+
+/* _cs_jam_bak_give(): done with a backref table, keeping it if idle
+**                     and small.
+*/
+static void
+_cs_jam_bak_give(u3s_bak* bak_u)
+{
+  if ( _cs_jam_bak_u || (bak_u->wid_d > JAM_BAK_KEEP) ) {
+    c3_free(bak_u->sot_u);
+    c3_free(bak_u->sak);
+    c3_free(bak_u);
+  }
+  else {
+    bak_u->len_d = 0;
+    _cs_jam_bak_u = bak_u;
+  }
+}
+
+/* _cs_jam_bak_grow(): double the backref table.
+*/
+static void
+_cs_jam_bak_grow(u3s_bak* bak_u)
+{
+  u3s_bak_slot* sot_u = bak_u->sot_u;
+  c3_d          wid_d = bak_u->wid_d;
+  c3_w          gen_w = bak_u->gen_w;
+  c3_d          msk_d, i_d, j_d;
+
+  bak_u->wid_d = wid_d << 1;
+  bak_u->gen_w = 1;
+  bak_u->sot_u = c3_calloc(bak_u->wid_d * sizeof(u3s_bak_slot));
+  msk_d        = bak_u->wid_d - 1;
+
+  for ( i_d = 0; i_d < wid_d; i_d++ ) {
+    if ( gen_w == sot_u[i_d].gen_w ) {
+      j_d = sot_u[i_d].mug_w & msk_d;
+
+      while ( bak_u->sot_u[j_d].gen_w ) {
+        j_d = (j_d + 1) & msk_d;
+      }
+
+      bak_u->sot_u[j_d]       = sot_u[i_d];
+      bak_u->sot_u[j_d].gen_w = 1;
+    }
+  }
+
+  c3_free(sot_u);
+}
+
+/* _cs_jam_bak_same(): yes if [a] and [b] are the same noun.
+**
+**   unlike u3r_sing(), never unifies: that could free subnouns
+**   whose (unretained) pointers are in the table.
+*/
+static c3_o
+_cs_jam_bak_same(u3s_bak* bak_u, u3_noun a, u3_noun b)
+{
+  c3_w dep_w = 0;
+
+  while ( 1 ) {
+    if ( a != b ) {
+      if ( (c3y == u3a_is_atom(a)) || (c3y == u3a_is_atom(b)) ) {
+        if ( c3n == u3r_sing(a, b) ) {
+          return c3n;
+        }
+      }
+      else if ( u3r_mug(a) != u3r_mug(b) ) {
+        return c3n;
+      }
+      else {
+        u3a_cell* a_u = u3a_to_ptr(a);
+        u3a_cell* b_u = u3a_to_ptr(b);
+
+        if ( (dep_w + 2) > bak_u->dep_w ) {
+          bak_u->dep_w = ( bak_u->dep_w ) ? (bak_u->dep_w << 1) : 64;
+          bak_u->sak   = c3_realloc(bak_u->sak,
+                                    bak_u->dep_w * sizeof(u3_noun));
+        }
+
+        bak_u->sak[dep_w++] = a_u->tel;
+        bak_u->sak[dep_w++] = b_u->tel;
+        a = a_u->hed;
+        b = b_u->hed;
+        continue;
+      }
+    }
+
+    if ( 0 == dep_w ) {
+      return c3y;
+    }
+
+    b = bak_u->sak[--dep_w];
+    a = bak_u->sak[--dep_w];
+  }
+}
+
+/* _cs_jam_bak_find(): find [som], or the empty slot to put it in.
+*/
+static inline u3s_bak_slot*
+_cs_jam_bak_find(u3s_bak* bak_u, u3_noun som, c3_w mug_w)
+{
+  c3_d          msk_d = bak_u->wid_d - 1;
+  c3_d          i_d   = mug_w & msk_d;
+  u3s_bak_slot* sot_u;
+
+  while ( bak_u->gen_w == (sot_u = &bak_u->sot_u[i_d])->gen_w ) {
+    if ( (som == sot_u->som) ||
+         ( (mug_w == sot_u->mug_w) &&
+           (c3y == _cs_jam_bak_same(bak_u, som, sot_u->som)) ) )
+    {
+      return sot_u;
+    }
+    i_d = (i_d + 1) & msk_d;
+  }
+
+  return sot_u;
+}
+
+/* _cs_jam_bak_put(): find [som], or save it at cursor [bit_d].
+**
+**   produces c3y and the first cursor in *bak_d if found.
+*/
+static c3_o
+_cs_jam_bak_put(u3s_bak* bak_u, u3_noun som, c3_d bit_d, c3_d* bak_d)
+{
+  c3_w          mug_w = u3r_mug(som);
+  u3s_bak_slot* sot_u = _cs_jam_bak_find(bak_u, som, mug_w);
+
+  if ( bak_u->gen_w == sot_u->gen_w ) {
+    *bak_d = sot_u->bit_d;
+    return c3y;
+  }
+
+  sot_u->som   = som;
+  sot_u->mug_w = mug_w;
+  sot_u->gen_w = bak_u->gen_w;
+  sot_u->bit_d = bit_d;
+
+  //  keep the load factor under 1/2
+  //
+  if ( (++bak_u->len_d << 1) > bak_u->wid_d ) {
+    _cs_jam_bak_grow(bak_u);
+  }
+
+  return c3n;
+}
+
+/* _cs_jam_bak_get(): the first cursor of [som], which must be present.
+*/
+static c3_d
+_cs_jam_bak_get(u3s_bak* bak_u, u3_noun som)
+{
+  u3s_bak_slot* sot_u = _cs_jam_bak_find(bak_u, som, u3r_mug(som));
+
+  c3_assert( bak_u->gen_w == sot_u->gen_w );
+  return sot_u->bit_d;
+}
+
 /* _cs_jam_buf: struct for tracking the fibonacci-allocated jam of a noun
 */
 struct _cs_jam_fib {
-  u3p(u3h_root) har_p;
+  u3s_bak*      bak_u;
   c3_w          a_w;
   c3_w          b_w;
   c3_w          bit_w;
@@ -92,24 +326,37 @@ _cs_jam_fib_mat(struct _cs_jam_fib* fib_u, u3_noun a)
   }
 }
 
+/* _cs_jam_fib_bak(): encode a backref to cursor [bak_w]
+*/
+static void
+_cs_jam_fib_bak(struct _cs_jam_fib* fib_u, c3_w bak_w)
+{
+  //  direct unless the jam is over 2^31 bits
+  //
+  u3_atom bak = u3i_words(1, &bak_w);
+
+  _cs_jam_fib_chop(fib_u, 2, 3);
+  _cs_jam_fib_mat(fib_u, bak);
+  u3z(bak);
+}
+
 /* _cs_jam_fib_atom_cb(): encode atom or backref
 */
 static void
 _cs_jam_fib_atom_cb(u3_atom a, void* ptr_v)
 {
   struct _cs_jam_fib* fib_u = ptr_v;
-  u3_weak b = u3h_git(fib_u->har_p, a);
+  c3_d                bak_d;
 
-  //  if [a] has no backref, encode atom and put cursor into [har_p]
+  //  if [a] has no backref, encode atom and put cursor into [bak_u]
   //
-  if ( u3_none == b ) {
-    u3h_put(fib_u->har_p, a, u3i_words(1, &(fib_u->bit_w)));
+  if ( c3n == _cs_jam_bak_put(fib_u->bak_u, a, fib_u->bit_w, &bak_d) ) {
     _cs_jam_fib_chop(fib_u, 1, 0);
     _cs_jam_fib_mat(fib_u, a);
   }
   else {
     c3_w a_w = u3r_met(0, a);
-    c3_w b_w = u3r_met(0, b);
+    c3_w b_w = _cs_met0_d(bak_d);
 
     //  if [a] is smaller than the backref, encode atom
     //
@@ -120,8 +367,7 @@ _cs_jam_fib_atom_cb(u3_atom a, void* ptr_v)
     //  otherwise, encode backref
     //
     else {
-      _cs_jam_fib_chop(fib_u, 2, 3);
-      _cs_jam_fib_mat(fib_u, b);
+      _cs_jam_fib_bak(fib_u, (c3_w)bak_d);
     }
   }
 }
@@ -132,20 +378,18 @@ static c3_o
 _cs_jam_fib_cell_cb(u3_noun a, void* ptr_v)
 {
   struct _cs_jam_fib* fib_u = ptr_v;
-  u3_weak b = u3h_git(fib_u->har_p, a);
+  c3_d                bak_d;
 
-  //  if [a] has no backref, encode cell and put cursor into [har_p]
+  //  if [a] has no backref, encode cell and put cursor into [bak_u]
   //
-  if ( u3_none == b ) {
-    u3h_put(fib_u->har_p, a, u3i_words(1, &(fib_u->bit_w)));
+  if ( c3n == _cs_jam_bak_put(fib_u->bak_u, a, fib_u->bit_w, &bak_d) ) {
     _cs_jam_fib_chop(fib_u, 2, 1);
     return c3y;
   }
   //  otherwise, encode backref and shortcircuit traversal
   //
   else {
-    _cs_jam_fib_chop(fib_u, 2, 3);
-    _cs_jam_fib_mat(fib_u, b);
+    _cs_jam_fib_bak(fib_u, (c3_w)bak_d);
     return c3n;
   }
 }
@@ -159,7 +403,7 @@ c3_w*
 u3s_jam_fib(u3_noun a, c3_w* bit_w)
 {
   struct _cs_jam_fib fib_u;
-  fib_u.har_p = u3h_new();
+  fib_u.bak_u = _cs_jam_bak_take();
   //  fib(12) is small enough to be reasonably fast to allocate.
   //
   fib_u.a_w   = 144;
@@ -186,7 +430,7 @@ u3s_jam_fib(u3_noun a, c3_w* bit_w)
                                   _cs_jam_fib_cell_cb);
 
   *bit_w = fib_u.bit_w;
-  u3h_free(fib_u.har_p);
+  _cs_jam_bak_give(fib_u.bak_u);
   return fib_u.buf_w;
 }
 
@@ -204,8 +448,7 @@ _cs_jam_met_mat(c3_w wid_w)
 /* _cs_jam_met: struct for tracking the jam bitwidth of a noun
 */
 struct _cs_jam_met {
-  u3p(u3h_root) har_p;
-  u3p(u3h_root) bak_p;
+  u3s_bak*      bak_u;
   c3_d          len_d;
 };
 
@@ -215,27 +458,25 @@ static void
 _cs_jam_met_atom_cb(u3_atom a, void* ptr_v)
 {
   struct _cs_jam_met* met_u = ptr_v;
-  c3_w  a_w = u3r_met(0, a);
-  u3_weak b = u3h_git(met_u->har_p, a);
+  c3_w                a_w   = u3r_met(0, a);
+  c3_d                bak_d;
 
-  //  if we haven't haven't seen [a], put cursor into [har_p]
+  //  if we haven't haven't seen [a], put cursor into [bak_u]
   //
-  if ( u3_none == b ) {
-    u3h_put(met_u->har_p, a, u3i_chubs(1, &(met_u->len_d)));
+  if ( c3n == _cs_jam_bak_put(met_u->bak_u, a, met_u->len_d, &bak_d) ) {
     met_u->len_d += 1ULL + _cs_jam_met_mat(a_w);
   }
   else {
-    c3_w b_w = u3r_met(0, b);
+    c3_w b_w = _cs_met0_d(bak_d);
 
     //  if [a] is smaller than a backref, use directly
     //
     if ( a_w <= b_w ) {
       met_u->len_d += 1ULL + _cs_jam_met_mat(a_w);
     }
-    //  otherwise, save backref
+    //  otherwise, use the backref
     //
     else {
-      u3h_put(met_u->bak_p, a, u3k(b));
       met_u->len_d += 2ULL + _cs_jam_met_mat(b_w);
     }
   }
@@ -247,21 +488,18 @@ static c3_o
 _cs_jam_met_cell_cb(u3_noun a, void* ptr_v)
 {
   struct _cs_jam_met* met_u = ptr_v;
-  u3_weak b = u3h_git(met_u->har_p, a);
+  c3_d                bak_d;
 
-  //  if we haven't haven't seen [a], put cursor into [har_p]
+  //  if we haven't haven't seen [a], put cursor into [bak_u]
   //
-  if ( u3_none == b ) {
-    u3h_put(met_u->har_p, a, u3i_chubs(1, &(met_u->len_d)));
+  if ( c3n == _cs_jam_bak_put(met_u->bak_u, a, met_u->len_d, &bak_d) ) {
     met_u->len_d += 2ULL;
     return c3y;
   }
-  //  otherwise, save backref and shortcircuit traversal
+  //  otherwise, use the backref and shortcircuit traversal
   //
   else {
-    c3_w b_w = u3r_met(0, b);
-    u3h_put(met_u->bak_p, a, u3k(b));
-    met_u->len_d += 2ULL + _cs_jam_met_mat(b_w);
+    met_u->len_d += 2ULL + _cs_jam_met_mat(_cs_met0_d(bak_d));
     return c3n;
   }
 }
@@ -269,25 +507,31 @@ _cs_jam_met_cell_cb(u3_noun a, void* ptr_v)
 /* u3s_jam_met(): measure a noun for jam, calculating backrefs
 */
 c3_d
-u3s_jam_met(u3_noun a, u3p(u3h_root)* bak_p)
+u3s_jam_met(u3_noun a, u3s_bak** bak_u)
 {
   struct _cs_jam_met met_u;
-  met_u.har_p = u3h_new();
-  met_u.bak_p = u3h_new();
+  met_u.bak_u = _cs_jam_bak_take();
   met_u.len_d = 0ULL;
 
   u3a_walk_fore(a, &met_u, _cs_jam_met_atom_cb,
                            _cs_jam_met_cell_cb);
-  u3h_free(met_u.har_p);
-  *bak_p = met_u.bak_p;
+  *bak_u = met_u.bak_u;
 
   return met_u.len_d;
 }
 
+/* u3s_jam_free(): release backrefs from u3s_jam_met()
+*/
+void
+u3s_jam_free(u3s_bak* bak_u)
+{
+  _cs_jam_bak_give(bak_u);
+}
+
 /* _cs_jam_buf: struct for tracking the pre-measured jam of a noun
 */
 struct _cs_jam_buf {
-  u3p(u3h_root) bak_p;
+  u3s_bak*      bak_u;
   c3_w          bit_w;
   c3_w*         buf_w;
 };
@@ -319,25 +563,37 @@ _cs_jam_buf_mat(struct _cs_jam_buf* buf_u, u3_atom a)
   }
 }
 
+/* _cs_jam_buf_bak(): encode a backref to cursor [bak_w]
+*/
+static void
+_cs_jam_buf_bak(struct _cs_jam_buf* buf_u, c3_w bak_w)
+{
+  //  direct unless the jam is over 2^31 bits
+  //
+  u3_atom bak = u3i_words(1, &bak_w);
+
+  _cs_jam_buf_chop(buf_u, 2, 3);
+  _cs_jam_buf_mat(buf_u, bak);
+  u3z(bak);
+}
+
 /* _cs_jam_buf_atom_cb(): encode atom or backref
 */
 static void
 _cs_jam_buf_atom_cb(u3_atom a, void* ptr_v)
 {
   struct _cs_jam_buf* buf_u = ptr_v;
-  u3_weak b = u3h_git(buf_u->bak_p, a);
+  c3_d                bak_d = _cs_jam_bak_get(buf_u->bak_u, a);
 
-  //  if [a] has no backref (or this is the referent), encode atom
+  //  if this is the referent, encode atom
   //
-  if ( (u3_none == b) ||
-       (u3r_word(0, b) == buf_u->bit_w) )
-  {
+  if ( bak_d == buf_u->bit_w ) {
     _cs_jam_buf_chop(buf_u, 1, 0);
     _cs_jam_buf_mat(buf_u, a);
   }
   else {
     c3_w a_w = u3r_met(0, a);
-    c3_w b_w = u3r_met(0, b);
+    c3_w b_w = _cs_met0_d(bak_d);
 
     //  if [a] is smaller than the backref, encode atom
     //
@@ -348,8 +604,7 @@ _cs_jam_buf_atom_cb(u3_atom a, void* ptr_v)
     //  otherwise, encode backref
     //
     else {
-      _cs_jam_buf_chop(buf_u, 2, 3);
-      _cs_jam_buf_mat(buf_u, b);
+      _cs_jam_buf_bak(buf_u, (c3_w)bak_d);
     }
   }
 }
@@ -360,37 +615,34 @@ static c3_o
 _cs_jam_buf_cell_cb(u3_noun a, void* ptr_v)
 {
   struct _cs_jam_buf* buf_u = ptr_v;
-  u3_weak b = u3h_git(buf_u->bak_p, a);
+  c3_d                bak_d = _cs_jam_bak_get(buf_u->bak_u, a);
 
-  //  if [a] has no backref (or this is the referent), encode cell
+  //  if this is the referent, encode cell
   //
-  if ( (u3_none == b) ||
-       (u3r_word(0, b) == buf_u->bit_w) )
-  {
+  if ( bak_d == buf_u->bit_w ) {
     _cs_jam_buf_chop(buf_u, 2, 1);
     return c3y;
   }
   //  otherwise, encode backref and shortcircuit traversal
   //
   else {
-    _cs_jam_buf_chop(buf_u, 2, 3);
-    _cs_jam_buf_mat(buf_u, b);
+    _cs_jam_buf_bak(buf_u, (c3_w)bak_d);
     return c3n;
   }
 }
 
 /* u3s_jam_buf(): jam [a] into pre-allocated [buf_w], without allocation
 **
-**   using backrefs in [bak_p], as computed by u3s_jam_met()
+**   using backrefs in [bak_u], as computed by u3s_jam_met()
 **   NB [buf_w] must be pre-allocated with sufficient space
 **
 **   XX can only encode up to c3_w bits, due to use of chop
 */
 void
-u3s_jam_buf(u3_noun a, u3p(u3h_root) bak_p, c3_w* buf_w)
+u3s_jam_buf(u3_noun a, u3s_bak* bak_u, c3_w* buf_w)
 {
   struct _cs_jam_buf buf_u;
-  buf_u.bak_p = bak_p;
+  buf_u.bak_u = bak_u;
   buf_u.buf_w = buf_w;
   buf_u.bit_w = 0;
 
@@ -401,104 +653,614 @@ u3s_jam_buf(u3_noun a, u3p(u3h_root) bak_p, c3_w* buf_w)
                                   _cs_jam_buf_cell_cb);
 }
 
+/* _cs_jam_flow: struct for tracking a streaming jam of a noun
+*/
+struct _cs_jam_flow {
+  u3s_bak*      bak_u;                  //  backrefs
+  c3_d          bit_d;                  //  cursor
+  c3_d          acc_d;                  //  pending bits
+  c3_y          acc_y;                  //  pending bit count
+  c3_w          len_w;                  //  bytes in buffer
+  c3_w          max_w;                  //  buffer size
+  c3_y*         buf_y;                  //  buffer
+  c3_o        (*fun_f)(void*, c3_w, c3_y*);
+  void*         ptr_v;
+  c3_o          liv_o;                  //  no flush has failed
+};
+
+/* _cs_jam_flow_flush(): hand the buffered bytes to the callback.
+*/
+static void
+_cs_jam_flow_flush(struct _cs_jam_flow* flo_u)
+{
+  if ( flo_u->len_w && (c3y == flo_u->liv_o) ) {
+    flo_u->liv_o = flo_u->fun_f(flo_u->ptr_v, flo_u->len_w, flo_u->buf_y);
+  }
+
+  flo_u->len_w = 0;
+}
+
+/* _cs_jam_flow_bits(): write the low [wid_y] <= 32 bits of [val_w].
+*/
+static inline void
+_cs_jam_flow_bits(struct _cs_jam_flow* flo_u, c3_y wid_y, c3_w val_w)
+{
+  if ( wid_y < 32 ) {
+    val_w &= (1U << wid_y) - 1;
+  }
+
+  flo_u->acc_d |= (c3_d)val_w << flo_u->acc_y;
+  flo_u->acc_y += wid_y;
+  flo_u->bit_d += wid_y;
+
+  while ( flo_u->acc_y >= 8 ) {
+    flo_u->buf_y[flo_u->len_w++] = (c3_y)flo_u->acc_d;
+    flo_u->acc_d >>= 8;
+    flo_u->acc_y  -= 8;
+
+    if ( flo_u->len_w == flo_u->max_w ) {
+      _cs_jam_flow_flush(flo_u);
+    }
+  }
+}
+
+/* _cs_jam_flow_head(): write the length prefix for [a_w] > 0 bits.
+*/
+static void
+_cs_jam_flow_head(struct _cs_jam_flow* flo_u, c3_w a_w)
+{
+  c3_w b_w = _cs_met0_w(a_w);
+
+  _cs_jam_flow_bits(flo_u, b_w, 0);
+  _cs_jam_flow_bits(flo_u, 1, 1);
+  _cs_jam_flow_bits(flo_u, b_w - 1, a_w);
+}
+
+/* _cs_jam_flow_mat(): length-prefixed encode (mat) [a] into [flo_u]
+*/
+static void
+_cs_jam_flow_mat(struct _cs_jam_flow* flo_u, u3_atom a)
+{
+  if ( 0 == a ) {
+    _cs_jam_flow_bits(flo_u, 1, 1);
+  }
+  else {
+    c3_w a_w = u3r_met(0, a);
+
+    _cs_jam_flow_head(flo_u, a_w);
+
+    if ( c3y == u3a_is_cat(a) ) {
+      _cs_jam_flow_bits(flo_u, a_w, a);
+    }
+    else {
+      u3a_atom* pug_u = u3a_to_ptr(a);
+      c3_w      i_w, wor_w = a_w >> 5;
+
+      for ( i_w = 0; i_w < wor_w; i_w++ ) {
+        _cs_jam_flow_bits(flo_u, 32, pug_u->buf_w[i_w]);
+      }
+
+      if ( a_w & 31 ) {
+        _cs_jam_flow_bits(flo_u, a_w & 31, pug_u->buf_w[wor_w]);
+      }
+    }
+  }
+}
+
+/* _cs_jam_flow_bak(): encode a backref to cursor [bak_d]
+*/
+static void
+_cs_jam_flow_bak(struct _cs_jam_flow* flo_u, c3_d bak_d)
+{
+  _cs_jam_flow_bits(flo_u, 2, 3);
+
+  if ( 0 == bak_d ) {
+    _cs_jam_flow_bits(flo_u, 1, 1);
+  }
+  else {
+    c3_w a_w = _cs_met0_d(bak_d);
+
+    _cs_jam_flow_head(flo_u, a_w);
+    _cs_jam_flow_bits(flo_u, c3_min(a_w, 32), (c3_w)bak_d);
+
+    if ( a_w > 32 ) {
+      _cs_jam_flow_bits(flo_u, a_w - 32, (c3_w)(bak_d >> 32));
+    }
+  }
+}
+
+/* _cs_jam_flow_atom_cb(): encode atom or backref
+*/
+static void
+_cs_jam_flow_atom_cb(u3_atom a, void* ptr_v)
+{
+  struct _cs_jam_flow* flo_u = ptr_v;
+  c3_d                 bak_d;
+
+  if ( c3n == flo_u->liv_o ) {
+    return;
+  }
+
+  //  if [a] has no backref, encode atom and put cursor into [bak_u]
+  //
+  if ( c3n == _cs_jam_bak_put(flo_u->bak_u, a, flo_u->bit_d, &bak_d) ) {
+    _cs_jam_flow_bits(flo_u, 1, 0);
+    _cs_jam_flow_mat(flo_u, a);
+  }
+  else {
+    c3_w a_w = u3r_met(0, a);
+    c3_w b_w = _cs_met0_d(bak_d);
+
+    //  if [a] is smaller than the backref, encode atom
+    //
+    if ( a_w <= b_w ) {
+      _cs_jam_flow_bits(flo_u, 1, 0);
+      _cs_jam_flow_mat(flo_u, a);
+    }
+    //  otherwise, encode backref
+    //
+    else {
+      _cs_jam_flow_bak(flo_u, bak_d);
+    }
+  }
+}
+
+/* _cs_jam_flow_cell_cb(): encode cell or backref
+*/
+static c3_o
+_cs_jam_flow_cell_cb(u3_noun a, void* ptr_v)
+{
+  struct _cs_jam_flow* flo_u = ptr_v;
+  c3_d                 bak_d;
+
+  //  stop traversing if a flush has failed
+  //
+  if ( c3n == flo_u->liv_o ) {
+    return c3n;
+  }
+
+  //  if [a] has no backref, encode cell and put cursor into [bak_u]
+  //
+  if ( c3n == _cs_jam_bak_put(flo_u->bak_u, a, flo_u->bit_d, &bak_d) ) {
+    _cs_jam_flow_bits(flo_u, 2, 1);
+    return c3y;
+  }
+  //  otherwise, encode backref and shortcircuit traversal
+  //
+  else {
+    _cs_jam_flow_bak(flo_u, bak_d);
+    return c3n;
+  }
+}
+
+/* u3s_jam_flow(): jam [a] in one pass, through a [len_w]-byte [buf_y].
+**
+**   each time [buf_y] fills (and once at the end), its contents are
+**   handed to [fun_f]; a c3n from [fun_f] stops the jam.
+**   *bit_d will have the length (in bits).
+*/
+c3_o
+u3s_jam_flow(u3_noun a,
+             c3_w    len_w,
+             c3_y*   buf_y,
+             c3_o  (*fun_f)(void*, c3_w, c3_y*),
+             void*   ptr_v,
+             c3_d*   bit_d)
+{
+  struct _cs_jam_flow flo_u;
+
+  c3_assert( 0 != len_w );
+
+  flo_u.bak_u = _cs_jam_bak_take();
+  flo_u.bit_d = 0;
+  flo_u.acc_d = 0;
+  flo_u.acc_y = 0;
+  flo_u.len_w = 0;
+  flo_u.max_w = len_w;
+  flo_u.buf_y = buf_y;
+  flo_u.fun_f = fun_f;
+  flo_u.ptr_v = ptr_v;
+  flo_u.liv_o = c3y;
+
+  u3a_walk_fore(a, &flo_u, _cs_jam_flow_atom_cb,
+                           _cs_jam_flow_cell_cb);
+
+  //  pad out the last byte
+  //
+  if ( flo_u.acc_y ) {
+    flo_u.buf_y[flo_u.len_w++] = (c3_y)flo_u.acc_d;
+  }
+
+  _cs_jam_flow_flush(&flo_u);
+  _cs_jam_bak_give(flo_u.bak_u);
+
+  *bit_d = flo_u.bit_d;
+  return flo_u.liv_o;
+}
+
+/* _cs_jam_fd_cb(): write jammed bytes to a file descriptor.
+*/
+static c3_o
+_cs_jam_fd_cb(void* ptr_v, c3_w len_w, c3_y* buf_y)
+{
+  c3_i* fid_i = ptr_v;
+
+  while ( len_w ) {
+    ssize_t ret_i = write(*fid_i, buf_y, len_w);
+
+    if ( ret_i < 0 ) {
+      if ( EINTR == errno ) {
+        continue;
+      }
+
+      fprintf(stderr, "jam: write: %s\r\n", strerror(errno));
+      return c3n;
+    }
+
+    buf_y += ret_i;
+    len_w -= (c3_w)ret_i;
+  }
+
+  return c3y;
+}
+
+/* _cs_jam_fd_y: buffer for jamming to file descriptors.
+*/
+static c3_y _cs_jam_fd_y[1 << 16];
+
+/* u3s_jam_fd(): jam [a] to [fid_i], in one pass with bounded memory.
+*/
+c3_o
+u3s_jam_fd(u3_noun a, c3_i fid_i)
+{
+  c3_d bit_d;
+
+  return u3s_jam_flow(a, sizeof(_cs_jam_fd_y), _cs_jam_fd_y,
+                      _cs_jam_fd_cb, &fid_i, &bit_d);
+}
+
 /* u3s_jam_file(): jam [a] into a file, overwriting
 */
 c3_o
 u3s_jam_file(u3_noun a, c3_c* pas_c)
 {
-  u3p(u3h_root) bak_p;
   c3_i fid_i = open(pas_c, O_RDWR | O_CREAT | O_TRUNC, 0644);
-  c3_w byt_w, wor_w, len_w;
 
   if ( fid_i < 0 ) {
     fprintf(stderr, "jam: open %s: %s\r\n", pas_c, strerror(errno));
     return c3n;
   }
 
+  if ( c3n == u3s_jam_fd(a, fid_i) ) {
+    fprintf(stderr, "jam: write %s failed\r\n", pas_c);
+    goto error;
+  }
+
+  if ( 0 != fsync(fid_i) ) {
+    fprintf(stderr, "jam: fsync %s: %s\r\n", pas_c, strerror(errno));
+    goto error;
+  }
+
   {
-    c3_d len_d = u3s_jam_met(a, &bak_p);
+    close(fid_i);
+    return c3y;
+  }
 
-    if ( len_d > 0xffffffffULL ) {
-      fprintf(stderr, "jam: overflow c3_w: %" PRIu64 "\r\n", len_d);
-      u3h_free(bak_p);
-      return c3n;
+  error: {
+    close(fid_i);
+    unlink(pas_c);
+    return c3n;
+  }
+}
+
+/* _cs_cue_read: bit-reader over a byte buffer.
+*/
+typedef struct _cs_cue_read {
+  const c3_y* byt_y;                    //  buffer
+  c3_d        len_d;                    //  length in bytes
+  c3_d        bit_d;                    //  length in bits
+} _cs_cue_read;
+
+/* _cs_cue_load(): load 8 little-endian bytes at [byt_y].
+*/
+static inline c3_d
+_cs_cue_load(const c3_y* byt_y)
+{
+  return ((c3_d)byt_y[0])       | ((c3_d)byt_y[1] << 8)  |
+         ((c3_d)byt_y[2] << 16) | ((c3_d)byt_y[3] << 24) |
+         ((c3_d)byt_y[4] << 32) | ((c3_d)byt_y[5] << 40) |
+         ((c3_d)byt_y[6] << 48) | ((c3_d)byt_y[7] << 56);
+}
+
+/* _cs_cue_peek(): the 64 bits at [pos_d], zero-filled past the end.
+*/
+static inline c3_d
+_cs_cue_peek(_cs_cue_read* red_u, c3_d pos_d)
+{
+  c3_d byt_d = pos_d >> 3;
+  c3_y off_y = pos_d & 7;
+  c3_d val_d;
+
+  if ( (byt_d + 9) <= red_u->len_d ) {
+    val_d = _cs_cue_load(red_u->byt_y + byt_d) >> off_y;
+
+    if ( off_y ) {
+      val_d |= (c3_d)red_u->byt_y[byt_d + 8] << (64 - off_y);
     }
+  }
+  else if ( byt_d >= red_u->len_d ) {
+    val_d = 0;
+  }
+  //  slow path, near the end of the buffer
+  //
+  else {
+    c3_y tmp_y[9] = {0};
+    c3_d len_d    = red_u->len_d - byt_d;
 
-    //  length in bytes a la u3i_bytes
-    //
-    byt_w = (c3_w)(len_d >> 3ULL);
-    if ( len_d > (c3_d)(byt_w << 3) ) {
-      byt_w++;
+    memcpy(tmp_y, red_u->byt_y + byt_d, len_d);
+    val_d = _cs_cue_load(tmp_y) >> off_y;
+
+    if ( off_y ) {
+      val_d |= (c3_d)tmp_y[8] << (64 - off_y);
     }
+  }
+
+  return val_d;
+}
 
-    //  length in words
+/* _cs_cue_bits(): read [wid_y] <= 64 bits at [pos_d].
+*/
+static inline c3_d
+_cs_cue_bits(_cs_cue_read* red_u, c3_d pos_d, c3_y wid_y)
+{
+  c3_d val_d = _cs_cue_peek(red_u, pos_d);
+  return ( 64 == wid_y ) ? val_d : val_d & ((1ULL << wid_y) - 1);
+}
+
+/* _cs_cue_atom(): read an atom of [wid_d] bits at [pos_d].
+*/
+static u3_atom
+_cs_cue_atom(_cs_cue_read* red_u, c3_d pos_d, c3_d wid_d)
+{
+  if ( wid_d <= 64 ) {
+    c3_d val_d = _cs_cue_bits(red_u, pos_d, (c3_y)wid_d);
+    return u3i_chubs(1, &val_d);
+  }
+  else {
+    //  bits past the end of the buffer are zero;
+    //  don't allocate for them
     //
-    wor_w = (c3_w)(len_d >> 5ULL);
-    if ( len_d > (c3_d)(wor_w << 5) ) {
-      wor_w++;
+    c3_d max_d = ( pos_d >= red_u->bit_d ) ? 0 : red_u->bit_d - pos_d;
+    c3_d len_d = c3_min(wid_d, max_d);
+    c3_w len_w = (c3_w)((len_d + 31) >> 5);
+    c3_w* sal_w;
+    c3_w  i_w;
+
+    if ( 0 == len_w ) {
+      return 0;
     }
 
-    //  byte-length of word-length
-    //
-    len_w = 4 * wor_w;
-  }
+    sal_w = u3a_slab(len_w);
 
-  //  grow [fid_i] to [len_w]
-  //
-  if ( 0 != ftruncate(fid_i, len_w) ) {
-    fprintf(stderr, "jam: ftruncate grow %s: %s\r\n", pas_c, strerror(errno));
-    goto error;
+    for ( i_w = 0; i_w < len_w; i_w++ ) {
+      sal_w[i_w] = (c3_w)_cs_cue_peek(red_u, pos_d + (32ULL * i_w));
+    }
+
+    if ( len_d & 31 ) {
+      sal_w[len_w - 1] &= (1U << (len_d & 31)) - 1;
+    }
+
+    return u3a_malt(sal_w);
   }
+}
 
-  //  mmap [fid_i], jam into it, sync, and unmap
+/* _cs_cue_rub(): decode a length-prefixed atom (rub) at [pos_d].
+**
+**   produces the atom, and advances *pos_d past it;
+**   or u3_none if the length is invalid.
+*/
+static u3_weak
+_cs_cue_rub(_cs_cue_read* red_u, c3_d* pos_d)
+{
+  c3_d cur_d = *pos_d;
+  c3_d zer_d = 0;
+
+  //  count the leading zeros of the length-of-length
   //
-  {
-    c3_w* buf_w;
-    void* ptr_v = mmap(0, len_w, PROT_READ|PROT_WRITE, MAP_SHARED, fid_i, 0);
+  while ( 1 ) {
+    c3_d val_d = _cs_cue_peek(red_u, cur_d + zer_d);
 
-    if ( MAP_FAILED == ptr_v ) {
-      fprintf(stderr, "jam: mmap %s: %s\r\n", pas_c, strerror(errno));
-      goto error;
+    if ( val_d ) {
+      zer_d += (c3_d)__builtin_ctzll(val_d);
+      break;
     }
 
-    buf_w = ptr_v;
-    u3s_jam_buf(a, bak_p, buf_w);
+    zer_d += 64;
 
-    if ( 0 != msync(ptr_v, len_w, MS_SYNC) ) {
-      fprintf(stderr, "jam: msync %s: %s\r\n", pas_c, strerror(errno));
-      //  XX ignore return?
-      //
-      munmap(ptr_v, len_w);
-      goto error;
+    //  fail if decoding more bits than available
+    //
+    if ( (cur_d + zer_d) >= red_u->bit_d ) {
+      return u3_none;
     }
+  }
 
-    if ( 0 != munmap(ptr_v, len_w) ) {
-      fprintf(stderr, "jam: munmap %s: %s\r\n", pas_c, strerror(errno));
-      //  XX fatal error?
-      //
-      goto error;
+  if ( 0 == zer_d ) {
+    *pos_d = cur_d + 1;
+    return 0;
+  }
+  //  atoms are at most 2^32-1 bits long
+  //
+  else if ( 32 < zer_d ) {
+    return u3_none;
+  }
+  else {
+    c3_y bit_y = (c3_y)(zer_d - 1);
+    c3_d wid_d = (1ULL << bit_y)
+               | _cs_cue_bits(red_u, cur_d + zer_d + 1, bit_y);
+
+    cur_d += zer_d + 1 + bit_y;
+    *pos_d = cur_d + wid_d;
+
+    return _cs_cue_atom(red_u, cur_d, wid_d);
+  }
+}
+
+/* _cs_cue_rub_chub(): rub a backref into *bak_d; it must fit in a chub.
+*/
+static c3_o
+_cs_cue_rub_chub(_cs_cue_read* red_u, c3_d* pos_d, c3_d* bak_d)
+{
+  u3_weak bak = _cs_cue_rub(red_u, pos_d);
+
+  if ( u3_none == bak ) {
+    return c3n;
+  }
+  else if ( c3n == u3a_is_cat(bak) ) {
+    if ( 2 < u3r_met(5, bak) ) {
+      u3z(bak);
+      return c3n;
+    }
+    else {
+      *bak_d = u3r_chub(0, bak);
+      u3z(bak);
+      return c3y;
     }
   }
 
-  //  shrink [fid_i] to [byt_w]
+  *bak_d = bak;
+  return c3y;
+}
+
+/* _cs_cue_slot: backref table entry.
+*/
+typedef struct _cs_cue_slot {
+  c3_d    pos_d;                        //  bit offset
+  u3_noun val;                          //  value, or u3_none if empty
+} _cs_cue_slot;
+
+/* _cs_cue_tab: open-addressed backref table, off the loom.
+*/
+typedef struct _cs_cue_tab {
+  c3_d          wid_d;                  //  capacity, a power of 2
+  c3_d          len_d;                  //  entries
+  _cs_cue_slot* sot_u;                  //  slots
+} _cs_cue_tab;
+
+/* _cs_cue_tab_u: the table of the cue in progress.
+**
+**   a cue calls out to nothing that could cue, so there is at most
+**   one.  a bail unwinds without freeing the table, so we hold it
+**   here and free it at the start of the next cue.
+*/
+static _cs_cue_tab _cs_cue_tab_u;
+
+/* _cs_cue_hash(): hash a bit offset.
+*/
+static inline c3_d
+_cs_cue_hash(c3_d pos_d)
+{
+  return (pos_d * 0x9e3779b97f4a7c15ULL) ^ (pos_d >> 29);
+}
+
+/* _cs_cue_tab_init(): allocate a backref table with [wid_d] slots.
+*/
+static void
+_cs_cue_tab_init(_cs_cue_tab* tab_u, c3_d wid_d)
+{
+  c3_d i_d;
+
+  tab_u->wid_d = wid_d;
+  tab_u->len_d = 0;
+  tab_u->sot_u = c3_malloc(wid_d * sizeof(_cs_cue_slot));
+
+  for ( i_d = 0; i_d < wid_d; i_d++ ) {
+    tab_u->sot_u[i_d].val = u3_none;
+  }
+}
+
+/* _cs_cue_tab_free(): release the backref table.
+*/
+static void
+_cs_cue_tab_free(_cs_cue_tab* tab_u)
+{
+  c3_free(tab_u->sot_u);
+  tab_u->sot_u = 0;
+  tab_u->wid_d = 0;
+  tab_u->len_d = 0;
+}
+
+/* _cs_cue_tab_ins(): insert without growing.
+*/
+static inline void
+_cs_cue_tab_ins(_cs_cue_tab* tab_u, c3_d pos_d, u3_noun val)
+{
+  c3_d msk_d = tab_u->wid_d - 1;
+  c3_d i_d   = _cs_cue_hash(pos_d) & msk_d;
+
+  //  offsets are unique, so we needn't check for an existing key
   //
-  if ( 0 != ftruncate(fid_i, byt_w) ) {
-    fprintf(stderr, "jam: ftruncate shrink %s: %s\r\n", pas_c, strerror(errno));
-    goto error;
+  while ( u3_none != tab_u->sot_u[i_d].val ) {
+    i_d = (i_d + 1) & msk_d;
   }
 
-  {
-    close(fid_i);
-    u3h_free(bak_p);
-    return c3y;
+  tab_u->sot_u[i_d].pos_d = pos_d;
+  tab_u->sot_u[i_d].val   = val;
+  tab_u->len_d++;
+}
+
+/* _cs_cue_tab_grow(): double the backref table.
+*/
+static void
+_cs_cue_tab_grow(_cs_cue_tab* tab_u)
+{
+  _cs_cue_slot* sot_u = tab_u->sot_u;
+  c3_d          wid_d = tab_u->wid_d;
+  c3_d          i_d;
+
+  _cs_cue_tab_init(tab_u, wid_d << 1);
+
+  for ( i_d = 0; i_d < wid_d; i_d++ ) {
+    if ( u3_none != sot_u[i_d].val ) {
+      _cs_cue_tab_ins(tab_u, sot_u[i_d].pos_d, sot_u[i_d].val);
+    }
   }
 
-  error: {
-    close(fid_i);
-    unlink(pas_c);
-    u3h_free(bak_p);
-    return c3n;
+  c3_free(sot_u);
+}
+
+/* _cs_cue_tab_put(): save [val] at [pos_d], RETAINED.
+**
+**   every saved value is referenced by the product under
+**   construction, so the table needn't hold references.
+*/
+static inline void
+_cs_cue_tab_put(_cs_cue_tab* tab_u, c3_d pos_d, u3_noun val)
+{
+  //  keep the load factor under 1/2
+  //
+  if ( (tab_u->len_d << 1) >= tab_u->wid_d ) {
+    _cs_cue_tab_grow(tab_u);
   }
+
+  _cs_cue_tab_ins(tab_u, pos_d, val);
+}
+
+/* _cs_cue_tab_get(): find the value at [pos_d], or u3_none.
+*/
+static inline u3_weak
+_cs_cue_tab_get(_cs_cue_tab* tab_u, c3_d pos_d)
+{
+  c3_d msk_d = tab_u->wid_d - 1;
+  c3_d i_d   = _cs_cue_hash(pos_d) & msk_d;
+
+  while ( u3_none != tab_u->sot_u[i_d].val ) {
+    if ( pos_d == tab_u->sot_u[i_d].pos_d ) {
+      return tab_u->sot_u[i_d].val;
+    }
+    i_d = (i_d + 1) & msk_d;
+  }
+
+  return u3_none;
 }
 
 #define CUE_ROOT 0
@@ -511,14 +1273,13 @@ u3s_jam_file(u3_noun a, c3_c* pas_c)
 //
 //    $%  [%root ~]
 //        [%head cell-cursor=@]
-//        [%tail cell-cursor=@ hed-width=@ hed-value=*]
+//        [%tail cell-cursor=@ hed-value=*]
 //    ==
 //
 typedef struct _cs_cue_frame
 {
   c3_y    tag_y;
-  u3_atom cur;
-  u3_atom wid;
+  c3_d    cur_d;
   u3_noun hed;
 } cueframe;
 
@@ -528,8 +1289,7 @@ static inline void
 _cs_cue_push(c3_ys   mov,
              c3_ys   off,
              c3_y    tag_y,
-             u3_atom cur,
-             u3_atom wid,
+             c3_d    cur_d,
              u3_noun hed)
 {
   u3R->cap_p += mov;
@@ -550,8 +1310,7 @@ _cs_cue_push(c3_ys   mov,
 
   cueframe* fam_u = u3to(cueframe, u3R->cap_p + off);
   fam_u->tag_y = tag_y;
-  fam_u->cur   = cur;
-  fam_u->wid   = wid;
+  fam_u->cur_d = cur_d;
   fam_u->hed   = hed;
 }
 
@@ -566,11 +1325,19 @@ _cs_cue_pop(c3_ys mov, c3_ys off)
   return *fam_u;
 }
 
-/* u3s_cue(): cue [a]
+/* _cs_cue_bytes(): cue [len_d] bytes at [byt_y], little-endian,
+**                  or u3_none if they aren't a valid jam.
 */
-u3_noun
-u3s_cue(u3_atom a)
+static u3_weak
+_cs_cue_bytes(c3_d len_d, const c3_y* byt_y)
 {
+  _cs_cue_read  red_u;
+  _cs_cue_tab*  tab_u = &_cs_cue_tab_u;
+
+  red_u.byt_y = byt_y;
+  red_u.len_d = len_d;
+  red_u.bit_d = len_d << 3;
+
   //  initialize signed stack offsets (relative to north/south road)
   //
   c3_ys mov, off;
@@ -581,9 +1348,23 @@ u3s_cue(u3_atom a)
     off = ( c3y == nor_o ? 0 : -wis_y );
   }
 
-  //  initialize a hash table for dereferencing backrefs
+  //  initialize a table for dereferencing backrefs,
+  //  sized by a guess from the input length
   //
-  u3p(u3h_root) har_p = u3h_new();
+  //    the table is left over if a previous cue bailed.
+  //
+  if ( tab_u->sot_u ) {
+    _cs_cue_tab_free(tab_u);
+  }
+  {
+    c3_d wid_d = 64;
+
+    while ( (wid_d < (1ULL << 16)) && (wid_d < (len_d >> 1)) ) {
+      wid_d <<= 1;
+    }
+
+    _cs_cue_tab_init(tab_u, wid_d);
+  }
 
   //  stash the current stack post
   //
@@ -591,93 +1372,67 @@ u3s_cue(u3_atom a)
 
   //  push the (only) ROOT stack frame (our termination condition)
   //
-  _cs_cue_push(mov, off, CUE_ROOT, 0, 0, 0);
+  _cs_cue_push(mov, off, CUE_ROOT, 0, 0);
 
   // initialize cursor to bit-position 0
   //
-  u3_atom cur = 0;
+  c3_d cur_d = 0;
 
-  //  the bitwidth and product from reading at cursor
+  //  the product from reading at cursor
   //
-  u3_atom wid, pro;
+  u3_noun pro;
 
-  //  read from atom at cursor
-  //
-  //    TRANSFER .cur
+  //  read at cursor, advancing it past what we read
   //
   advance: {
-    //  read tag bit at cur
+    //  read tag bits at cur
     //
-    c3_y tag_y = u3qc_cut(0, cur, 1, a);
+    c3_y tag_y = (c3_y)_cs_cue_bits(&red_u, cur_d, 2);
 
     //  low bit unset, (1 + cur) points to an atom
     //
-    //    produce atom and the width we read
-    //
-    if ( 0 == tag_y ) {
-      u3_noun bur;
-      {
-        u3_noun x = u3qa_inc(cur);
-        bur = u3qe_rub(x, a);
-        u3z(x);
-      }
+    if ( 0 == (tag_y & 1) ) {
+      c3_d pos_d = cur_d + 1;
 
-      pro = u3k(u3t(bur));
-      u3h_put(har_p, cur, u3k(pro));
-      wid = u3qa_inc(u3h(bur));
+      if ( u3_none == (pro = _cs_cue_rub(&red_u, &pos_d)) ) {
+        goto fail;
+      }
 
-      u3z(bur);
+      _cs_cue_tab_put(tab_u, cur_d, pro);
+      cur_d = pos_d;
       goto retreat;
     }
-    else {
-      //  read tag bit at (1 + cur)
-      //
+    //  next bit set, (2 + cur) points to a backref
+    //
+    else if ( 3 == tag_y ) {
+      c3_d pos_d = cur_d + 2;
+      c3_d bak_d;
+
+      if (  (c3n == _cs_cue_rub_chub(&red_u, &pos_d, &bak_d))
+         || (u3_none == (pro = _cs_cue_tab_get(tab_u, bak_d))) )
       {
-        u3_noun x = u3qa_inc(cur);
-        tag_y = u3qc_cut(0, x, 1, a);
-        u3z(x);
+        goto fail;
       }
 
-      //  next bit set, (2 + cur) points to a backref
-      //
-      //    produce referenced value and the width we read
-      //
-      if ( 1 == tag_y ) {
-        u3_noun bur;
-        {
-          u3_noun x = u3ka_add(2, cur);
-          bur = u3qe_rub(x, a);
-          u3z(x);
-        }
-
-        pro = u3h_get(har_p, u3k(u3t(bur)));
-
-        if ( u3_none == pro ) {
-          return u3m_bail(c3__exit);
-        }
-
-        wid = u3qa_add(2, u3h(bur));
-
-        u3z(bur);
-        goto retreat;
-      }
-      //  next bit unset, (2 + cur) points to the head of a cell
-      //
-      //    push a frame to mark HEAD recursion and read the head
-      //
-      else {
-        _cs_cue_push(mov, off, CUE_HEAD, cur, 0, 0);
+      pro   = u3k(pro);
+      cur_d = pos_d;
+      goto retreat;
+    }
+    //  next bit unset, (2 + cur) points to the head of a cell
+    //
+    //    push a frame to mark HEAD recursion and read the head
+    //
+    else {
+      _cs_cue_push(mov, off, CUE_HEAD, cur_d, 0);
 
-        cur = u3qa_add(2, cur);
-        goto advance;
-      }
+      cur_d += 2;
+      goto advance;
     }
   }
 
-  //  consume: popped stack frame, .wid and .pro from above.
+  //  consume: popped stack frame and .pro from above.
   //
-  //    TRANSFER .wid, .pro, and contents of .fam_u
-  //    (.cur is in scope, but we have already lost our reference to it)
+  //    TRANSFER .pro and contents of .fam_u
   //
   retreat: {
     cueframe fam_u = _cs_cue_pop(mov, off);
@@ -693,36 +1448,167 @@ u3s_cue(u3_atom a)
         break;
       }
 
-      //  .wid and .pro are the head of the cell at fam_u.cur.
-      //  save them (and the cell cursor) in a TAIL frame,
-      //  set the cursor to the tail and read there.
+      //  .pro is the head of the cell at fam_u.cur_d.
+      //  save it (and the cell cursor) in a TAIL frame,
+      //  and read the tail at the cursor.
       //
       case CUE_HEAD: {
-        _cs_cue_push(mov, off, CUE_TAIL, fam_u.cur, wid, pro);
-
-        cur = u3ka_add(2, u3qa_add(wid, fam_u.cur));
+        _cs_cue_push(mov, off, CUE_TAIL, fam_u.cur_d, pro);
         goto advance;
       }
 
-      //  .wid and .pro are the tail of the cell at fam_u.cur,
-      //  construct the cell, memoize it, and produce it along with
-      //  its total width (as if it were a read from above).
+      //  .pro is the tail of the cell at fam_u.cur_d,
+      //  construct the cell, memoize it, and produce it
+      //  (as if it were a read from above).
       //
       case CUE_TAIL: {
         pro = u3nc(fam_u.hed, pro);
-        u3h_put(har_p, fam_u.cur, u3k(pro));
-        wid = u3ka_add(2, u3ka_add(wid, fam_u.wid));
+        _cs_cue_tab_put(tab_u, fam_u.cur_d, pro);
         goto retreat;
       }
     }
   }
 
-  u3z(wid);
-  u3h_free(har_p);
+  _cs_cue_tab_free(tab_u);
 
   //  sanity check
   //
   c3_assert( u3R->cap_p == cap_p );
 
   return pro;
+
+  //  invalid jam: release the heads of cells under construction
+  //
+  fail: {
+    cueframe fam_u;
+
+    do {
+      fam_u = _cs_cue_pop(mov, off);
+
+      if ( CUE_TAIL == fam_u.tag_y ) {
+        u3z(fam_u.hed);
+      }
+    }
+    while ( CUE_ROOT != fam_u.tag_y );
+
+    _cs_cue_tab_free(tab_u);
+    c3_assert( u3R->cap_p == cap_p );
+
+    return u3_none;
+  }
+}
+
+/* u3s_cue_bytes(): cue [len_d] bytes at [byt_y], little-endian.
+*/
+u3_noun
+u3s_cue_bytes(c3_d len_d, const c3_y* byt_y)
+{
+  u3_weak pro = _cs_cue_bytes(len_d, byt_y);
+
+  return ( u3_none == pro ) ? u3m_bail(c3__exit) : pro;
+}
+
+/* u3s_cue(): cue [a]
+*/
+u3_noun
+u3s_cue(u3_atom a)
+{
+  c3_w len_w = u3r_met(3, a);
+
+  if ( c3y == u3a_is_cat(a) ) {
+    c3_y byt_y[4];
+    u3r_bytes(0, 4, byt_y, a);
+    return u3s_cue_bytes(len_w, byt_y);
+  }
+  else {
+#ifdef U3_OS_ENDIAN_little
+    //  read directly from the atom
+    //
+    u3a_atom* pug_u = u3a_to_ptr(a);
+    return u3s_cue_bytes(len_w, (c3_y*)pug_u->buf_w);
+#else
+    c3_y*   byt_y = c3_malloc(len_w);
+    u3_noun pro;
+
+    u3r_bytes(0, len_w, byt_y, a);
+    pro = u3s_cue_bytes(len_w, byt_y);
+    c3_free(byt_y);
+
+    return pro;
+#endif
+  }
+}
+
+/* _cs_cue_map_u: the file mapping of the cue in progress.
+**
+**   an invalid jam doesn't bail, but an interrupt can still unwind
+**   past us; as with the backref table, that leaves it to the next call.
+*/
+static struct {
+  void*  ptr_v;
+  size_t len_i;
+} _cs_cue_map_u;
+
+/* u3s_cue_file(): cue the contents of a file, mapping it read-only.
+**
+**   the file is never copied onto the loom.
+**   produces u3_none if the file can't be read, or isn't a valid jam.
+*/
+u3_weak
+u3s_cue_file(c3_c* pas_c)
+{
+  struct stat buf_u;
+  c3_i        fid_i;
+  void*       ptr_v;
+  u3_noun     pro;
+
+  if ( _cs_cue_map_u.ptr_v ) {
+    munmap(_cs_cue_map_u.ptr_v, _cs_cue_map_u.len_i);
+    _cs_cue_map_u.ptr_v = 0;
+  }
+
+  if ( 0 > (fid_i = open(pas_c, O_RDONLY)) ) {
+    fprintf(stderr, "cue: open %s: %s\r\n", pas_c, strerror(errno));
+    return u3_none;
+  }
+
+  if ( 0 > fstat(fid_i, &buf_u) ) {
+    fprintf(stderr, "cue: stat %s: %s\r\n", pas_c, strerror(errno));
+    close(fid_i);
+    return u3_none;
+  }
+
+  //  an empty file can't be mapped, and holds nothing to cue
+  //
+  if ( 0 == buf_u.st_size ) {
+    fprintf(stderr, "cue: %s: empty\r\n", pas_c);
+    close(fid_i);
+    return u3_none;
+  }
+
+  ptr_v = mmap(0, buf_u.st_size, PROT_READ, MAP_PRIVATE, fid_i, 0);
+  close(fid_i);
+
+  if ( MAP_FAILED == ptr_v ) {
+    fprintf(stderr, "cue: mmap %s: %s\r\n", pas_c, strerror(errno));
+    return u3_none;
+  }
+
+  //  we read front to back, apart from backrefs
+  //
+  madvise(ptr_v, buf_u.st_size, MADV_SEQUENTIAL);
+
+  _cs_cue_map_u.ptr_v = ptr_v;
+  _cs_cue_map_u.len_i = buf_u.st_size;
+
+  pro = _cs_cue_bytes(buf_u.st_size, ptr_v);
+
+  munmap(ptr_v, buf_u.st_size);
+  _cs_cue_map_u.ptr_v = 0;
+
+  if ( u3_none == pro ) {
+    fprintf(stderr, "cue: %s: invalid jam\r\n", pas_c);
+  }
+
+  return pro;
 }
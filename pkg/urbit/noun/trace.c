@@ -487,6 +487,7 @@ u3t_damp(FILE* fil_u)
 
   u3t_print_steps(fil_u, "nocks", u3R->pro.nox_d);
   u3t_print_steps(fil_u, "cells", u3R->pro.cel_d);
+  u3n_damp(fil_u);
 
   u3R->pro.nox_d = 0;
   u3R->pro.cel_d = 0;
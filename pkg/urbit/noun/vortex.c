@@ -31,7 +31,7 @@ u3v_boot(u3_noun eve)
   u3A->roc = 0;
 
   {
-    u3_noun pro = u3m_soft(0, _cv_life, eve);
+    u3_noun pro = u3m_soft(0, 0, _cv_life, eve);
 
     if ( u3_blip != u3h(pro) ) {
       u3z(pro);
@@ -73,7 +73,7 @@ u3v_boot_lite(u3_atom lit)
   u3A->roc = 0;
 
   {
-    u3_noun pro = u3m_soft(0, _cv_lite, lit);
+    u3_noun pro = u3m_soft(0, 0, _cv_lite, lit);
 
     if ( u3_blip != u3h(pro) ) {
       u3z(pro);
@@ -365,3 +365,23 @@ u3v_mark(FILE* fil_u)
   tot_w += u3a_maid(fil_u, "  wish cache", u3a_mark_noun(arv_u->yot));
   return   u3a_maid(fil_u, "total arvo stuff", tot_w);
 }
+
+/* u3v_rewrite_compact(): rewrite arvo kernel for compaction.
+*/
+void
+u3v_rewrite_compact(void)
+{
+  u3v_arvo* arv_u = &(u3H->arv_u);
+
+  u3a_rewrite_noun(arv_u->roc);
+  u3a_rewrite_noun(arv_u->now);
+  u3a_rewrite_noun(arv_u->wen);
+  u3a_rewrite_noun(arv_u->sen);
+  u3a_rewrite_noun(arv_u->yot);
+
+  arv_u->roc = u3a_rewritten_noun(arv_u->roc);
+  arv_u->now = u3a_rewritten_noun(arv_u->now);
+  arv_u->wen = u3a_rewritten_noun(arv_u->wen);
+  arv_u->sen = u3a_rewritten_noun(arv_u->sen);
+  arv_u->yot = u3a_rewritten_noun(arv_u->yot);
+}
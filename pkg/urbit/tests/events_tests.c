@@ -0,0 +1,570 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include "all.h"
+
+static c3_c _dir_c[] = "/tmp/events_test_XXXXXX";
+
+/* _setup(): prepare for tests, on a fresh pier.
+*/
+static void
+_setup(void)
+{
+  if ( 0 == mkdtemp(_dir_c) ) {
+    fprintf(stderr, "events: mkdtemp: %s\r\n", strerror(errno));
+    exit(1);
+  }
+
+  u3m_boot(_dir_c);
+}
+
+/* _test_roc(): grow u3A->roc, producing its mug.
+*/
+static c3_w
+_test_roc(c3_w len_w)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    u3A->roc = u3nc(u3nc(i_w, u3i_string("events")), u3A->roc);
+  }
+
+  return u3r_mug(u3A->roc);
+}
+
+static c3_c* _arg_c;
+
+/* _test_boot_with(): c3y if [dir_c] boots with u3A->roc of [mug_w],
+**                    and passes the check [mod_c] (see _test_child()).
+**
+**   booting replaces the loom, so we do it in a fresh process;
+**   see main().
+*/
+static c3_o
+_test_boot_with(c3_c* dir_c, c3_w mug_w, c3_c* mod_c)
+{
+  c3_i pid_i = fork();
+  c3_i sat_i;
+
+  if ( -1 == pid_i ) {
+    fprintf(stderr, "events: fork: %s\r\n", strerror(errno));
+    exit(1);
+  }
+  else if ( 0 == pid_i ) {
+    c3_c mug_c[16];
+
+    snprintf(mug_c, 16, "%u", mug_w);
+    execl(_arg_c, _arg_c, dir_c, mug_c, mod_c, (c3_c*)0);
+    _exit(2);
+  }
+
+  if ( -1 == waitpid(pid_i, &sat_i, 0) ) {
+    return c3n;
+  }
+
+  return ( WIFEXITED(sat_i) && (0 == WEXITSTATUS(sat_i)) ) ? c3y : c3n;
+}
+
+/* _test_boot(): c3y if [dir_c] boots with u3A->roc of [mug_w].
+*/
+static c3_o
+_test_boot(c3_c* dir_c, c3_w mug_w)
+{
+  return _test_boot_with(dir_c, mug_w, 0);
+}
+
+/* _test_fork(): snapshot from a child process.
+*/
+static void
+_test_fork(void)
+{
+  c3_w for_w, aft_w;
+
+  for_w = _test_roc(20000);
+
+  if ( c3y != u3e_fork() ) {
+    fprintf(stderr, "events: fork: not forked\r\n");
+    exit(1);
+  }
+
+  //  keep writing while the child saves
+  //
+  aft_w = _test_roc(20000);
+
+  if ( c3y != u3e_wait(c3y) ) {
+    fprintf(stderr, "events: fork: wait\r\n");
+    exit(1);
+  }
+
+  //  the image is the loom as of the fork
+  //
+  if ( c3y != _test_boot(_dir_c, for_w) ) {
+    fprintf(stderr, "events: fork: image\r\n");
+    exit(1);
+  }
+
+  //  pages written since were dirtied again, and save as usual
+  //
+  u3e_save();
+
+  if ( c3y != _test_boot(_dir_c, aft_w) ) {
+    fprintf(stderr, "events: fork: resave\r\n");
+    exit(1);
+  }
+
+  //  nothing dirty, nothing to fork
+  //
+  if ( c3n != u3e_fork() ) {
+    fprintf(stderr, "events: fork: clean\r\n");
+    exit(1);
+  }
+
+  fprintf(stderr, "test_fork: ok\n");
+}
+
+/* _test_pack_flip(): c3y if the packed image at [pax_c] loads into
+**                    [bas_w] with the byte at [off_i] inverted.
+*/
+static c3_o
+_test_pack_flip(c3_c* pax_c, c3_w* bas_w, off_t off_i)
+{
+  u3e_pack_head hed_u;
+  c3_i          fid_i = open(pax_c, O_RDWR);
+  c3_y          byt_y;
+  c3_o          ret_o;
+
+  if ( (0 > fid_i) || (1 != pread(fid_i, &byt_y, 1, off_i)) ) {
+    fprintf(stderr, "events: pack: flip read\r\n");
+    exit(1);
+  }
+
+  byt_y ^= 0xff;
+  c3_assert( 1 == pwrite(fid_i, &byt_y, 1, off_i) );
+
+  ret_o = u3e_pack_load(pax_c, bas_w, &hed_u);
+
+  byt_y ^= 0xff;
+  c3_assert( 1 == pwrite(fid_i, &byt_y, 1, off_i) );
+  close(fid_i);
+
+  return ret_o;
+}
+
+/* _test_pack(): packed image round-trip, and checksums.
+*/
+static void
+_test_pack(void)
+{
+  u3e_pack_head hed_u;
+  c3_c          pax_c[8193];
+  c3_w*         bas_w;
+  c3_w          mug_w = _test_roc(10000);
+  struct stat   buf_u;
+
+  //  packed into a fresh pier, as if for migration
+  //
+  snprintf(pax_c, 8192, "%s/pak", _dir_c);
+  mkdir(pax_c, 0700);
+  snprintf(pax_c, 8192, "%s/pak/.urb", _dir_c);
+  mkdir(pax_c, 0700);
+  snprintf(pax_c, 8192, "%s/pak/.urb/chk", _dir_c);
+  mkdir(pax_c, 0700);
+  snprintf(pax_c, 8192, "%s/pak/.urb/chk/image.pak", _dir_c);
+
+  if ( c3y != u3e_pack_save(pax_c) ) {
+    fprintf(stderr, "events: pack: save\r\n");
+    exit(1);
+  }
+
+  //  load off to the side, and compare with the loom
+  //
+  bas_w = mmap(0, u3a_bytes, (PROT_READ | PROT_WRITE),
+               (MAP_ANON | MAP_PRIVATE | MAP_NORESERVE), -1, 0);
+  c3_assert( MAP_FAILED != bas_w );
+
+  if ( c3y != u3e_pack_load(pax_c, bas_w, &hed_u) ) {
+    fprintf(stderr, "events: pack: load\r\n");
+    exit(1);
+  }
+
+  {
+    size_t siz_i = (size_t)1 << (u3a_page + 2);
+    size_t sou_i = (size_t)hed_u.sou_w << (u3a_page + 2);
+
+    if ( (0 != memcmp(bas_w, u3_Loom, (size_t)hed_u.nor_w * siz_i)) ||
+         (0 != memcmp((c3_y*)bas_w + (u3a_bytes - sou_i),
+                      (c3_y*)u3_Loom + (u3a_bytes - sou_i),
+                      sou_i)) )
+    {
+      fprintf(stderr, "events: pack: contents\r\n");
+      exit(1);
+    }
+  }
+
+  //  corruption is caught, in metadata or in a page
+  //
+  c3_assert( 0 == stat(pax_c, &buf_u) );
+
+  if ( c3n != _test_pack_flip(pax_c, bas_w, sizeof(hed_u)) ) {
+    fprintf(stderr, "events: pack: bad metadata loaded\r\n");
+    exit(1);
+  }
+
+  if ( c3n != _test_pack_flip(pax_c, bas_w, buf_u.st_size - 1) ) {
+    fprintf(stderr, "events: pack: bad page loaded\r\n");
+    exit(1);
+  }
+
+  //  as is a loom shift other than ours
+  //
+  if ( c3n != _test_pack_flip(pax_c, bas_w, offsetof(u3e_pack_head, vit_w)) ) {
+    fprintf(stderr, "events: pack: other shift loaded\r\n");
+    exit(1);
+  }
+
+  //  a boot with no image unpacks it
+  //
+  {
+    c3_c dir_c[8193];
+    snprintf(dir_c, 8192, "%s/pak", _dir_c);
+
+    if ( c3y != _test_boot(dir_c, mug_w) ) {
+      fprintf(stderr, "events: pack: boot\r\n");
+      exit(1);
+    }
+  }
+
+  //  as is truncation
+  //
+  c3_assert( 0 == truncate(pax_c, buf_u.st_size - 1) );
+
+  if ( c3n != u3e_pack_load(pax_c, bas_w, &hed_u) ) {
+    fprintf(stderr, "events: pack: truncated image loaded\r\n");
+    exit(1);
+  }
+
+  munmap(bas_w, u3a_bytes);
+  fprintf(stderr, "test_pack: ok\n");
+}
+
+/* _test_vits(): an image saved with another loom shift won't boot.
+*/
+static void
+_test_vits(void)
+{
+  c3_c  pax_c[8193];
+  c3_w  mug_w = _test_roc(100);
+  c3_w  vit_w;
+  c3_i  fid_i;
+  off_t off_i = ((off_t)1 << (u3a_page + 2))
+              - (c3_wiseof(u3v_home) << 2)
+              + offsetof(u3v_home, rod_u.vit_w);
+
+  u3e_save();
+
+  snprintf(pax_c, 8192, "%s/.urb/chk/south.bin", _dir_c);
+  fid_i = open(pax_c, O_RDWR);
+
+  if ( (0 > fid_i) ||
+       (sizeof(vit_w) != pread(fid_i, &vit_w, sizeof(vit_w), off_i)) )
+  {
+    fprintf(stderr, "events: vits: read\r\n");
+    exit(1);
+  }
+
+  if ( u3a_vits != vit_w ) {
+    fprintf(stderr, "events: vits: saved %u\r\n", vit_w);
+    exit(1);
+  }
+
+  vit_w ^= 1;
+  c3_assert( sizeof(vit_w) == pwrite(fid_i, &vit_w, sizeof(vit_w), off_i) );
+
+  if ( c3n != _test_boot(_dir_c, mug_w) ) {
+    fprintf(stderr, "events: vits: booted\r\n");
+    exit(1);
+  }
+
+  vit_w ^= 1;
+  c3_assert( sizeof(vit_w) == pwrite(fid_i, &vit_w, sizeof(vit_w), off_i) );
+  close(fid_i);
+
+  if ( c3y != _test_boot(_dir_c, mug_w) ) {
+    fprintf(stderr, "events: vits: boot\r\n");
+    exit(1);
+  }
+
+  fprintf(stderr, "test_vits: ok\n");
+}
+
+/* _test_soft_probe(): c3y if soft-dirty bits track writes here,
+**                     as u3e_live() checks at boot.
+*/
+static c3_o
+_test_soft_probe(void)
+{
+  c3_w  siz_w = getpagesize();
+  c3_i  pam_i = open("/proc/self/pagemap", O_RDONLY);
+  c3_i  cle_i = open("/proc/self/clear_refs", O_WRONLY);
+  c3_o  ret_o = c3n;
+  c3_d  ent_d;
+  off_t off_i;
+  volatile c3_y* pag_y;
+
+  if ( (-1 == pam_i) || (-1 == cle_i) ) {
+    goto done;
+  }
+
+  pag_y = mmap(0, siz_w, (PROT_READ | PROT_WRITE),
+               (MAP_ANON | MAP_PRIVATE), -1, 0);
+
+  if ( MAP_FAILED == (void*)pag_y ) {
+    goto done;
+  }
+
+  off_i  = ((c3_p)pag_y / siz_w) * sizeof(c3_d);
+  pag_y[0] = 1;
+
+  if (  (1 == pwrite(cle_i, "4", 1, 0))
+     && (sizeof(ent_d) == pread(pam_i, &ent_d, sizeof(ent_d), off_i))
+     && !(ent_d & (1ULL << 55)) )
+  {
+    pag_y[0] = 2;
+
+    if (  (sizeof(ent_d) == pread(pam_i, &ent_d, sizeof(ent_d), off_i))
+       && (ent_d & (1ULL << 55)) )
+    {
+      ret_o = c3y;
+    }
+  }
+
+  munmap((void*)pag_y, siz_w);
+
+done:
+  if ( -1 != pam_i ) close(pam_i);
+  if ( -1 != cle_i ) close(cle_i);
+
+  return ret_o;
+}
+
+/* _test_soft(): with soft-dirty bits, a write to the loom doesn't
+**               fault, but is found by u3e_dirty() and saved.
+*/
+static void
+_test_soft(void)
+{
+  c3_w mug_w, pag_w;
+
+  if ( c3n == _test_soft_probe() ) {
+    fprintf(stderr, "test_soft: skipped, no soft-dirty bits\n");
+    return;
+  }
+
+  u3e_save();
+
+  if ( 0 != u3e_dirty() ) {
+    fprintf(stderr, "events: soft: dirty after save\r\n");
+    exit(1);
+  }
+
+  u3A->roc = u3nc(u3i_string("soft"), u3A->roc);
+  pag_w    = (c3_w*)u3a_to_ptr(u3A->roc) - u3_Loom;
+  pag_w  >>= u3a_page;
+
+  //  no fault was taken, so the page isn't marked yet
+  //
+  if ( u3P.dit_w[pag_w >> 5] & (1 << (pag_w & 31)) ) {
+    fprintf(stderr, "events: soft: faulted\r\n");
+    exit(1);
+  }
+
+  mug_w = u3r_mug(u3A->roc);
+
+  if (  (0 == u3e_dirty())
+     || !(u3P.dit_w[pag_w >> 5] & (1 << (pag_w & 31))) )
+  {
+    fprintf(stderr, "events: soft: page %u not found\r\n", pag_w);
+    exit(1);
+  }
+
+  u3e_save();
+
+  if ( 0 != u3e_dirty() ) {
+    fprintf(stderr, "events: soft: dirty after resave\r\n");
+    exit(1);
+  }
+
+  if ( c3y != _test_boot(_dir_c, mug_w) ) {
+    fprintf(stderr, "events: soft: boot\r\n");
+    exit(1);
+  }
+
+  fprintf(stderr, "test_soft: ok\n");
+}
+
+/* _test_lazy(): boot with the north image mapped, then shrink and
+**               discard the image beneath the mapping.
+*/
+static void
+_test_lazy(void)
+{
+  c3_w mug_w = _test_roc(50000);
+
+  u3e_save();
+
+  if ( c3y != _test_boot_with(_dir_c, mug_w, "lazy") ) {
+    fprintf(stderr, "events: lazy: boot\r\n");
+    exit(1);
+  }
+
+  if ( c3y != _test_boot_with(_dir_c, mug_w, "shrink") ) {
+    fprintf(stderr, "events: lazy: shrink\r\n");
+    exit(1);
+  }
+
+  //  the shrunken image boots, mapped or not
+  //
+  mug_w = u3r_mug(u3_nul);
+
+  if ( (c3y != _test_boot_with(_dir_c, mug_w, "lazy")) ||
+       (c3y != _test_boot(_dir_c, mug_w)) )
+  {
+    fprintf(stderr, "events: lazy: reboot\r\n");
+    exit(1);
+  }
+
+  //  last, as it empties the image
+  //
+  if ( c3y != _test_boot_with(_dir_c, mug_w, "wipe") ) {
+    fprintf(stderr, "events: lazy: wipe\r\n");
+    exit(1);
+  }
+
+  fprintf(stderr, "test_lazy: ok\n");
+}
+
+/* _test_child(): from _test_boot_with(), boot [dir_c] and check
+**                the mug of u3A->roc, then the mode [mod_c]:
+**
+**   "lazy":    boot with the north image mapped.
+**   "shrink":  mapped, then compact and save a smaller image.
+**   "wipe":    mapped, then discard the image and touch every page.
+*/
+static c3_i
+_test_child(c3_c* dir_c, c3_w mug_w, c3_c* mod_c)
+{
+  c3_w nor_w;
+
+  if ( mod_c ) {
+    u3C.wag_w |= u3o_lazy_load;
+  }
+
+  u3m_boot(dir_c);
+
+  if ( mug_w != u3r_mug(u3A->roc) ) {
+    return 1;
+  }
+
+  if ( !mod_c || !strcmp(mod_c, "lazy") ) {
+    return ( !mod_c || u3P.nor_u.map_w ) ? 0 : 1;
+  }
+
+  nor_w = u3P.nor_u.map_w;
+
+  if ( !strcmp(mod_c, "shrink") ) {
+    u3z(u3A->roc);
+    u3A->roc = u3_nul;
+    u3m_pack();
+    u3e_save();
+
+    {
+      struct stat buf_u;
+
+      if ( (0 != fstat(u3P.nor_u.fid_i, &buf_u)) ||
+           !(u3P.nor_u.pgs_w < nor_w) ||
+           (buf_u.st_size != ((off_t)u3P.nor_u.pgs_w << (u3a_page + 2))) )
+      {
+        fprintf(stderr, "events: lazy: %u pages, was %u\r\n",
+                        u3P.nor_u.pgs_w, nor_w);
+        return 1;
+      }
+    }
+  }
+  else if ( !strcmp(mod_c, "wipe") ) {
+    if ( c3y != u3e_wipe() ) {
+      return 1;
+    }
+  }
+  else {
+    return 2;
+  }
+
+  //  nothing left of the loom is mapped past the end of the file
+  //
+  {
+    volatile c3_w* wor_w = u3_Loom;
+    c3_w           i_w, sum_w = 0;
+
+    for ( i_w = 0; i_w < (nor_w << u3a_page); i_w += (1 << u3a_page) ) {
+      sum_w += wor_w[i_w];
+    }
+
+    (void)sum_w;
+  }
+
+  return 0;
+}
+
+/* main(): run all test cases.
+*/
+int
+main(int argc, char* argv[])
+{
+#if (0 != U3_OS_LoomShift)
+  //  a shifted loom is 8GB, which may not fit the test machine
+  //
+  {
+    void* map_v = mmap(0, u3a_bytes, (PROT_READ | PROT_WRITE),
+                       (MAP_ANON | MAP_PRIVATE), -1, 0);
+
+    if ( MAP_FAILED == map_v ) {
+      fprintf(stderr, "test_events: skipped, no room for the loom\n");
+      return 0;
+    }
+    munmap(map_v, u3a_bytes);
+  }
+#endif
+
+  //  from _test_boot_with(): see _test_child()
+  //
+  if ( (3 == argc) || (4 == argc) ) {
+    return _test_child(argv[1], strtoul(argv[2], 0, 10), argv[3]);
+  }
+
+  _arg_c = argv[0];
+  _setup();
+
+  _test_fork();
+  _test_pack();
+  _test_vits();
+  _test_soft();
+  _test_lazy();
+
+  //  clean up the pier
+  //
+  {
+    c3_c cmd_c[8193];
+
+    snprintf(cmd_c, 8192, "rm -rf %s", _dir_c);
+    if ( 0 != system(cmd_c) ) {
+      fprintf(stderr, "events: unable to remove %s\r\n", _dir_c);
+    }
+  }
+
+  fprintf(stderr, "test_events: ok\n");
+
+  return 0;
+}
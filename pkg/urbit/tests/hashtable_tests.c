@@ -153,6 +153,107 @@ _test_cache_replace_value(void)
   fprintf(stderr, "test_cache_replace_value: ok\r\n");
 }
 
+/* _test_del(): delete entries, shrinking nodes and buckets.
+*/
+static void
+_test_del(void)
+{
+  c3_w max_w = 1000;
+  c3_w i_w;
+
+  u3p(u3h_root) har_p = u3h_new();
+  u3h_root*     har_u = u3to(u3h_root, har_p);
+
+  for ( i_w = 0; i_w < max_w; i_w++ ) {
+    u3h_put(har_p, i_w, i_w + max_w);
+  }
+
+  for ( i_w = 0; i_w < max_w; i_w += 2 ) {
+    if ( c3y != u3h_del(har_p, i_w) ) {
+      fprintf(stderr, "test_del: missing %u\r\n", i_w);
+      exit(1);
+    }
+  }
+
+  if ( c3n != u3h_del(har_p, 0) || (max_w / 2) != har_u->use_w ) {
+    fprintf(stderr, "test_del: count\r\n");
+    exit(1);
+  }
+
+  for ( i_w = 0; i_w < max_w; i_w++ ) {
+    u3_weak val = u3h_git(har_p, i_w);
+
+    if ( (i_w & 1) ? (i_w + max_w != val) : (u3_none != val) ) {
+      fprintf(stderr, "test_del: get %u\r\n", i_w);
+      exit(1);
+    }
+  }
+
+  for ( i_w = 1; i_w < max_w; i_w += 2 ) {
+    u3h_del(har_p, i_w);
+  }
+
+  for ( i_w = 0; i_w < 64; i_w++ ) {
+    if ( 0 != har_u->sot_w[i_w] ) {
+      fprintf(stderr, "test_del: shrink\r\n");
+      exit(1);
+    }
+  }
+
+  //  28731 and 188973 have the same mug, and share a bucket
+  //
+  c3_assert( u3r_mug(28731) == u3r_mug(188973) );
+
+  u3h_put(har_p, 28731, 1);
+  u3h_put(har_p, 188973, 2);
+  u3h_put(har_p, 11165, 3);
+
+  if (  (c3y != u3h_del(har_p, 28731))
+     || (u3_none != u3h_git(har_p, 28731))
+     || (2 != u3h_git(har_p, 188973))
+     || (c3y != u3h_del(har_p, 188973))
+     || (3 != u3h_git(har_p, 11165))
+     || (1 != har_u->use_w) )
+  {
+    fprintf(stderr, "test_del: bucket\r\n");
+    exit(1);
+  }
+
+  u3h_free(har_p);
+  fprintf(stderr, "test_del: ok\r\n");
+}
+
+/* _test_cache_clock(): entries read since the last sweep survive trimming.
+*/
+static void
+_test_cache_clock(void)
+{
+  c3_w max_w = 100;
+  c3_w hot_w = 10;
+  c3_w i_w, j_w;
+
+  u3p(u3h_root) har_p = u3h_new_cache(max_w);
+
+  for ( i_w = 0; i_w < (20 * max_w); i_w++ ) {
+    u3h_put(har_p, i_w + hot_w, 0);
+
+    for ( j_w = 0; j_w < hot_w; j_w++ ) {
+      if ( (j_w + 1) != u3h_git(har_p, j_w) ) {
+        //  until the first full sweep, everything is warm
+        //
+        if ( i_w > (2 * max_w) ) {
+          fprintf(stderr, "test_cache_clock: evicted %u at %u\r\n", j_w, i_w);
+          exit(1);
+        }
+        u3h_put(har_p, j_w, j_w + 1);
+      }
+    }
+  }
+
+  u3h_free(har_p);
+  fprintf(stderr, "test_cache_clock: ok\r\n");
+}
+
 /* main(): run all test cases.
 */
 int
@@ -165,6 +266,8 @@ main(int argc, char* argv[])
   _test_skip_slot();
   _test_cache_trimming();
   _test_cache_replace_value();
+  _test_del();
+  _test_cache_clock();
 
   fprintf(stderr, "test_hashtable: ok\r\n");
 
@@ -1,3 +1,5 @@
+#include <sys/stat.h>
+
 #include "all.h"
 
 /* _setup(): prepare for tests.
@@ -273,6 +275,275 @@ _test_cue_jam()
   }
 }
 
+/* _test_cue_bytes(): cue from a raw byte buffer, with backrefs.
+*/
+static void
+_test_cue_bytes(void)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < 64; i_w++ ) {
+    u3_noun a, jam;
+    c3_w  len_w;
+    c3_y* byt_y;
+
+    //  atoms of every width around the chub and word boundaries,
+    //  shared subtrees (forcing backrefs), and a long list
+    //
+    {
+      c3_w  wid_w = (i_w * 37) + 1;
+      c3_w* buf_w = c3_calloc(((wid_w + 31) >> 5) * sizeof(c3_w));
+      u3_noun big, pre, lis = u3_nul;
+      c3_w  j_w;
+
+      for ( j_w = 0; j_w < wid_w; j_w += 3 ) {
+        buf_w[j_w >> 5] |= 1U << (j_w & 31);
+      }
+
+      big = u3i_words((wid_w + 31) >> 5, buf_w);
+      pre = u3nt(i_w, u3k(big), (1ULL << (i_w & 31)) & 0x7fffffff);
+
+      for ( j_w = 0; j_w < (i_w * 4); j_w++ ) {
+        lis = u3nc(u3nc(j_w, u3k(pre)), lis);
+      }
+
+      a = u3nq(u3k(big), u3k(pre), lis, big);
+      u3z(pre);
+      c3_free(buf_w);
+    }
+
+    jam   = u3qe_jam(a);
+    len_w = u3r_met(3, jam);
+    byt_y = c3_malloc(len_w);
+    u3r_bytes(0, len_w, byt_y, jam);
+
+    {
+      u3_noun b = u3s_cue_bytes(len_w, byt_y);
+      u3_noun c = u3s_cue(jam);
+
+      if ( (c3y != u3r_sing(a, b)) || (c3y != u3r_sing(a, c)) ) {
+        fprintf(stderr, "cue_bytes: fail %u\r\n", i_w);
+        exit(1);
+      }
+
+      u3z(b); u3z(c);
+    }
+
+    c3_free(byt_y);
+    u3z(jam); u3z(a);
+  }
+}
+
+/* _test_jam_buf(): measured jam matches fibonacci jam, with backrefs.
+*/
+static void
+_test_jam_buf(void)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < 32; i_w++ ) {
+    u3_noun a;
+
+    //  repeated atoms and cells, equal but not identical
+    //
+    {
+      u3_noun lis = u3_nul;
+      c3_w    j_w;
+
+      for ( j_w = 0; j_w < (i_w * 8); j_w++ ) {
+        u3_noun big = u3i_string("a string long enough for a backref");
+        lis = u3nc(u3nt(j_w % 7, big, u3nc(j_w % 3, 0x7fffffff)), lis);
+      }
+
+      a = u3nc(i_w, lis);
+    }
+
+    {
+      c3_w     bit_w, len_w;
+      c3_w*    fib_w = u3s_jam_fib(a, &bit_w);
+      u3s_bak* bak_u;
+      c3_d     met_d = u3s_jam_met(a, &bak_u);
+      c3_w*    buf_w;
+
+      //  another jam runs while the measured backrefs are held
+      //
+      {
+        u3_noun b = u3nt(7, u3k(a), u3k(a));
+        u3z(u3qe_jam(b));
+        u3z(b);
+      }
+
+      if ( met_d != bit_w ) {
+        fprintf(stderr, "jam_buf: met fail %u\r\n", i_w);
+        exit(1);
+      }
+
+      len_w = (bit_w + 31) >> 5;
+      buf_w = c3_calloc(len_w * sizeof(c3_w));
+      u3s_jam_buf(a, bak_u, buf_w);
+      u3s_jam_free(bak_u);
+
+      if ( 0 != memcmp(fib_w, buf_w, len_w * sizeof(c3_w)) ) {
+        fprintf(stderr, "jam_buf: buf fail %u\r\n", i_w);
+        exit(1);
+      }
+
+      {
+        u3_noun b = u3s_cue_bytes(len_w * sizeof(c3_w), (c3_y*)buf_w);
+
+        if ( c3y != u3r_sing(a, b) ) {
+          fprintf(stderr, "jam_buf: cue fail %u\r\n", i_w);
+          exit(1);
+        }
+
+        u3z(b);
+      }
+
+      c3_free(buf_w);
+      u3a_wfree(fib_w);
+    }
+
+    u3z(a);
+  }
+}
+
+/* _test_jam_flow_cb(): accumulate streamed jam bytes.
+*/
+static c3_o
+_test_jam_flow_cb(void* ptr_v, c3_w len_w, c3_y* buf_y)
+{
+  c3_y** out_y = ptr_v;
+
+  memcpy(*out_y, buf_y, len_w);
+  *out_y += len_w;
+
+  return c3y;
+}
+
+/* _test_jam_flow(): streamed jam matches jam, through a tiny buffer.
+*/
+static void
+_test_jam_flow(void)
+{
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < 32; i_w++ ) {
+    u3_noun a = u3_nul;
+    c3_w    j_w;
+
+    for ( j_w = 0; j_w < (i_w * 8); j_w++ ) {
+      u3_noun big = u3qc_bex(j_w * 5);
+      a = u3nc(u3nt(j_w % 7, big, u3i_string("backref me")), a);
+    }
+
+    {
+      u3_atom jam   = u3qe_jam(a);
+      c3_w    len_w = u3r_met(3, jam);
+      c3_y*   jam_y = c3_calloc(len_w + 1);
+      c3_y*   out_y = c3_calloc(len_w + 1);
+      c3_y*   cur_y = out_y;
+      c3_y    buf_y[7];
+      c3_d    bit_d;
+
+      u3r_bytes(0, len_w, jam_y, jam);
+
+      if ( c3n == u3s_jam_flow(a, sizeof(buf_y), buf_y,
+                               _test_jam_flow_cb, &cur_y, &bit_d) )
+      {
+        fprintf(stderr, "jam_flow: flow fail %u\r\n", i_w);
+        exit(1);
+      }
+
+      if ( (bit_d != u3r_met(0, jam)) ||
+           ((cur_y - out_y) != len_w) ||
+           (0 != memcmp(jam_y, out_y, len_w)) )
+      {
+        fprintf(stderr, "jam_flow: fail %u\r\n", i_w);
+        exit(1);
+      }
+
+      c3_free(jam_y);
+      c3_free(out_y);
+      u3z(jam);
+    }
+
+    u3z(a);
+  }
+}
+
+/* _test_cue_file(): jam to a file and cue it back from the mapping.
+*/
+static void
+_test_cue_file(void)
+{
+  c3_c    pas_c[] = "/tmp/jam_test_XXXXXX";
+  c3_i    fid_i   = mkstemp(pas_c);
+  u3_noun a       = u3_nul;
+  u3_weak b;
+  c3_w    i_w;
+
+  if ( 0 > fid_i ) {
+    fprintf(stderr, "cue_file: skipped\r\n");
+    return;
+  }
+
+  close(fid_i);
+
+  for ( i_w = 0; i_w < 1000; i_w++ ) {
+    a = u3nc(u3nt(i_w % 11, u3qc_bex(i_w % 200), u3i_string("file")), a);
+  }
+
+  if ( c3n == u3s_jam_file(a, pas_c) ) {
+    fprintf(stderr, "cue_file: jam fail\r\n");
+    exit(1);
+  }
+
+  b = u3s_cue_file(pas_c);
+
+  if ( (u3_none == b) || (c3y != u3r_sing(a, b)) ) {
+    fprintf(stderr, "cue_file: fail\r\n");
+    exit(1);
+  }
+
+  u3z(a); u3z(b);
+
+  //  a truncated jam fails cleanly, without bailing
+  //
+  {
+    struct stat buf_u;
+    u3p(void)   cap_p = u3R->cap_p;
+
+    if (  (0 != stat(pas_c, &buf_u))
+       || (0 != truncate(pas_c, buf_u.st_size / 2)) )
+    {
+      fprintf(stderr, "cue_file: truncate fail\r\n");
+      exit(1);
+    }
+
+    b = u3s_cue_file(pas_c);
+
+    if ( (u3_none != b) || (cap_p != u3R->cap_p) ) {
+      fprintf(stderr, "cue_file: invalid fail\r\n");
+      exit(1);
+    }
+  }
+
+  //  an empty file is refused, not cued
+  //
+  if ( 0 != truncate(pas_c, 0) ) {
+    fprintf(stderr, "cue_file: truncate fail\r\n");
+    exit(1);
+  }
+
+  b = u3s_cue_file(pas_c);
+  unlink(pas_c);
+
+  if ( u3_none != b ) {
+    fprintf(stderr, "cue_file: empty fail\r\n");
+    exit(1);
+  }
+}
+
 /* main(): run all test cases.
 */
 int
@@ -282,6 +553,10 @@ main(int argc, char* argv[])
 
   _test_jam();
   _test_cue_jam();
+  _test_cue_bytes();
+  _test_jam_buf();
+  _test_jam_flow();
+  _test_cue_file();
 
   fprintf(stderr, "test_jam: ok\n");
 
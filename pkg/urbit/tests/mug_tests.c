@@ -97,6 +97,196 @@ _test_mug(void)
   fprintf(stderr, "test_mug: ok\n");
 }
 
+/* _fill(): deterministic (xorshift) byte pattern.
+*/
+static void
+_fill(c3_y* buf_y, c3_w len_w, c3_w sed_w)
+{
+  c3_w x_w = 0x9e3779b9 * (sed_w + 1);
+  c3_w i_w;
+
+  for ( i_w = 0; i_w < len_w; i_w++ ) {
+    x_w ^= x_w << 13;
+    x_w ^= x_w >> 17;
+    x_w ^= x_w << 5;
+    buf_y[i_w] = (c3_y)x_w;
+  }
+}
+
+/* _test_mug_golden(): check mugs against known-good values,
+**                     covering every block/tail length and each fast path.
+*/
+static void
+_test_mug_golden(void)
+{
+  c3_y buf_y[80];
+  c3_w i_w;
+
+  {
+    static const c3_w byt_w[68] = {
+      0x79ff04e8, 0x75839266, 0x31e95cc7, 0x24e3e20a, 0x0d9e0275, 0x0aba7282,
+      0x57bb499e, 0x6dbbe77a, 0x09b7c018, 0x6db05d7b, 0x1940ebc2, 0x365a748b,
+      0x2a77bb87, 0x335508e5, 0x0525039d, 0x0a87c8db, 0x63a3118c, 0x09c96959,
+      0x33c741b3, 0x594ea1cd, 0x34292506, 0x77416063, 0x1f2dabf3, 0x5ac3ab7a,
+      0x53a13758, 0x31bf2d90, 0x02d4b43e, 0x2d424ea5, 0x26adb830, 0x3fc29a74,
+      0x5a074752, 0x6909821f, 0x36ab27d6, 0x05d4f554, 0x540ebc13, 0x427fb4ff,
+      0x5027dd14, 0x62023296, 0x27d175ae, 0x4f8ee34d, 0x6f466518, 0x536c6ac8,
+      0x1a86b2ad, 0x520d9ff3, 0x43930902, 0x5fec9492, 0x41c8bda6, 0x3e5cb176,
+      0x7651c9ef, 0x21ebcd33, 0x03de5a90, 0x79a4cd84, 0x395d0c7f, 0x026a4e0c,
+      0x3f65f92d, 0x2a2a42d0, 0x5a63f3da, 0x07215692, 0x48a04ca1, 0x0b3f57e4,
+      0x02651223, 0x56da9c81, 0x232a2cd3, 0x110ec7ca, 0x69a0d9ea, 0x368db704,
+      0x4e866616, 0x20b60d0c
+    };
+
+    for ( i_w = 0; i_w < 68; i_w++ ) {
+      _fill(buf_y, i_w, i_w);
+
+      if ( byt_w[i_w] != u3r_mug_bytes(buf_y, i_w) ) {
+        fprintf(stderr, "fail (bytes) (%u)\r\n", i_w);
+        exit(1);
+      }
+    }
+  }
+
+  {
+    static const c3_w ato_w[40] = {
+      0x0225ffd7, 0x39d23f69, 0x3e547b27, 0x362071d2, 0x760d0bb3, 0x14e77ff5,
+      0x59f483db, 0x44e4eed2, 0x31a8c7eb, 0x25c4dcb2, 0x7964ee53, 0x15adfbc9,
+      0x2c126ce3, 0x1b7891f0, 0x4a98857e, 0x76b0cde5, 0x6980c00c, 0x0ae65568,
+      0x745221f3, 0x3fc86fac, 0x2071a0b0, 0x726a996c, 0x5f8ae8a0, 0x73eaf330,
+      0x11aab918, 0x77c17c29, 0x3823d673, 0x5cc225b4, 0x4efc0aa0, 0x5d3d3d33,
+      0x087314fd, 0x6d1a4f87, 0x382707b2, 0x12d8546c, 0x0cd4d0b5, 0x22474d83,
+      0x1f2558cc, 0x6ec2f36f, 0x6d2ae209, 0x31677fd9
+    };
+
+    for ( i_w = 1; i_w <= 40; i_w++ ) {
+      u3_noun a;
+
+      _fill(buf_y, i_w, i_w + 100);
+      buf_y[i_w - 1] |= 1;
+      a = u3i_bytes(i_w, buf_y);
+
+      if ( ato_w[i_w - 1] != u3r_mug(a) ) {
+        fprintf(stderr, "fail (atoms) (%u)\r\n", i_w);
+        exit(1);
+      }
+
+      u3z(a);
+    }
+  }
+
+  {
+    static const c3_w cat_w[12] = {
+      0, 1, 2, 0xff, 0x100, 0xffff, 0x10000, 0xffffff, 0x1000000,
+      0x7fffffff, 0x12345678, 42
+    };
+    static const c3_w mug_w[12] = {
+      0x79ff04e8, 0x715c2a60, 0x718b9468, 0x37e4d879, 0x475d02c2, 0x720e2c45,
+      0x05fd69b5, 0x7ce3d7c6, 0x1cf7f56d, 0x389ca03a, 0x003669b1, 0x643849c6
+    };
+
+    for ( i_w = 0; i_w < 12; i_w++ ) {
+      if ( mug_w[i_w] != u3r_mug(cat_w[i_w]) ) {
+        fprintf(stderr, "fail (cats) (%u)\r\n", i_w);
+        exit(1);
+      }
+    }
+  }
+
+  {
+    //  NB: interior zero words don't contribute to the length
+    //
+    static const c3_w wor_w[6][3] = {
+      { 0, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0 },
+      { 0x80000000, 0, 1 }, { 0, 0, 0x80000000 }, { 5, 0, 7 }
+    };
+    static const c3_w mug_w[6] = {
+      0x79ff04e8, 0x701bb721, 0x715c2a60, 0x34a4c55b, 0x000ff07c, 0x1f8a2f36
+    };
+
+    for ( i_w = 0; i_w < 6; i_w++ ) {
+      if ( mug_w[i_w] != u3r_mug_words(wor_w[i_w], 3) ) {
+        fprintf(stderr, "fail (words) (%u)\r\n", i_w);
+        exit(1);
+      }
+    }
+  }
+
+  {
+    static const c3_d chu_d[5] = {
+      0, 1, 0x100000000ULL, 0xffffffffffffffffULL, 0x7fffffff80000000ULL
+    };
+    static const c3_w mug_w[5] = {
+      0x79ff04e8, 0x715c2a60, 0x701bb721, 0x695c8310, 0x5190f2f6
+    };
+
+    for ( i_w = 0; i_w < 5; i_w++ ) {
+      if ( mug_w[i_w] != u3r_mug_chub(chu_d[i_w]) ) {
+        fprintf(stderr, "fail (chubs) (%u)\r\n", i_w);
+        exit(1);
+      }
+    }
+  }
+
+  {
+    static const c3_w mug_w[6] = {
+      0x79ff04e8, 0x28264706, 0x3d633504, 0x02eeefbb, 0x57d9ddf6, 0x5236a687
+    };
+
+    for ( i_w = 0; i_w < 6; i_w++ ) {
+      if ( mug_w[i_w] != u3r_mug_both(i_w * 0x1234567, 0x7fffffff - i_w * 77) ) {
+        fprintf(stderr, "fail (both) (%u)\r\n", i_w);
+        exit(1);
+      }
+    }
+  }
+
+  {
+    u3_noun lis = u3_nul;
+    u3_noun tee = 0;
+    u3_noun som;
+
+    for ( i_w = 0; i_w < 100; i_w++ ) {
+      lis = u3nc(u3nt(i_w, u3qc_bex(i_w), u3i_string("mug")), lis);
+    }
+
+    if ( 0x362c37f4 != u3r_mug(lis) ) {
+      fprintf(stderr, "fail (cells) (a)\r\n");
+      exit(1);
+    }
+
+    for ( i_w = 0; i_w < 16; i_w++ ) {
+      tee = u3nc(tee, u3nc(i_w, u3k(tee)));
+    }
+
+    if ( 0x627eb03b != u3r_mug(tee) ) {
+      fprintf(stderr, "fail (cells) (b)\r\n");
+      exit(1);
+    }
+
+    som = u3nc(u3nc(1, 2), u3nc(3, 4));
+
+    if ( 0x5abbb890 != u3r_mug(som) ) {
+      fprintf(stderr, "fail (cells) (c)\r\n");
+      exit(1);
+    }
+
+    u3z(som);
+    som = u3nq(u3qc_bex(64), u3qc_bex(31), 0x7fffffff, u3nc(0, 0));
+
+    if ( 0x1b087edb != u3r_mug(som) ) {
+      fprintf(stderr, "fail (cells) (d)\r\n");
+      exit(1);
+    }
+
+    u3z(som);
+    u3z(tee);
+    u3z(lis);
+  }
+
+  fprintf(stderr, "test_mug_golden: ok\n");
+}
+
 /* main(): run all test cases.
 */
 int
@@ -105,6 +295,7 @@ main(int argc, char* argv[])
   _setup();
 
   _test_mug();
+  _test_mug_golden();
 
   return 0;
 }
@@ -322,6 +322,110 @@ _test_newt_vast(void)
   u3z(a);
 }
 
+static u3_noun rin_a[64];
+static u3_ring* red_u;
+
+static void
+_ring_poke_cb(void* vod_p, u3_atom a)
+{
+  if ( c3n == u3r_sing(rin_a[pok_w % 64], a) ) {
+    fprintf(stderr, "newt ring fail (a) %u\n", pok_w);
+    exit(1);
+  }
+
+  pok_w++;
+  u3z(a);
+
+  if ( 640 == pok_w ) {
+    uv_poll_stop(&red_u->pol_u);
+  }
+}
+
+/* _test_newt_ring(): messages through a shared ring, including
+**                    fragments, wraparound, and waiting for space
+*/
+static void
+_test_newt_ring(void)
+{
+  uv_loop_t lup_u;
+  u3_ring*  wri_u;
+  c3_i      fid_i[3];
+  c3_w      i_w;
+
+  if ( c3n == u3_newt_ring_make(1ULL << 16, fid_i) ) {
+    fprintf(stderr, "newt ring: skipped\n");
+    return;
+  }
+
+  uv_loop_init(&lup_u);
+
+  //  each side owns its eventfds, as across processes
+  //
+  {
+    c3_i dup_i[3] = { fid_i[0], dup(fid_i[1]), dup(fid_i[2]) };
+
+    wri_u = u3_newt_ring_open(&lup_u, fid_i, c3y);
+    red_u = u3_newt_ring_open(&lup_u, dup_i, c3n);
+    close(fid_i[0]);
+  }
+
+  if ( !wri_u || !red_u ) {
+    fprintf(stderr, "newt ring fail (b)\n");
+    exit(1);
+  }
+
+  wri_u->bal_f = _moat_bail_cb;
+  red_u->bal_f = _moat_bail_cb;
+  red_u->pok_f = _ring_poke_cb;
+
+  //  sizes from a byte up to several times the ring
+  //
+  for ( i_w = 0; i_w < 64; i_w++ ) {
+    c3_w  len_w = 1 + ((i_w * i_w * 97) % 300000);
+    c3_y* buf_y = c3_malloc(len_w);
+    c3_w  j_w;
+
+    for ( j_w = 0; j_w < len_w; j_w++ ) {
+      buf_y[j_w] = (c3_y)(i_w + j_w);
+    }
+    buf_y[len_w - 1] |= 1;
+
+    rin_a[i_w] = u3i_bytes(len_w, buf_y);
+    c3_free(buf_y);
+  }
+
+  pok_w = 0;
+  bal_w = 0;
+
+  u3_newt_ring_read(red_u);
+
+  for ( i_w = 0; i_w < 640; i_w++ ) {
+    u3_newt_ring_write(wri_u, u3k(rin_a[i_w % 64]));
+  }
+
+  uv_run(&lup_u, UV_RUN_DEFAULT);
+
+  if ( (640 != pok_w) || (0 != bal_w) ) {
+    fprintf(stderr, "newt ring fail (c) %u %u\n", pok_w, bal_w);
+    exit(1);
+  }
+
+  u3_newt_ring_close(wri_u);
+  u3_newt_ring_close(red_u);
+  red_u = 0;
+
+  uv_run(&lup_u, UV_RUN_DEFAULT);
+
+  if ( 0 != uv_loop_close(&lup_u) ) {
+    fprintf(stderr, "newt ring fail (d)\n");
+    exit(1);
+  }
+
+  for ( i_w = 0; i_w < 64; i_w++ ) {
+    u3z(rin_a[i_w]);
+  }
+}
+
 /* main(): run all test cases.
 */
 int
@@ -331,6 +435,7 @@ main(int argc, char* argv[])
 
   _test_newt_smol();
   _test_newt_vast();
+  _test_newt_ring();
 
   fprintf(stderr, "test_newt: ok\n");
 
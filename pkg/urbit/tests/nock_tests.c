@@ -0,0 +1,519 @@
+#include "all.h"
+
+/* _setup(): prepare for tests.
+*/
+static void
+_setup(void)
+{
+  u3m_init();
+  u3m_pave(c3y, c3n);
+  u3j_boot(c3y);
+}
+
+/* _nock_test(): check .*(bus fol) against [pro].  All TRANSFER.
+*/
+static c3_i
+_nock_test(c3_c* cap_c, u3_noun bus, u3_noun fol, u3_noun pro)
+{
+  u3_noun out = u3n_nock_on(bus, fol);
+  c3_i  ret_i = 1;
+
+  if ( c3n == u3r_sing(pro, out) ) {
+    fprintf(stderr, "*** nock: %s\r\n", cap_c);
+    ret_i = 0;
+  }
+
+  u3z(out);
+  u3z(pro);
+  return ret_i;
+}
+
+/* _test_fuse_skip(): fused test-then-skip instructions.
+*/
+static c3_i
+_test_fuse_skip(void)
+{
+  c3_i ret_i = 1;
+
+  //  ?~  ::  [6 [5 [1 0] [0 2]] [1 11] [1 22]]
+  //
+  {
+    u3_noun fol = u3nq(6, u3nt(5, u3nc(1, 0), u3nc(0, 2)),
+                          u3nc(1, 11),
+                          u3nc(1, 22));
+
+    ret_i &= _nock_test("sam0 yes", u3nc(0, 5), u3k(fol), 11);
+    ret_i &= _nock_test("sam0 no",  u3nc(3, 5), u3k(fol), 22);
+    ret_i &= _nock_test("sam0 cell", u3nc(u3nc(0, 0), 5), fol, 22);
+  }
+
+  //  [6 [5 [0 2] [1 1]] [1 11] [1 22]]
+  //
+  {
+    u3_noun fol = u3nq(6, u3nt(5, u3nc(0, 2), u3nc(1, 1)),
+                          u3nc(1, 11),
+                          u3nc(1, 22));
+
+    ret_i &= _nock_test("sam1 yes", u3nc(1, 5), u3k(fol), 11);
+    ret_i &= _nock_test("sam1 no",  u3nc(0, 5), fol, 22);
+  }
+
+  //  ?^  ::  [6 [3 0 2] [1 11] [1 22]]
+  //
+  {
+    u3_noun fol = u3nq(6, u3nt(3, 0, 2), u3nc(1, 11), u3nc(1, 22));
+
+    ret_i &= _nock_test("deep yes", u3nc(u3nc(1, 2), 5), u3k(fol), 11);
+    ret_i &= _nock_test("deep no",  u3nc(7, 5), fol, 22);
+  }
+
+  //  the inner no-branch ends in a test, but the outer skip is
+  //  also the target of the inner yes-branch, so it must not fuse
+  //
+  //    [6 [6 [0 6] [5 [1 0] [0 2]] [5 [1 0] [0 7]]] [1 11] [1 22]]
+  //
+  {
+    u3_noun fol = u3nq(6, u3nq(6, u3nc(0, 6),
+                                  u3nt(5, u3nc(1, 0), u3nc(0, 2)),
+                                  u3nt(5, u3nc(1, 0), u3nc(0, 7))),
+                          u3nc(1, 11),
+                          u3nc(1, 22));
+    c3_w a_w, b_w, c_w;
+
+    for ( a_w = 0; a_w < 2; a_w++ ) {
+      for ( b_w = 0; b_w < 2; b_w++ ) {
+        for ( c_w = 0; c_w < 2; c_w++ ) {
+          c3_t yes_t = (0 == b_w) ? (0 == a_w) : (0 == c_w);
+
+          ret_i &= _nock_test("nested", u3nt(a_w, b_w, c_w),
+                                        u3k(fol),
+                                        yes_t ? 11 : 22);
+        }
+      }
+    }
+    u3z(fol);
+  }
+
+  return ret_i;
+}
+
+/* _test_fuse_kick(): fused fragment-then-kick instructions.
+*/
+static c3_i
+_test_fuse_kick(void)
+{
+  //  [x y core], where core is [[4 0 3] 41]
+  //
+  u3_noun bus = u3nt(1, 2, u3nc(u3nt(4, 0, 3), 41));
+  u3_noun kik = u3nt(9, 2, u3nc(0, 7));
+  c3_i  ret_i = 1;
+  c3_w    i_w;
+
+  //  in tail position
+  //
+  ret_i &= _nock_test("kick tail", u3k(bus), u3k(kik), 42);
+
+  //  losing the subject:  [7 [9 2 0 7] 4 0 1]
+  //
+  ret_i &= _nock_test("kick lose", u3k(bus),
+                                   u3nt(7, u3k(kik), u3nt(4, 0, 1)),
+                                   43);
+
+  //  keeping the subject:  [8 [9 2 0 7] 0 2]
+  //
+  ret_i &= _nock_test("kick keep", u3k(bus),
+                                   u3nt(8, u3k(kik), u3nc(0, 2)),
+                                   42);
+
+  //  enough call sites to need a 16-bit index,
+  //  and enough bytecode to need a 16-bit skip
+  //
+  {
+    u3_noun fol = u3k(kik);
+    u3_noun pro = 42;
+
+    for ( i_w = 0; i_w < 300; i_w++ ) {
+      fol = u3nc(u3k(kik), fol);
+      pro = u3nc(42, pro);
+    }
+
+    fol = u3nq(6, u3nt(5, u3nc(1, 0), u3nc(0, 2)), fol, u3nc(1, 22));
+
+    ret_i &= _nock_test("kick wide yes", u3nc(0, u3k(u3t(bus))),
+                                         u3k(fol),
+                                         pro);
+    ret_i &= _nock_test("kick wide no", u3nc(3, u3k(u3t(bus))),
+                                        fol,
+                                        22);
+  }
+
+  u3z(kik);
+  u3z(bus);
+  return ret_i;
+}
+
+/* _test_stay_load(): round-trip the bytecode cache keys, directly and by |pack.
+*/
+static c3_i
+_test_stay_load(void)
+{
+  u3_noun fol = u3nq(6, u3nt(3, 0, 2), u3nc(1, 11), u3nc(1, 22));
+  u3_noun key = u3nc(u3_nul, u3k(fol));
+  u3_noun lis;
+  c3_w  len_w, num_w;
+  c3_i  ret_i = 1;
+
+  ret_i &= _nock_test("stay", u3nc(7, 5), u3k(fol), 22);
+
+  lis   = u3ke_cue(u3ke_jam(u3n_stay()));
+  len_w = u3qb_lent(lis);
+
+  if ( u3_none == u3h_git(u3R->byc.har_p, key) ) {
+    fprintf(stderr, "*** nock: stay: missing\r\n");
+    ret_i = 0;
+  }
+
+  //  as if restored without a cache
+  //
+  u3n_free();
+  u3R->byc.har_p = u3h_new();
+
+  //  a bad mug is skipped
+  //
+  lis   = u3nc(u3nt(0, u3_nul, u3nc(1, 0)), lis);
+  num_w = u3n_load(lis);
+
+  if ( (len_w != num_w) || (u3_none == u3h_git(u3R->byc.har_p, key)) ) {
+    fprintf(stderr, "*** nock: load: %u of %u\r\n", num_w, len_w);
+    ret_i = 0;
+  }
+
+  //  already present
+  //
+  if ( 0 != u3n_load(u3n_stay()) ) {
+    fprintf(stderr, "*** nock: load: duplicate\r\n");
+    ret_i = 0;
+  }
+
+  ret_i &= _nock_test("load", u3nc(u3nc(1, 2), 5), fol, 11);
+
+  u3z(key);
+
+  //  |pack recompiles the cache it has to drop
+  //
+  //    NB: nouns we hold are moved without us; rebuild them
+  //
+  u3m_pack();
+
+  fol = u3nq(6, u3nt(3, 0, 2), u3nc(1, 11), u3nc(1, 22));
+  key = u3nc(u3_nul, u3k(fol));
+
+  if ( u3_none == u3h_git(u3R->byc.har_p, key) ) {
+    fprintf(stderr, "*** nock: pack: missing\r\n");
+    ret_i = 0;
+  }
+
+  ret_i &= _nock_test("pack", u3nc(7, 5), fol, 22);
+
+  u3z(key);
+  return ret_i;
+}
+
+/* _test_pice_site(): the call site of [9 2 0 1].
+*/
+static u3j_site*
+_test_pice_site(u3_noun fol)
+{
+  u3n_prog* pog_u = u3to(u3n_prog, u3n_find(u3_nul, fol));
+
+  return ( 1 == pog_u->cal_u.len_w ) ? &(pog_u->cal_u.sit_u[0]) : 0;
+}
+
+/* _test_pice_bat(): yes if bat is [1 i_w].
+*/
+static c3_o
+_test_pice_bat(u3_weak bat, c3_w i_w)
+{
+  u3_noun pro = u3nc(1, i_w);
+  c3_o  ret_o = ( u3_none == bat ) ? c3n : u3r_sing(pro, bat);
+
+  u3z(pro);
+  return ret_o;
+}
+
+/* _test_pice(): polymorphic call sites.
+*/
+static c3_i
+_test_pice(void)
+{
+  //  every core [[1 i] 0] has a different battery
+  //
+  u3_noun   fol = u3nt(9, 2, u3nc(0, 1));
+  u3j_site* sit_u;
+  u3j_pice* pic_u;
+  c3_i    ret_i = 1;
+  c3_w      i_w;
+
+  for ( i_w = 0; i_w < 5; i_w++ ) {
+    ret_i &= _nock_test("pice", u3nc(u3nc(1, i_w), 0), u3k(fol), i_w);
+  }
+
+  if ( !(sit_u = _test_pice_site(fol)) || !sit_u->pic_p ) {
+    fprintf(stderr, "*** nock: pice: no cache\r\n");
+    u3z(fol);
+    return 0;
+  }
+
+  pic_u = u3to(u3j_pice, sit_u->pic_p);
+
+  //  most recent first, the oldest evicted
+  //
+  if (  (u3j_pice_no != pic_u->len_w)
+     || (1 != pic_u->mis_w)
+     || (c3n == _test_pice_bat(sit_u->bat, 4))
+     || (c3n == _test_pice_bat(pic_u->sit_u[0].bat, 3))
+     || (c3n == _test_pice_bat(pic_u->sit_u[2].bat, 1)) )
+  {
+    fprintf(stderr, "*** nock: pice: order\r\n");
+    ret_i = 0;
+  }
+
+  //  a hit on an older target swaps it in
+  //
+  ret_i &= _nock_test("pice hit", u3nc(u3nc(1, 2), 0), u3k(fol), 2);
+
+  if (  (1 != pic_u->mis_w)
+     || (c3n == _test_pice_bat(sit_u->bat, 2))
+     || (c3n == _test_pice_bat(pic_u->sit_u[0].bat, 4)) )
+  {
+    fprintf(stderr, "*** nock: pice: swap\r\n");
+    ret_i = 0;
+  }
+
+  //  megamorphic sites stop caching, but still work
+  //
+  for ( i_w = 5; i_w < (8 + u3j_pice_meg); i_w++ ) {
+    ret_i &= _nock_test("pice mega", u3nc(u3nc(1, i_w), 0), u3k(fol), i_w);
+  }
+
+  if (  (u3j_pice_meg != pic_u->mis_w)
+     || (c3y == _test_pice_bat(pic_u->sit_u[0].bat, 6 + u3j_pice_meg)) )
+  {
+    fprintf(stderr, "*** nock: pice: mega %u\r\n", pic_u->mis_w);
+    ret_i = 0;
+  }
+
+  //  and leave their targets as they are
+  //
+  {
+    u3_noun bat = u3k(sit_u->bat);
+
+    ret_i &= _nock_test("pice mega hit", u3nc(u3nc(1, 2), 0), u3k(fol), 2);
+    ret_i &= _nock_test("pice mega new", u3nc(u3nc(1, 99), 0), u3k(fol), 99);
+
+    if ( c3n == u3r_sing(bat, sit_u->bat) ) {
+      fprintf(stderr, "*** nock: pice: mega relocked\r\n");
+      ret_i = 0;
+    }
+
+    u3z(bat);
+  }
+
+  u3z(fol);
+  return ret_i;
+}
+
+/* _test_mega_inner(): make [9 2 0 1] megamorphic on this road, then
+**                     check that the road caches its other targets.
+*/
+static u3_noun
+_test_mega_inner(u3_noun fol)
+{
+  u3j_site* sit_u;
+  u3_noun   key = u3nc(u3nc(1, 999), 2);
+  u3_weak   got;
+  c3_i    ret_i = 1;
+  c3_w      i_w;
+
+  for ( i_w = 0; i_w < (2 + u3j_pice_no + u3j_pice_meg); i_w++ ) {
+    ret_i &= _nock_test("mega", u3nc(u3nc(1, i_w), 0), u3k(fol), i_w);
+  }
+
+  sit_u = _test_pice_site(fol);
+
+  if ( !sit_u || !sit_u->pic_p
+     || (u3j_pice_meg != u3to(u3j_pice, sit_u->pic_p)->mis_w) )
+  {
+    fprintf(stderr, "*** nock: mega: not megamorphic\r\n");
+    ret_i = 0;
+  }
+
+  ret_i &= _nock_test("mega miss", u3nc(u3nc(1, 999), 0), u3k(fol), 999);
+
+  if (  (0 == u3R->meg_p)
+     || (u3_none == (got = u3h_git(u3R->meg_p, key))) )
+  {
+    fprintf(stderr, "*** nock: mega: not cached\r\n");
+    u3z(key); u3z(fol);
+    return 1;
+  }
+
+  //  a hit reuses the target, and still runs
+  //
+  ret_i &= _nock_test("mega hit", u3nc(u3nc(1, 999), 7), u3k(fol), 999);
+
+  if ( got != u3h_git(u3R->meg_p, key) ) {
+    fprintf(stderr, "*** nock: mega: refilled\r\n");
+    ret_i = 0;
+  }
+
+  u3z(key); u3z(fol);
+  return ( ret_i ) ? 0 : 1;
+}
+
+/* _test_mega(): megamorphic call sites on an inner road.
+*/
+static c3_i
+_test_mega(void)
+{
+  u3_noun pro = u3m_soft(0, 0, _test_mega_inner, u3nt(9, 2, u3nc(0, 1)));
+  c3_i  ret_i = ( (0 == u3h(pro)) && (0 == u3t(pro)) );
+
+  if ( !ret_i ) {
+    fprintf(stderr, "*** nock: mega: soft\r\n");
+  }
+
+  u3z(pro);
+  return ret_i;
+}
+
+/* _test_pice_core(): [[1 i_w] sam par], a child core at axis 7.
+*/
+static u3_noun
+_test_pice_core(c3_w i_w, u3_noun sam, u3_noun par)
+{
+  return u3nt(u3nc(1, i_w), sam, par);
+}
+
+/* _test_pice_fine(): polymorphic call sites, on located cores.
+*/
+static c3_i
+_test_pice_fine(void)
+{
+  //  a registered root, and children under it, each battery [1 i]
+  //
+  u3_noun   fol = u3nt(7, u3nc(0, 1), u3nt(9, 2, u3nc(0, 1)));
+  u3_noun   rot = u3nc(u3nc(1, 100), 0);
+  u3j_site* sit_u;
+  u3j_pice* pic_u;
+  c3_i    ret_i = 1;
+  c3_w      i_w;
+
+  u3j_mine(u3nt(u3i_string("root"), u3nc(1, 0), u3_nul), u3k(rot));
+
+  for ( i_w = 101; i_w < 104; i_w++ ) {
+    u3j_mine(u3nt(u3i_string("kid"), u3nc(0, 7), u3_nul),
+             _test_pice_core(i_w, 0, u3k(rot)));
+  }
+
+  for ( i_w = 101; i_w < 104; i_w++ ) {
+    ret_i &= _nock_test("pice fine",
+                        _test_pice_core(i_w, 0, u3k(rot)),
+                        u3k(fol),
+                        i_w);
+  }
+
+  if (  !(sit_u = _test_pice_site(fol))
+     || (u3_none == sit_u->loc)
+     || !sit_u->pic_p )
+  {
+    fprintf(stderr, "*** nock: pice fine: not located\r\n");
+    u3z(fol); u3z(rot);
+    return 0;
+  }
+
+  pic_u = u3to(u3j_pice, sit_u->pic_p);
+
+  //  a fine-check hit, on a different sample, swaps in the older target
+  //
+  ret_i &= _nock_test("pice fine hit",
+                      _test_pice_core(101, 5, u3k(rot)),
+                      u3k(fol),
+                      101);
+
+  if (  (2 != pic_u->len_w)
+     || (0 != pic_u->mis_w)
+     || (u3_none == sit_u->loc)
+     || (c3n == _test_pice_bat(sit_u->bat, 101))
+     || (c3n == _test_pice_bat(pic_u->sit_u[0].bat, 103)) )
+  {
+    fprintf(stderr, "*** nock: pice fine: hit\r\n");
+    ret_i = 0;
+  }
+
+  //  a known battery under an unregistered parent misses the fine
+  //  check, and is run unlocated, leaving the located target cached
+  //
+  ret_i &= _nock_test("pice fine miss",
+                      _test_pice_core(102, 0, u3nc(u3nc(1, 100), 1)),
+                      u3k(fol),
+                      102);
+
+  if (  (3 != pic_u->len_w)
+     || (u3_none != sit_u->loc)
+     || (c3n == _test_pice_bat(sit_u->bat, 102))
+     || (u3_none == pic_u->sit_u[0].loc)
+     || (c3n == _test_pice_bat(pic_u->sit_u[0].bat, 101))
+     || (u3_none == pic_u->sit_u[2].loc)
+     || (c3n == _test_pice_bat(pic_u->sit_u[2].bat, 102)) )
+  {
+    fprintf(stderr, "*** nock: pice fine: miss\r\n");
+    ret_i = 0;
+  }
+
+  u3z(fol);
+  u3z(rot);
+  return ret_i;
+}
+
+/* main(): run all test cases.
+*/
+int
+main(int argc, char* argv[])
+{
+  _setup();
+
+  if ( !_test_fuse_skip() ) {
+    fprintf(stderr, "test nock fuse skip: failed\r\n");
+    exit(1);
+  }
+
+  if ( !_test_fuse_kick() ) {
+    fprintf(stderr, "test nock fuse kick: failed\r\n");
+    exit(1);
+  }
+
+  if ( !_test_stay_load() ) {
+    fprintf(stderr, "test nock stay load: failed\r\n");
+    exit(1);
+  }
+
+  if ( !_test_pice() ) {
+    fprintf(stderr, "test nock pice: failed\r\n");
+    exit(1);
+  }
+
+  if ( !_test_pice_fine() ) {
+    fprintf(stderr, "test nock pice fine: failed\r\n");
+    exit(1);
+  }
+
+  if ( !_test_mega() ) {
+    fprintf(stderr, "test nock mega: failed\r\n");
+    exit(1);
+  }
+
+  fprintf(stderr, "test_nock: ok\n");
+
+  return 0;
+}
@@ -1614,6 +1614,394 @@ _test_nvm_stack_south(u3_noun arg)
 }
 #endif
 
+/* _test_sand_inner(): allocate and free garbage on a sand road.
+*/
+static u3_noun
+_test_sand_inner(u3_noun arg)
+{
+  u3_noun pro = u3_nul;
+  c3_w    i_w;
+
+  if ( c3n == u3a_is_sand(u3R) ) {
+    printf("*** sand: road\n");
+  }
+
+  for ( i_w = 0; i_w < 1000; i_w++ ) {
+    u3_noun    tmp = u3nc(u3i_string("abcdefghijklmnopqrstuvwxyz"), i_w);
+    u3_post  hat_p = u3R->hat_p;
+
+    u3z(tmp);
+
+    //  frees must not return memory to the hat
+    //
+    if ( hat_p != u3R->hat_p ) {
+      printf("*** sand: free\n");
+    }
+
+    pro = u3nc(u3k(arg), pro);
+  }
+
+  return pro;
+}
+
+/* _test_sand(): bump-allocated virtualization.
+*/
+static void
+_test_sand()
+{
+  u3_noun arg = u3i_string("sand road product");
+  u3_noun pro = u3m_soft(0, u3a_flag_sand, _test_sand_inner, u3k(arg));
+
+  if ( 0 != u3h(pro) ) {
+    printf("*** sand: soft\n");
+  }
+  else {
+    u3_noun lis = u3t(pro);
+    c3_w  len_w = 0;
+
+    while ( u3_nul != lis ) {
+      if ( c3n == u3r_sing(arg, u3h(lis)) ) {
+        printf("*** sand: product\n");
+      }
+      lis = u3t(lis);
+      len_w++;
+    }
+
+    if ( 1000 != len_w ) {
+      printf("*** sand: length\n");
+    }
+  }
+
+  if ( c3y == u3a_is_sand(u3R) ) {
+    printf("*** sand: home\n");
+  }
+
+  u3z(pro);
+  u3z(arg);
+}
+
+/* _test_slabs_inner(): reuse small boxes on an inner road.
+*/
+static u3_noun
+_test_slabs_inner(u3_noun arg)
+{
+  c3_w len_w;
+
+  for ( len_w = 1; len_w < 64; len_w++ ) {
+    c3_w* fir_w = u3a_walloc(len_w);
+    c3_w* sec_w;
+
+    u3a_wfree(fir_w);
+    sec_w = u3a_walloc(len_w);
+
+    //  small boxes are reused, last in first out
+    //
+    if ( (u3a_boxed(len_w) <= u3a_sabs_max) && (fir_w != sec_w) ) {
+      printf("*** slabs: reuse %u\n", len_w);
+    }
+
+    if ( u3a_botox(sec_w)->siz_w < u3a_boxed(len_w) ) {
+      printf("*** slabs: size %u\n", len_w);
+    }
+
+    u3a_wfree(sec_w);
+  }
+
+  if ( 0 == u3a_idle_slabs(u3R) ) {
+    printf("*** slabs: idle\n");
+  }
+
+  {
+    u3_noun pro = u3_nul;
+    c3_w    i_w;
+
+    for ( i_w = 0; i_w < 10000; i_w++ ) {
+      c3_w wor_w[3] = { i_w, 0xdeadbeef, i_w % 7 };
+
+      u3z(u3i_words(1 + (i_w % 3), wor_w));
+      pro = u3nc(u3i_words(2, wor_w), pro);
+    }
+
+    return pro;
+  }
+}
+
+/* _test_slabs(): size-class allocation.
+*/
+static void
+_test_slabs()
+{
+  u3_noun pro = u3m_soft(0, 0, _test_slabs_inner, 0);
+
+  if ( 0 != u3h(pro) ) {
+    printf("*** slabs: soft\n");
+  }
+  else {
+    u3_noun lis = u3t(pro);
+    c3_w    i_w = 10000;
+
+    while ( u3_nul != lis ) {
+      i_w--;
+
+      if ( (i_w != u3r_word(0, u3h(lis))) ||
+           (0xdeadbeef != u3r_word(1, u3h(lis))) )
+      {
+        printf("*** slabs: product\n");
+      }
+      lis = u3t(lis);
+    }
+
+    if ( 0 != i_w ) {
+      printf("*** slabs: length\n");
+    }
+  }
+
+  if ( 0 != u3a_idle_slabs(u3R) ) {
+    printf("*** slabs: home\n");
+  }
+
+  u3z(pro);
+}
+
+/* _test_walign_inner(): box alignment on an inner road.
+*/
+static u3_noun
+_test_walign_inner(u3_noun arg)
+{
+  u3_noun pro = u3_nul;
+  c3_w    len_w;
+
+  for ( len_w = 1; len_w < 200; len_w++ ) {
+    c3_w* sal_w = u3a_slaq(5, len_w);
+    u3_noun som;
+
+    if ( 0 != (u3a_outa(sal_w) & (u3a_walign - 1)) ) {
+      printf("*** walign: slab %u\n", len_w);
+    }
+
+    memset(sal_w, 0xff, len_w << 2);
+    som = u3a_mint(sal_w, (len_w + 1) >> 1);
+    pro = u3nc(som, pro);
+
+    if ( u3a_to_ptr(u3a_to_pom(u3a_to_off(pro))) != u3a_to_ptr(pro) ) {
+      printf("*** walign: pointer %u\n", len_w);
+    }
+  }
+
+  return pro;
+}
+
+/* _test_walign(): nouns survive pointer compression.
+*/
+static void
+_test_walign()
+{
+  u3_noun pro = u3m_soft(0, 0, _test_walign_inner, 0);
+
+  if ( 0 != u3h(pro) ) {
+    printf("*** walign: soft\n");
+  }
+  else {
+    u3_noun lis = u3t(pro);
+    c3_w    len_w = 200;
+
+    while ( u3_nul != lis ) {
+      len_w--;
+
+      if ( ((len_w + 1) >> 1) != u3r_met(5, u3h(lis)) ) {
+        printf("*** walign: product %u\n", len_w);
+      }
+      lis = u3t(lis);
+    }
+  }
+
+  u3z(pro);
+}
+
+/* _test_pack(): compact the home road in place.
+*/
+static void
+_test_pack()
+{
+  u3_noun fra = u3_nul;
+  u3_noun lis = u3_nul;
+  u3_noun key = u3i_string("pack");
+  c3_w    i_w, gal_w;
+
+  u3j_boot(c3y);
+
+  //  interleave garbage with the survivors, so there's a gap to close
+  //
+  for ( i_w = 0; i_w < 20000; i_w++ ) {
+    c3_w wor_w[2] = { i_w, 0xcafebabe };
+
+    fra = u3nc(u3i_words(2, wor_w), fra);
+    lis = u3nc(u3nc(i_w, u3i_words(2, wor_w)), lis);
+  }
+  u3z(fra);
+
+  u3A->roc = lis;
+  u3h_put(u3R->jed.cod_p, key, u3k(lis));
+
+  gal_w = u3m_pack();
+
+  if ( 0 == gal_w ) {
+    printf("*** pack: gained\n");
+  }
+
+  lis = u3A->roc;
+
+  if ( lis != u3h_get(u3R->jed.cod_p, key) ) {
+    printf("*** pack: hashtable\n");
+  }
+
+  i_w = 20000;
+
+  while ( u3_nul != lis ) {
+    u3_noun i_lis = u3h(lis);
+
+    i_w--;
+
+    if ( (i_w != u3h(i_lis)) ||
+         (i_w != u3r_word(0, u3t(i_lis))) ||
+         (0xcafebabe != u3r_word(1, u3t(i_lis))) )
+    {
+      printf("*** pack: product %u\n", i_w);
+      break;
+    }
+    lis = u3t(lis);
+  }
+
+  if ( 0 != i_w ) {
+    printf("*** pack: length\n");
+  }
+
+  //  the heap still works
+  //
+  u3z(u3qb_flop(u3A->roc));
+
+  u3z(u3A->roc);
+  u3A->roc = 0;
+  u3z(key);
+}
+
+/* _test_meld(): test hash-consing deduplication.
+*/
+static void
+_test_meld()
+{
+  u3_noun lis = u3_nul;
+  u3_noun fir, pat, nul;
+  c3_w    i_w, sav_w = 0;
+
+  //  structurally identical, physically distinct
+  //
+  for ( i_w = 0; i_w < 1000; i_w++ ) {
+    pat = u3nq(c3__fon, u3i_string("a duplicated indirect atom"), i_w & 1, u3_nul);
+    lis = u3nc(u3nc(i_w, pat), lis);
+  }
+
+  u3a_meld_start(u3k(lis));
+
+  while ( c3n == u3a_meld(1, &sav_w) ) {
+  }
+
+  u3a_meld_stop();
+
+  if ( 0 == sav_w ) {
+    printf("*** meld: saved\n");
+  }
+
+  nul = lis;
+  fir = u3t(u3h(lis));
+  pat = u3t(u3h(u3t(lis)));
+
+  if ( u3h(u3t(fir)) != u3h(u3t(pat)) ) {
+    printf("*** meld: shared atom\n");
+  }
+
+  i_w = 1000;
+
+  while ( u3_nul != lis ) {
+    u3_noun i_lis = u3h(lis);
+
+    i_w--;
+
+    if ( (i_w != u3h(i_lis)) ||
+         (c3__fon != u3h(u3t(i_lis))) ||
+         ((i_w & 1) != u3h(u3t(u3t(u3t(i_lis))))) )
+    {
+      printf("*** meld: product %u\n", i_w);
+      break;
+    }
+
+    if ( u3t(i_lis) != ((i_w & 1) ? fir : pat) ) {
+      printf("*** meld: shared %u\n", i_w);
+      break;
+    }
+    lis = u3t(lis);
+  }
+
+  if ( 0 != i_w ) {
+    printf("*** meld: length\n");
+  }
+
+  if ( (500 != u3a_use(fir)) ||
+       (500 != u3a_use(pat)) ||
+       (2 != u3a_use(u3h(u3t(fir)))) )
+  {
+    printf("*** meld: refcount\n");
+  }
+
+  u3z(nul);
+}
+
+/* _test_meld_full(): test that meld stops short of a full loom.
+*/
+static void
+_test_meld_full()
+{
+  u3_noun lis = u3_nul;
+  c3_w    i_w, sav_w = 0;
+  c3_w*   fil_w;
+
+  for ( i_w = 0; i_w < 100; i_w++ ) {
+    lis = u3nc(u3i_string("a duplicated indirect atom"), lis);
+  }
+
+  u3a_meld_start(u3k(lis));
+
+  //  leave too little room to go on
+  //
+  fil_w = u3a_walloc(u3a_open(u3R) - 4096);
+
+  if ( c3n != u3a_meld(0, &sav_w) ) {
+    printf("*** meld full: finished\n");
+  }
+
+  if ( c3n != u3a_meld_live() ) {
+    printf("*** meld full: live\n");
+    u3a_meld_stop();
+  }
+
+  u3a_wfree(fil_w);
+
+  //  and room enough to start over
+  //
+  u3a_meld_start(u3k(lis));
+
+  while ( c3n == u3a_meld(1, &sav_w) ) {
+  }
+
+  u3a_meld_stop();
+
+  if ( u3h(lis) != u3h(u3t(lis)) ) {
+    printf("*** meld full: shared\n");
+  }
+
+  u3z(lis);
+}
+
 /* _test_nvm_stack(): test the stack usage of the bytecode interpreter
 ** (growing in both directions: N and S)
 */
@@ -1630,7 +2018,7 @@ _test_nvm_stack()
   _test_nvm_stack_inner(mov, off);
 
   // south road
-  u3m_soft(100, &_test_nvm_stack_south, 0);
+  u3m_soft(100, 0, &_test_nvm_stack_south, 0);
 #endif
 }
 
@@ -1639,6 +2027,21 @@ _test_nvm_stack()
 int
 main(int argc, char* argv[])
 {
+#if (0 != U3_OS_LoomShift)
+  //  a shifted loom is 8GB, which may not fit the test machine
+  //
+  {
+    void* map_v = mmap(0, u3a_bytes, (PROT_READ | PROT_WRITE),
+                       (MAP_ANON | MAP_PRIVATE), -1, 0);
+
+    if ( MAP_FAILED == map_v ) {
+      fprintf(stderr, "test_noun: skipped, no room for the loom\n");
+      return 0;
+    }
+    munmap(map_v, u3a_bytes);
+  }
+#endif
+
    _setup();
 
   _test_noun_bits_set();
@@ -1652,6 +2055,12 @@ main(int argc, char* argv[])
   _test_cells();
   _test_cells_complex();
   _test_u3r_at();
+  _test_sand();
+  _test_slabs();
+  _test_walign();
+  _test_pack();
+  _test_meld();
+  _test_meld_full();
   _test_nvm_stack();
 
   fprintf(stderr, "test_noun: ok\n");
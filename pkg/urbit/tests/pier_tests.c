@@ -0,0 +1,510 @@
+//  the pier under test, statics and all; the test build links
+//  everything else but vere/pier.o
+//
+#include "../vere/pier.c"
+
+#include <fcntl.h>
+
+//  events in the log, enough for several replay batches
+//
+#define TEST_EVENTS      3500ULL
+
+static c3_c _dir_c[] = "/tmp/pier_test_XXXXXX";
+static c3_i _err_i = -1;
+
+/* _test_work: stand-in worker, at the far end of the pier's pipe.
+*/
+static struct {
+  u3_pier* pir_u;                       //  pier we work for
+  u3_moat  inn_u;                       //  requests from the pier
+  c3_d     sen_d;                       //  last event received
+  c3_d     ahe_d;                       //  most events read ahead
+  c3_w     wok_w;                       //  %work requests
+  c3_w     man_w;                       //  %many requests
+} _wok_u;
+
+/* _setup(): prepare for tests.
+*/
+static void
+_setup(void)
+{
+  u3m_init();
+  u3m_pave(c3y, c3n);
+
+  u3_Host.lup_u = uv_default_loop();
+  u3_Host.ops_u.tem = c3y;
+  u3_Host.ops_u.gro_w = 0;
+
+  if ( 0 == mkdtemp(_dir_c) ) {
+    fprintf(stderr, "pier: mkdtemp: %s\r\n", strerror(errno));
+    exit(1);
+  }
+}
+
+/* _test_fail(): fail the test.
+*/
+static void
+_test_fail(const c3_c* err_c)
+{
+  //  if quieted, speak up
+  //
+  if ( 0 <= _err_i ) {
+    fflush(stderr);
+    dup2(_err_i, 2);
+  }
+
+  fprintf(stderr, "*** pier: %s\r\n", err_c);
+  exit(1);
+}
+
+/* _test_bail(): pipe error.
+*/
+static void
+_test_bail(void* vod_p, const c3_c* err_c)
+{
+  _test_fail(err_c);
+}
+
+/* _test_job(): the job of event [evt_d], which names it.
+*/
+static u3_noun
+_test_job(c3_d evt_d)
+{
+  return u3nt(0, u3_nul, u3i_chubs(1, &evt_d));
+}
+
+/* _test_work_take(): check the log entry [mat] of event [evt_d].  RETAIN.
+*/
+static void
+_test_work_take(c3_d evt_d, u3_noun mat)
+{
+  u3_noun ent = u3ke_cue(u3k(mat));
+  u3_noun job = _test_job(evt_d);
+
+  if ( (c3n == u3du(ent)) || (c3n == u3r_sing(job, u3t(ent))) ) {
+    _test_fail("work: wrong event");
+  }
+
+  if ( evt_d != (1ULL + _wok_u.sen_d) ) {
+    _test_fail("work: out of order");
+  }
+
+  _wok_u.sen_d = evt_d;
+  u3z(job);
+  u3z(ent);
+}
+
+/* _test_work_poke(): the worker computes requests as they arrive.
+*/
+static void
+_test_work_poke(void* vod_p, u3_noun mat)
+{
+  u3_pier*       pir_u = _wok_u.pir_u;
+  u3_controller* god_u = pir_u->god_u;
+  u3_noun        jar   = u3ke_cue(mat);
+  u3_noun        p_jar, q_jar;
+
+  switch ( u3h(jar) ) {
+    default: _test_fail("work: bad request");
+
+    case c3__work: {
+      c3_d evt_d;
+
+      u3x_trel(jar, 0, &p_jar, &q_jar);
+      evt_d = u3r_chub(0, p_jar);
+
+      _test_work_take(evt_d, q_jar);
+      _wok_u.wok_w++;
+
+      _pier_work_poke(pir_u, u3ke_jam(u3nq(c3__done,
+                                           u3i_chubs(1, &evt_d),
+                                           0,
+                                           u3_nul)));
+      break;
+    }
+
+    case c3__many: {
+      c3_d    evt_d, i_d;
+      u3_noun lis, dun = u3_nul;
+
+      u3x_trel(jar, 0, &p_jar, &q_jar);
+      evt_d = u3r_chub(0, p_jar);
+
+      for ( i_d = evt_d, lis = q_jar; u3_nul != lis; i_d++, lis = u3t(lis) ) {
+        _test_work_take(i_d, u3h(lis));
+        dun = u3nc(u3nc(0, u3_nul), dun);
+      }
+
+      //  short of the run and look-ahead limits
+      //
+      if ( (evt_d == i_d) || ((i_d - evt_d) > PIER_PLAY_MANY) ) {
+        _test_fail("work: bad run");
+      }
+
+      if ( (god_u->sen_d - god_u->dun_d) > PIER_PLAY_AHEAD ) {
+        _test_fail("work: too far ahead");
+      }
+
+      _wok_u.ahe_d = c3_max(_wok_u.ahe_d,
+                            (pir_u->log_u->red_d - god_u->dun_d));
+      _wok_u.man_w++;
+
+      _pier_work_poke(pir_u, u3ke_jam(u3nt(c3__many,
+                                           u3i_chubs(1, &evt_d),
+                                           u3kb_flop(dun))));
+      break;
+    }
+  }
+
+  u3z(jar);
+}
+
+/* _test_pier(): a pier on the log in [log_c], with a fresh worker.
+*/
+static u3_pier*
+_test_pier(c3_c* log_c)
+{
+  u3_pier*       pir_u = c3_calloc(sizeof(*pir_u));
+  u3_disk*       log_u = c3_calloc(sizeof(*log_u));
+  u3_controller* god_u = c3_calloc(sizeof(*god_u));
+  c3_i           fid_i[2];
+
+  pir_u->sat_e = u3_psat_init;
+  pir_u->sav_u = c3_calloc(sizeof(u3_save));
+  pir_u->log_u = log_u;
+  pir_u->god_u = god_u;
+  log_u->pir_u = pir_u;
+  god_u->pir_u = pir_u;
+
+  uv_idle_init(u3L, &pir_u->idl_u);
+  pir_u->idl_u.data = pir_u;
+
+  //  the event log, as in _pier_disk_create()
+  //
+  if ( (0 == (log_u->db_u = u3_lmdb_init(log_c))) ||
+       (c3n == u3_lmdb_get_latest_event_number(log_u->db_u, &log_u->com_d)) )
+  {
+    _test_fail("log: init");
+  }
+
+  log_u->moc_d = log_u->com_d;
+  log_u->liv_o = c3y;
+  log_u->red_o = c3n;
+  log_u->gro_o = c3n;
+
+  uv_timer_init(u3L, &log_u->gro_u);
+  log_u->gro_u.data = pir_u;
+
+  //  the worker is us, over a socket pair, and has computed nothing
+  //
+  if ( 0 != socketpair(AF_UNIX, SOCK_STREAM, 0, fid_i) ) {
+    _test_fail(strerror(errno));
+  }
+
+  uv_pipe_init(u3L, &god_u->inn_u.pyp_u, 0);
+  uv_pipe_open(&god_u->inn_u.pyp_u, fid_i[0]);
+  god_u->inn_u.bal_f = _test_bail;
+  god_u->liv_o = c3y;
+
+  memset(&_wok_u, 0, sizeof(_wok_u));
+  _wok_u.pir_u = pir_u;
+
+  uv_pipe_init(u3L, &_wok_u.inn_u.pyp_u, 0);
+  uv_pipe_open(&_wok_u.inn_u.pyp_u, fid_i[1]);
+  _wok_u.inn_u.pok_f = _test_work_poke;
+  _wok_u.inn_u.bal_f = _test_bail;
+  u3_newt_read(&_wok_u.inn_u);
+
+  pir_u->gen_d = 1ULL + log_u->com_d;
+
+  return pir_u;
+}
+
+/* _test_pier_done(): close the pier's handles and log.
+*/
+static void
+_test_pier_done(u3_pier* pir_u)
+{
+  uv_close((uv_handle_t*)&pir_u->idl_u, 0);
+  uv_close((uv_handle_t*)&pir_u->log_u->gro_u, 0);
+  uv_close((uv_handle_t*)&pir_u->god_u->inn_u.pyp_u, 0);
+  uv_close((uv_handle_t*)&_wok_u.inn_u.pyp_u, 0);
+  uv_run(u3L, UV_RUN_NOWAIT);
+
+  u3_lmdb_shutdown(pir_u->log_u->db_u);
+}
+
+/* _test_tick(): keep the loop turning.
+*/
+static void
+_test_tick(uv_timer_t* tim_u)
+{
+}
+
+/* _test_run(): run the loop until [*val_d] reaches [tar_d].
+*/
+static void
+_test_run(const c3_c* cap_c, c3_d* val_d, c3_d tar_d)
+{
+  uv_timer_t tim_u;
+  c3_d       end_d;
+
+  uv_timer_init(u3L, &tim_u);
+  uv_timer_start(&tim_u, _test_tick, 100, 100);
+  end_d = uv_now(u3L) + 60000;
+
+  while ( *val_d < tar_d ) {
+    if ( uv_now(u3L) > end_d ) {
+      _test_fail(cap_c);
+    }
+    uv_run(u3L, UV_RUN_ONCE);
+  }
+
+  uv_close((uv_handle_t*)&tim_u, 0);
+  uv_run(u3L, UV_RUN_NOWAIT);
+}
+
+/* _test_log_read(): check a log entry read back in order.
+*/
+static c3_d _test_log_d;
+
+static c3_o
+_test_log_read(u3_pier* pir_u, c3_d evt_d, u3_noun mat)
+{
+  u3_noun ent = u3ke_cue(u3k(mat));
+  u3_noun job = _test_job(evt_d);
+  c3_o  ret_o = __( (evt_d == (1ULL + _test_log_d)) &&
+                    (c3y == u3du(ent)) &&
+                    (c3y == u3r_sing(job, u3t(ent))) );
+
+  _test_log_d = evt_d;
+  u3z(job);
+  u3z(ent);
+  return ret_o;
+}
+
+/* _test_log_done(): async read complete.
+*/
+static c3_d _test_log_len_d;
+static c3_o _test_log_suc_o;
+static c3_d _test_log_don_d;
+
+static void
+_test_log_done(c3_o suc_o, u3_pier* pir_u, c3_d evt_d, c3_d len_d)
+{
+  _test_log_suc_o = suc_o;
+  _test_log_len_d = len_d;
+  _test_log_don_d = 1;
+}
+
+/* _test_log_async(): async reads run in order, and stop at the log's end.
+*/
+static void
+_test_log_async(c3_c* log_c)
+{
+  u3_pier* pir_u = _test_pier(log_c);
+  c3_d     end_d = pir_u->log_u->com_d;
+
+  //  a whole batch, off the loop
+  //
+  _test_log_d = 0;
+  _test_log_don_d = 0;
+  u3_lmdb_read_events_async(pir_u, 1, PIER_PLAY_BATCH,
+                            _test_log_read, _test_log_done);
+  _test_run("read: batch", &_test_log_don_d, 1);
+
+  if (  (c3n == _test_log_suc_o)
+     || (PIER_PLAY_BATCH != _test_log_len_d)
+     || (PIER_PLAY_BATCH != _test_log_d) )
+  {
+    _test_fail("read: batch");
+  }
+
+  //  reads stop at the end of the log, and fail past it
+  //
+  _test_log_d = end_d - 5ULL;
+  _test_log_don_d = 0;
+  u3_lmdb_read_events_async(pir_u, end_d - 4ULL, 10,
+                            _test_log_read, _test_log_done);
+  _test_run("read: end", &_test_log_don_d, 1);
+
+  if (  (c3n == _test_log_suc_o)
+     || (5 != _test_log_len_d)
+     || (end_d != _test_log_d) )
+  {
+    _test_fail("read: end");
+  }
+
+  _test_log_don_d = 0;
+  u3_lmdb_read_events_async(pir_u, 1ULL + end_d, 10,
+                            _test_log_read, _test_log_done);
+  _test_run("read: past end", &_test_log_don_d, 1);
+
+  if ( (c3y == _test_log_suc_o) || (0 != _test_log_len_d) ) {
+    _test_fail("read: past end");
+  }
+
+  _test_pier_done(pir_u);
+  fprintf(stderr, "test_log_async: ok\n");
+}
+
+/* _test_play_commit(): computed events commit in order, in groups.
+*/
+static void
+_test_play_commit(c3_c* log_c)
+{
+  u3_pier*       pir_u = _test_pier(log_c);
+  u3_disk*       log_u = pir_u->log_u;
+  u3_controller* god_u = pir_u->god_u;
+  c3_d           i_d, cun_d, cev_d;
+
+  pir_u->sat_e = u3_psat_play;
+
+  //  by default, commits don't wait
+  //
+  for ( i_d = 1; i_d <= TEST_EVENTS; i_d++ ) {
+    u3_pier_discover(pir_u, 0, _test_job(i_d));
+  }
+
+  _test_run("play: release", &god_u->rel_d, TEST_EVENTS);
+
+  if (  (0 != pir_u->ext_u)
+     || (TEST_EVENTS != log_u->com_d)
+     || (TEST_EVENTS != log_u->cev_d)
+     || (TEST_EVENTS != _wok_u.wok_w) )
+  {
+    _test_fail("play: counters");
+  }
+
+  _test_log_d = 0;
+
+  if (  (c3n == u3_lmdb_read_events(pir_u, 1, TEST_EVENTS, _test_log_read))
+     || (TEST_EVENTS != _test_log_d) )
+  {
+    _test_fail("play: log");
+  }
+
+  //  with a group wait, computed events wait for the group to close
+  //
+  u3_Host.ops_u.gro_w = 3600000;
+  cun_d = log_u->cun_d;
+  cev_d = log_u->cev_d;
+
+  for ( i_d = 1; i_d <= PIER_PLAY_MANY; i_d++ ) {
+    u3_pier_discover(pir_u, 0, _test_job(TEST_EVENTS + i_d));
+  }
+
+  _test_run("group: compute", &god_u->dun_d, TEST_EVENTS + PIER_PLAY_MANY);
+
+  if (  (TEST_EVENTS != log_u->com_d)
+     || (TEST_EVENTS != log_u->moc_d)
+     || !uv_is_active((uv_handle_t*)&log_u->gro_u) )
+  {
+    _test_fail("group: committed early");
+  }
+
+  //  and then commit all at once, while a read shares the table
+  //
+  log_u->gro_o = c3y;
+  u3_pier_discover(pir_u, 0, _test_job(1ULL + TEST_EVENTS + PIER_PLAY_MANY));
+
+  _test_log_d = 0;
+  _test_log_don_d = 0;
+  u3_lmdb_read_events_async(pir_u, 1, TEST_EVENTS,
+                            _test_log_read, _test_log_done);
+
+  _test_run("group: commit", &log_u->com_d, TEST_EVENTS + PIER_PLAY_MANY);
+  _test_run("group: read", &_test_log_don_d, 1);
+
+  if (  ((1ULL + cun_d) != log_u->cun_d)
+     || ((PIER_PLAY_MANY + cev_d) != log_u->cev_d)
+     || (0 == log_u->cby_d)
+     || (log_u->cax_d > log_u->cat_d) )
+  {
+    _test_fail("group: not grouped");
+  }
+
+  if ( (c3n == _test_log_suc_o) || (TEST_EVENTS != _test_log_d) ) {
+    _test_fail("group: read");
+  }
+
+  u3_Host.ops_u.gro_w = 0;
+
+  _test_pier_done(pir_u);
+  fprintf(stderr, "test_play_commit: ok\n");
+}
+
+/* _test_pace(): replay reads ahead in batches, and computes in runs.
+*/
+static void
+_test_pace(c3_c* log_c)
+{
+  u3_pier*       pir_u = _test_pier(log_c);
+  u3_disk*       log_u = pir_u->log_u;
+  u3_controller* god_u = pir_u->god_u;
+  c3_d           end_d = log_u->com_d;
+
+  if ( TEST_EVENTS > end_d ) {
+    _test_fail("pace: log");
+  }
+
+  //  replay prints a dot for every event
+  //
+  fflush(stderr);
+  _err_i = dup(2);
+  dup2(open("/dev/null", O_WRONLY), 2);
+
+  _pier_pace(pir_u);
+  _test_run("pace", &god_u->dun_d, end_d);
+
+  fflush(stderr);
+  dup2(_err_i, 2);
+  close(_err_i);
+  _err_i = -1;
+
+  if (  (end_d != _wok_u.sen_d)
+     || (0 != _wok_u.wok_w)
+     || (_wok_u.man_w < (end_d / PIER_PLAY_MANY))
+     || (end_d != log_u->red_d) )
+  {
+    _test_fail("pace: counters");
+  }
+
+  //  read ahead, but not too far
+  //
+  if ( _wok_u.ahe_d >= ((1ULL + PIER_PLAY_QUEUE) * PIER_PLAY_BATCH) ) {
+    fprintf(stderr, "*** pier: pace: read ahead %" PRIu64 "\r\n",
+                    _wok_u.ahe_d);
+    exit(1);
+  }
+
+  _test_pier_done(pir_u);
+  fprintf(stderr, "test_pace: ok\n");
+}
+
+/* main(): run all test cases.
+*/
+int
+main(int argc, char* argv[])
+{
+  _setup();
+
+  _test_play_commit(_dir_c);
+  _test_log_async(_dir_c);
+  _test_pace(_dir_c);
+
+  //  clean up the log
+  //
+  {
+    c3_c cmd_c[8193];
+
+    snprintf(cmd_c, 8192, "rm -rf %s", _dir_c);
+    if ( 0 != system(cmd_c) ) {
+      fprintf(stderr, "pier: unable to remove %s\r\n", _dir_c);
+    }
+  }
+
+  fprintf(stderr, "test_pier: ok\n");
+
+  return 0;
+}
@@ -100,10 +100,11 @@ static c3_w sag_w;
   %+  each
     ::  %&: complete pill (either +brass or +solid)
     ::
-    ::  p: jammed pill
+    ::  p: jammed pill, or the pill itself if .r
     ::  q: optional %into ovum overriding that of .p
+    ::  r: .p has already been cued
     ::
-    [p=@ q=(unit ovum)]
+    [p=* q=(unit ovum) r=?]
   ::  %|: incomplete pill (+ivory)
   ::
   ::    XX not implemented, needs generation of
@@ -561,11 +562,20 @@ static u3_noun
 _boothack_pill(void)
 {
   u3_noun arv = u3_nul;
+  c3_o    cue_o = c3n;
   u3_noun pil;
 
   if ( 0 != u3_Host.ops_u.pil_c ) {
     u3l_log("boot: loading pill %s\r\n", u3_Host.ops_u.pil_c);
-    pil = u3m_file(u3_Host.ops_u.pil_c);
+
+    //  cue straight from the file, without loading it onto the loom
+    //
+    if ( u3_none == (pil = u3s_cue_file(u3_Host.ops_u.pil_c)) ) {
+      u3l_log("boot: failed: unable to parse pill\r\n");
+      exit(1);
+    }
+
+    cue_o = c3y;
   }
   else {
     c3_c url_c[2048];
@@ -590,7 +600,7 @@ _boothack_pill(void)
     arv = u3nc(u3_nul, u3_unix_initial_into_card(u3_Host.ops_u.arv_c));
   }
 
-  return u3nt(c3y, pil, arv);
+  return u3nq(c3y, pil, arv, cue_o);
 }
 
 /* _boothack_key(): parse a private key file or value
@@ -612,7 +622,7 @@ _boothack_key(u3_noun kef)
 
     //  +seed:able:jael: private key file
     //
-    u3_noun pro = u3m_soft(0, u3ke_cue, u3k(u3t(des)));
+    u3_noun pro = u3m_soft(0, 0, u3ke_cue, u3k(u3t(des)));
     if ( u3_blip != u3h(pro) ) {
       u3l_log("dawn: unable to cue private key\r\n");
       exit(1);
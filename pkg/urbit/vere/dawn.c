@@ -148,15 +148,13 @@ _dawn_get_jam(c3_c* url_c)
 
   curl_easy_cleanup(curl);
 
-  //  throw away the length from the octs
+  //  cue straight from the response buffer
   //
-  u3_noun octs = _dawn_buf_to_oct(buf_u);
-  u3_noun jammed = u3k(u3t(octs));
-  u3z(octs);
+  u3_noun pro = u3s_cue_bytes(buf_u.len, (const c3_y*)buf_u.base);
 
   c3_free(buf_u.base);
 
-  return u3ke_cue(jammed);
+  return pro;
 }
 
 /* _dawn_eth_rpc(): ethereum JSON RPC with request/response as +octs
@@ -21,6 +21,17 @@
 // We perform the very first metadata writes on the main thread because we
 // can't do anything until they persist.
 
+/* _u3_lmdb_events(): The EVENTS table handle, opened once at init.
+**
+** DBI handles belong to the environment, and opening one isn't safe while
+** other transactions may be opening them too, so we open EVENTS once on the
+** main thread and share the handle, through the environment's user context,
+** with every transaction on any thread.
+*/
+static MDB_dbi _u3_lmdb_events(MDB_env* env) {
+  return *(MDB_dbi*)mdb_env_get_userctx(env);
+}
+
 /* u3_lmdb_init(): Opens up a log environment
 **
 ** Precondition: log_path points to an already created directory
@@ -62,6 +73,39 @@ MDB_env* u3_lmdb_init(const char* log_path)
     return 0;
   }
 
+  // Opens the EVENTS table for the lifetime of the environment.
+  {
+    MDB_txn* transaction_u;
+    MDB_dbi* database_u = c3_malloc(sizeof(MDB_dbi));
+
+    ret_w = mdb_txn_begin(env, (MDB_txn *) NULL, 0, &transaction_u);
+    if (ret_w != 0) {
+      u3l_log("lmdb: txn_begin fail: %s\n", mdb_strerror(ret_w));
+      c3_free(database_u);
+      return 0;
+    }
+
+    ret_w = mdb_dbi_open(transaction_u,
+                         "EVENTS",
+                         MDB_CREATE | MDB_INTEGERKEY,
+                         database_u);
+    if (ret_w != 0) {
+      u3l_log("lmdb: dbi_open fail: %s\n", mdb_strerror(ret_w));
+      mdb_txn_abort(transaction_u);
+      c3_free(database_u);
+      return 0;
+    }
+
+    ret_w = mdb_txn_commit(transaction_u);
+    if (ret_w != 0) {
+      u3l_log("lmdb: failed to open event table: %s\n", mdb_strerror(ret_w));
+      c3_free(database_u);
+      return 0;
+    }
+
+    mdb_env_set_userctx(env, database_u);
+  }
+
   return env;
 }
 
@@ -69,7 +113,10 @@ MDB_env* u3_lmdb_init(const char* log_path)
 */
 void u3_lmdb_shutdown(MDB_env* env)
 {
+  void* database_u = mdb_env_get_userctx(env);
+
   mdb_env_close(env);
+  c3_free(database_u);
 }
 
 /* _perform_put_on_database_raw(): Writes a key/value pair to a specific
@@ -175,9 +222,8 @@ c3_o _perform_get_on_database_noun(MDB_txn* transaction_u,
     return c3y;
   }
 
-  // Take the bytes and cue them.
-  u3_atom raw_atom = u3i_bytes(value_val.mv_size, value_val.mv_data);
-  *noun = u3qe_cue(raw_atom);
+  // Cue the bytes in place.
+  *noun = u3s_cue_bytes(value_val.mv_size, value_val.mv_data);
   return c3y;
 }
 
@@ -191,13 +237,18 @@ struct u3_lmdb_write_request {
   c3_d event_count;
 
   // An array of serialized event datas. The array size is |event_count|. We
-  // perform the event serialization on the main thread so we can read the loom
-  // and write into a malloced structure for the worker thread.
+  // prepare these on the main thread, which can read the loom, either
+  // pointing into it or copying into a malloced structure for the worker
+  // thread.
   void** malloced_event_data;
 
   // An array of sizes of serialized event datas. We keep track of this for the
   // database write.
   size_t* malloced_event_data_size;
+
+  // Whether each event data was copied, rather than borrowed in place from
+  // the loom.
+  c3_o* malloced_event_data_owned;
 };
 
 /* u3_lmdb_build_write_request(): Allocates and builds a write request
@@ -211,16 +262,32 @@ u3_lmdb_build_write_request(u3_writ* event_u, c3_d count)
   request->event_count = count;
   request->malloced_event_data = c3_malloc(sizeof(void*) * count);
   request->malloced_event_data_size = c3_malloc(sizeof(size_t) * count);
+  request->malloced_event_data_owned = c3_malloc(sizeof(c3_o) * count);
 
   for (c3_d i = 0; i < count; ++i) {
     // Sanity check that the events in u3_writ are in order.
     c3_assert(event_u->evt_d == (request->first_event + i));
 
-    // Serialize the jammed event log entry into a malloced buffer we can send
-    // to the other thread.
     c3_w  siz_w  = u3r_met(3, event_u->mat);
-    c3_y* data_u = c3_calloc(siz_w);
-    u3r_bytes(0, siz_w, data_u, event_u->mat);
+    c3_y* data_u;
+
+#ifdef U3_OS_ENDIAN_little
+    // On little-endian machines an indirect atom's words are its bytes, so
+    // the worker thread can read the jammed entry in place. The writ holds
+    // it, unchanged, until it's released, which waits for this commit.
+    if ( c3y == u3a_is_pug(event_u->mat) ) {
+      data_u = (c3_y*)((u3a_atom*)u3a_to_ptr(event_u->mat))->buf_w;
+      request->malloced_event_data_owned[i] = c3n;
+    }
+    else
+#endif
+    {
+      // Serialize the jammed event log entry into a malloced buffer we can
+      // send to the other thread.
+      data_u = c3_calloc(siz_w);
+      u3r_bytes(0, siz_w, data_u, event_u->mat);
+      request->malloced_event_data_owned[i] = c3y;
+    }
 
     request->malloced_event_data[i] = data_u;
     request->malloced_event_data_size[i] = siz_w;
@@ -234,11 +301,15 @@ u3_lmdb_build_write_request(u3_writ* event_u, c3_d count)
 /* u3_lmdb_free_write_request(): Frees a write request
 */
 void u3_lmdb_free_write_request(struct u3_lmdb_write_request* request) {
-  for (c3_d i = 0; i < request->event_count; ++i)
-    c3_free(request->malloced_event_data[i]);
+  for (c3_d i = 0; i < request->event_count; ++i) {
+    if ( c3y == request->malloced_event_data_owned[i] ) {
+      c3_free(request->malloced_event_data[i]);
+    }
+  }
 
   c3_free(request->malloced_event_data);
   c3_free(request->malloced_event_data_size);
+  c3_free(request->malloced_event_data_owned);
   c3_free(request);
 }
 
@@ -281,17 +352,8 @@ static void _u3_lmdb_write_event_cb(uv_work_t* req) {
     return;
   }
 
-  // Opens the database as part of the transaction.
-  c3_w flags_w = MDB_CREATE | MDB_INTEGERKEY;
-  MDB_dbi database_u;
-  ret_w = mdb_dbi_open(transaction_u,
-                       "EVENTS",
-                       flags_w,
-                       &database_u);
-  if (0 != ret_w) {
-    fprintf(stderr, "lmdb: dbi_open fail: %s\n", mdb_strerror(ret_w));
-    return;
-  }
+  // Uses the long-lived handle to the EVENTS table.
+  MDB_dbi database_u = _u3_lmdb_events(data->environment);
 
   struct u3_lmdb_write_request* request = data->request;
   for (c3_d i = 0; i < request->event_count; ++i) {
@@ -408,17 +470,8 @@ c3_o u3_lmdb_read_events(u3_pier* pir_u,
     return c3n;
   }
 
-  // Opens the database as part of the transaction.
-  c3_w flags_w = MDB_CREATE | MDB_INTEGERKEY;
-  MDB_dbi database_u;
-  ret_w = mdb_dbi_open(transaction_u,
-                       "EVENTS",
-                       flags_w,
-                       &database_u);
-  if (0 != ret_w) {
-    u3l_log("lmdb: dbi_open fail: %s\n", mdb_strerror(ret_w));
-    return c3n;
-  }
+  // Uses the long-lived handle to the EVENTS table.
+  MDB_dbi database_u = _u3_lmdb_events(pir_u->log_u->db_u);
 
   // Creates a cursor to iterate over keys starting at first_event_d.
   MDB_cursor* cursor_u;
@@ -487,6 +540,186 @@ c3_o u3_lmdb_read_events(u3_pier* pir_u,
   return c3y;
 }
 
+/* _read_request_data: callback struct for u3_lmdb_read_events_async()
+*/
+struct _read_request_data {
+  // The database environment to read from.
+  MDB_env* environment;
+
+  // The pier that we're reading for.
+  u3_pier* pir_u;
+
+  // The event number of the first event, and how many to read.
+  c3_d first_event;
+  c3_d event_count;
+
+  // How many events were actually read, and their contents, copied out of
+  // the database on the worker thread. Converting them to nouns has to wait
+  // for the main thread.
+  c3_d loaded_count;
+  void** malloced_event_data;
+  size_t* malloced_event_data_size;
+
+  // Whether the read completed successfully.
+  c3_o success;
+
+  // Called on main loop thread for each event, and on completion.
+  c3_o (*on_event_read)(u3_pier*, c3_d, u3_noun);
+  void (*on_complete)(c3_o, u3_pier*, c3_d, c3_d);
+};
+
+/* _u3_lmdb_read_events_cb(): Implementation of u3_lmdb_read_events_async()
+**
+** This is always run on a libuv background worker thread; actual nouns cannot
+** be touched here.
+*/
+static void _u3_lmdb_read_events_cb(uv_work_t* req) {
+  struct _read_request_data* data = req->data;
+
+  // Creates the read transaction.
+  MDB_txn* transaction_u;
+  c3_w ret_w = mdb_txn_begin(data->environment,
+                             (MDB_txn *) NULL,
+                             MDB_RDONLY, /* flags */
+                             &transaction_u);
+  if (0 != ret_w) {
+    fprintf(stderr, "lmdb: txn_begin fail: %s\n", mdb_strerror(ret_w));
+    return;
+  }
+
+  // Uses the long-lived handle to the EVENTS table.
+  MDB_dbi database_u = _u3_lmdb_events(data->environment);
+
+  // Creates a cursor to iterate over keys starting at first_event.
+  MDB_cursor* cursor_u;
+  ret_w = mdb_cursor_open(transaction_u, database_u, &cursor_u);
+  if (0 != ret_w) {
+    fprintf(stderr, "lmdb: cursor_open fail: %s\n", mdb_strerror(ret_w));
+    mdb_txn_abort(transaction_u);
+    return;
+  }
+
+  MDB_val key;
+  MDB_val val;
+  key.mv_size = sizeof(c3_d);
+  key.mv_data = &data->first_event;
+
+  ret_w = mdb_cursor_get(cursor_u, &key, &val, MDB_SET_KEY);
+  if (0 != ret_w) {
+    fprintf(stderr, "lmdb: could not find initial event %" PRIu64 ": %s\r\n",
+            data->first_event, mdb_strerror(ret_w));
+    mdb_cursor_close(cursor_u);
+    mdb_txn_abort(transaction_u);
+    return;
+  }
+
+  // Copy out up to event_count events, iterating forward across the cursor.
+  while ( (ret_w != MDB_NOTFOUND) &&
+          (data->loaded_count < data->event_count) )
+  {
+    c3_d current_id = data->first_event + data->loaded_count;
+    if ( (key.mv_size != sizeof(c3_d)) ||
+         (*(c3_d*)key.mv_data != current_id) )
+    {
+      fprintf(stderr, "lmdb: missing event in database. Expected %" PRIu64
+              "\r\n", current_id);
+      break;
+    }
+
+    void* data_u = c3_malloc(val.mv_size);
+    memcpy(data_u, val.mv_data, val.mv_size);
+
+    data->malloced_event_data[data->loaded_count] = data_u;
+    data->malloced_event_data_size[data->loaded_count] = val.mv_size;
+    data->loaded_count++;
+
+    ret_w = mdb_cursor_get(cursor_u, &key, &val, MDB_NEXT);
+    if (ret_w != 0 && ret_w != MDB_NOTFOUND) {
+      fprintf(stderr, "lmdb: error while loading events: %s\r\n",
+              mdb_strerror(ret_w));
+      break;
+    }
+  }
+
+  mdb_cursor_close(cursor_u);
+  mdb_txn_abort(transaction_u);
+
+  data->success = c3y;
+}
+
+/* _u3_lmdb_read_events_after_cb(): Implementation of
+** u3_lmdb_read_events_async()
+**
+** This is always run on the main loop thread after the worker thread event
+** completes.
+*/
+static void _u3_lmdb_read_events_after_cb(uv_work_t* req, int status) {
+  struct _read_request_data* data = req->data;
+  c3_d i;
+
+  for (i = 0; (c3y == data->success) && (i < data->loaded_count); ++i) {
+    u3_noun mat = u3i_bytes(data->malloced_event_data_size[i],
+                            data->malloced_event_data[i]);
+
+    if (data->on_event_read(data->pir_u, data->first_event + i, mat) == c3n) {
+      u3l_log("lmdb: aborting replay due to error.\r\n");
+      data->success = c3n;
+    }
+
+    u3z(mat);
+  }
+
+  data->on_complete(data->success,
+                    data->pir_u,
+                    data->first_event,
+                    i);
+
+  for (i = 0; i < data->loaded_count; ++i) {
+    c3_free(data->malloced_event_data[i]);
+  }
+
+  c3_free(data->malloced_event_data);
+  c3_free(data->malloced_event_data_size);
+  c3_free(data);
+  c3_free(req);
+}
+
+/* u3_lmdb_read_events_async(): Asynchronously reads events from the database.
+**
+** Reads back up to |len_d| events starting with |first_event_d| on a worker
+** thread, copying them out of the database. Then, on the main loop thread,
+** passes each to |on_event_read|, stopping if it returns c3n, and finally
+** calls |on_complete| with the number of events passed.
+*/
+void u3_lmdb_read_events_async(u3_pier* pir_u,
+                               c3_d first_event_d,
+                               c3_d len_d,
+                               c3_o(*on_event_read)(u3_pier* pir_u, c3_d id,
+                                                    u3_noun mat),
+                               void (*on_complete)(c3_o, u3_pier*, c3_d, c3_d))
+{
+  // Structure to pass to the worker thread.
+  struct _read_request_data* data = c3_calloc(sizeof(struct _read_request_data));
+  data->environment = pir_u->log_u->db_u;
+  data->pir_u = pir_u;
+  data->first_event = first_event_d;
+  data->event_count = len_d;
+  data->malloced_event_data = c3_malloc(sizeof(void*) * len_d);
+  data->malloced_event_data_size = c3_malloc(sizeof(size_t) * len_d);
+  data->success = c3n;
+  data->on_event_read = on_event_read;
+  data->on_complete = on_complete;
+
+  // Queue asynchronous work to happen on the other thread.
+  uv_work_t* req = c3_malloc(sizeof(uv_work_t));
+  req->data = data;
+
+  uv_queue_work(uv_default_loop(),
+                req,
+                _u3_lmdb_read_events_cb,
+                _u3_lmdb_read_events_after_cb);
+}
+
 /* u3_lmdb_get_latest_event_number(): Gets last event id persisted
 **
 ** Reads the last key in order from the EVENTS table as the latest event
@@ -505,17 +738,8 @@ c3_o u3_lmdb_get_latest_event_number(MDB_env* environment, c3_d* event_number)
     return c3n;
   }
 
-  // Opens the database as part of the transaction.
-  c3_w flags_w = MDB_CREATE | MDB_INTEGERKEY;
-  MDB_dbi database_u;
-  ret_w = mdb_dbi_open(transaction_u,
-                       "EVENTS",
-                       flags_w,
-                       &database_u);
-  if (0 != ret_w) {
-    u3l_log("lmdb: dbi_open fail: %s\n", mdb_strerror(ret_w));
-    return c3n;
-  }
+  // Uses the long-lived handle to the EVENTS table.
+  MDB_dbi database_u = _u3_lmdb_events(environment);
 
   // Creates a cursor to point to the last event
   MDB_cursor* cursor_u;
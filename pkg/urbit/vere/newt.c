@@ -8,6 +8,10 @@
 **
 **  the implementation is relatively inefficient and could
 **  lose a few copies, mallocs, etc.
+**
+**  between daemon and worker, messages may instead travel
+**  through a ring in shared memory (u3_ring), copied once
+**  on each side.
 */
 #include <stdio.h>
 #include <stdlib.h>
@@ -27,10 +31,16 @@
 #include <ncurses/curses.h>
 #include <termios.h>
 #include <ncurses/term.h>
+#include <sys/mman.h>
 
 #include "all.h"
 #include "vere/vere.h"
 
+#if defined(U3_OS_linux)
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#endif
+
 /* _newt_gain_meat(): add a block to an existing message
 */
 static void
@@ -346,20 +356,20 @@ u3_newt_encode(u3_atom mat, c3_w* len_w)
   return buf_y;
 }
 
-/* u3_newt_write(): write atom to stream; free atom.
+/* _newt_write_buf(): write a frame to stream; free frame.
 */
-void
-u3_newt_write(u3_mojo* moj_u,
-              u3_atom  mat,
-              void*    vod_p)
+static void
+_newt_write_buf(u3_mojo* moj_u,
+                c3_y*    buf_y,
+                c3_w     len_w,
+                void*    vod_p)
 {
   u3_write_t* req_u = c3_malloc(sizeof(*req_u));
-  c3_w        len_w;
-  c3_y*       buf_y = u3_newt_encode(mat, &len_w);
   uv_buf_t    buf_u;
   c3_i        err_i;
 
   req_u->moj_u = moj_u;
+  req_u->vod_p = vod_p;
   req_u->buf_y = buf_y;
   buf_u = uv_buf_init((c3_c*)buf_y, len_w);
 
@@ -371,3 +381,670 @@ u3_newt_write(u3_mojo* moj_u,
     moj_u->bal_f(moj_u, uv_strerror(err_i));
   }
 }
+
+/* u3_newt_write(): write atom to stream; free atom.
+*/
+void
+u3_newt_write(u3_mojo* moj_u,
+              u3_atom  mat,
+              void*    vod_p)
+{
+  c3_w  len_w;
+  c3_y* buf_y = u3_newt_encode(mat, &len_w);
+
+  _newt_write_buf(moj_u, buf_y, len_w, vod_p);
+}
+
+/* u3_jamb: growable buffer, for jamming a noun into a frame.
+*/
+typedef struct _u3_jamb {
+  c3_y* buf_y;
+  c3_d  len_d;
+  c3_d  cap_d;
+} u3_jamb;
+
+/* _newt_jam_y: staging buffer for jams.
+*/
+static c3_y _newt_jam_y[1 << 16];
+
+/* _newt_jam_cb(): append jammed bytes to a frame.
+*/
+static c3_o
+_newt_jam_cb(void* ptr_v, c3_w len_w, c3_y* buf_y)
+{
+  u3_jamb* jam_u = ptr_v;
+
+  if ( (jam_u->len_d + len_w) > jam_u->cap_d ) {
+    while ( (jam_u->len_d + len_w) > jam_u->cap_d ) {
+      jam_u->cap_d <<= 1;
+    }
+
+    jam_u->buf_y = c3_realloc(jam_u->buf_y, jam_u->cap_d);
+  }
+
+  memcpy(jam_u->buf_y + jam_u->len_d, buf_y, len_w);
+  jam_u->len_d += len_w;
+
+  return c3y;
+}
+
+/* _newt_jam(): jam [som] into a fresh buffer, after [pre_w] bytes
+**              of space for a header; free noun.
+**
+**   the jam goes straight from the noun to the buffer,
+**   never materializing as an atom.
+*/
+static c3_y*
+_newt_jam(u3_noun som, c3_w pre_w, c3_d* len_d)
+{
+  u3_jamb     jam_u;
+  c3_d        bit_d;
+
+  jam_u.cap_d = pre_w + 4096;
+  jam_u.len_d = pre_w;
+  jam_u.buf_y = c3_malloc(jam_u.cap_d);
+
+  u3s_jam_flow(som, sizeof(_newt_jam_y), _newt_jam_y,
+               _newt_jam_cb, &jam_u, &bit_d);
+  u3z(som);
+
+  *len_d = jam_u.len_d - pre_w;
+  return jam_u.buf_y;
+}
+
+/* u3_newt_jam(): jam noun to stream; free noun.
+*/
+void
+u3_newt_jam(u3_mojo* moj_u,
+            u3_noun  som,
+            void*    vod_p)
+{
+  c3_d  met_d;
+  c3_y* buf_y = _newt_jam(som, 8, &met_d);
+
+  //  XX frames are limited to c3_w
+  //
+  c3_assert( met_d <= (0xffffffffULL - 8) );
+
+  //  write header; c3_d is futureproofing
+  //
+  buf_y[0] = ((met_d >> 0) & 0xff);
+  buf_y[1] = ((met_d >> 8) & 0xff);
+  buf_y[2] = ((met_d >> 16) & 0xff);
+  buf_y[3] = ((met_d >> 24) & 0xff);
+  buf_y[4] = buf_y[5] = buf_y[6] = buf_y[7] = 0;
+
+  _newt_write_buf(moj_u, buf_y, (c3_w)(8 + met_d), vod_p);
+}
+
+/* u3_rung: ring control block, at the head of the shared mapping.
+**
+**   positions are monotonic byte counts.  the writer owns [hed_d],
+**   the reader [tal_d]; each on its own cache line.
+*/
+typedef struct _u3_rung {
+  c3_d hed_d;                               //  bytes published
+  c3_y hep_y[56];
+  c3_d tal_d;                               //  bytes released
+  c3_y tap_y[56];
+  c3_w wan_w;                               //  writer awaiting space
+  c3_w pad_w;
+  c3_d siz_d;                               //  record capacity
+} u3_rung;
+
+/* u3_rack: write awaiting space in a ring.
+*/
+typedef struct _u3_rack {
+  struct _u3_rack* nex_u;
+  c3_d             len_d;
+  c3_d             off_d;
+  c3_y             hun_y[0];
+} u3_rack;
+
+//  records are [len typ] headers followed by a payload, 16-byte aligned
+//
+#define _newt_ring_head   4096ULL
+#define _newt_ring_whole  0ULL              //  complete message
+#define _newt_ring_more   1ULL              //  fragment, more follow
+#define _newt_ring_last   2ULL              //  final fragment
+#define _newt_ring_skip   3ULL              //  pad to end of ring
+
+/* _newt_ring_size(): record size for [len_d] bytes of payload.
+*/
+static c3_d
+_newt_ring_size(c3_d len_d)
+{
+  return (16ULL + len_d + 15ULL) & ~15ULL;
+}
+
+/* _newt_ring_room(): find space for a [len_d]-byte payload,
+**                    skipping the end of the ring if need be.
+*/
+static c3_y*
+_newt_ring_room(u3_ring* rin_u, c3_d len_d)
+{
+  c3_d siz_d = rin_u->siz_d;
+  c3_d tal_d = __atomic_load_n(&rin_u->rug_u->tal_d, __ATOMIC_ACQUIRE);
+  c3_d pos_d = rin_u->pos_d & (siz_d - 1ULL);
+  c3_d end_d = siz_d - pos_d;
+  c3_d ned_d = _newt_ring_size(len_d);
+
+  if ( end_d < ned_d ) {
+    ned_d += end_d;
+  }
+
+  if ( (siz_d - (rin_u->pos_d - tal_d)) < ned_d ) {
+    return 0;
+  }
+
+  if ( end_d < _newt_ring_size(len_d) ) {
+    c3_d* hed_d = (c3_d*)(rin_u->dat_y + pos_d);
+
+    hed_d[0] = 0;
+    hed_d[1] = _newt_ring_skip;
+    rin_u->pos_d += end_d;
+    pos_d = 0;
+  }
+
+  return rin_u->dat_y + pos_d;
+}
+
+/* _newt_ring_put(): write a record header, advancing the local head.
+*/
+static void
+_newt_ring_put(u3_ring* rin_u, c3_y* buf_y, c3_d typ_d, c3_d len_d)
+{
+  c3_d* hed_d = (c3_d*)buf_y;
+
+  hed_d[0] = len_d;
+  hed_d[1] = typ_d;
+  rin_u->pos_d += _newt_ring_size(len_d);
+}
+
+/* _newt_ring_ping(): signal an eventfd.
+*/
+static void
+_newt_ring_ping(u3_ring* rin_u, c3_i fid_i)
+{
+  c3_d one_d = 1ULL;
+
+  if ( (sizeof(one_d) != write(fid_i, &one_d, sizeof(one_d))) &&
+       (EAGAIN != errno) )
+  {
+    rin_u->bal_f(rin_u->vod_p, strerror(errno));
+  }
+}
+
+/* _newt_ring_pong(): reset an eventfd.
+*/
+static void
+_newt_ring_pong(u3_ring* rin_u, c3_i fid_i)
+{
+  c3_d val_d;
+
+  if ( (sizeof(val_d) != read(fid_i, &val_d, sizeof(val_d))) &&
+       (EAGAIN != errno) )
+  {
+    rin_u->bal_f(rin_u->vod_p, strerror(errno));
+  }
+}
+
+/* _newt_ring_publish(): make written records visible, and wake the reader.
+*/
+static void
+_newt_ring_publish(u3_ring* rin_u)
+{
+  __atomic_store_n(&rin_u->rug_u->hed_d, rin_u->pos_d, __ATOMIC_RELEASE);
+  _newt_ring_ping(rin_u, rin_u->dat_i);
+}
+
+/* _newt_ring_send(): move pending writes into the ring, in fragments
+**                    as needed; produces c3y if any remain.
+*/
+static c3_o
+_newt_ring_send(u3_ring* rin_u)
+{
+  u3_rack* rac_u;
+  c3_o     pus_o = c3n;
+
+  while ( (rac_u = rin_u->ext_u) ) {
+    c3_d  len_d = c3_min(rin_u->max_d, rac_u->len_d - rac_u->off_d);
+    c3_y* buf_y = _newt_ring_room(rin_u, len_d);
+    c3_d  typ_d;
+
+    if ( !buf_y ) {
+      break;
+    }
+
+    if ( (rac_u->off_d + len_d) < rac_u->len_d ) {
+      typ_d = _newt_ring_more;
+    }
+    else {
+      typ_d = ( 0 == rac_u->off_d ) ? _newt_ring_whole : _newt_ring_last;
+    }
+
+    memcpy(buf_y + 16, rac_u->hun_y + rac_u->off_d, len_d);
+    _newt_ring_put(rin_u, buf_y, typ_d, len_d);
+    rac_u->off_d += len_d;
+    pus_o = c3y;
+
+    if ( rac_u->off_d == rac_u->len_d ) {
+      rin_u->ext_u = rac_u->nex_u;
+
+      if ( !rin_u->ext_u ) {
+        rin_u->ent_u = 0;
+      }
+
+      c3_free(rac_u);
+    }
+  }
+
+  if ( c3y == pus_o ) {
+    _newt_ring_publish(rin_u);
+  }
+
+  return ( 0 == rin_u->ext_u ) ? c3n : c3y;
+}
+
+static void
+_newt_ring_drain(u3_ring* rin_u);
+
+/* _newt_ring_space_cb(): reader released space.
+*/
+static void
+_newt_ring_space_cb(uv_poll_t* pol_u, c3_i sas_i, c3_i evt_i)
+{
+  u3_ring* rin_u = (u3_ring*)pol_u;
+
+  if ( 0 != sas_i ) {
+    rin_u->bal_f(rin_u->vod_p, uv_strerror(sas_i));
+    return;
+  }
+
+  _newt_ring_pong(rin_u, rin_u->spa_i);
+  _newt_ring_drain(rin_u);
+}
+
+/* _newt_ring_drain(): send pending writes, waiting for space if need be.
+*/
+static void
+_newt_ring_drain(u3_ring* rin_u)
+{
+  c3_o ask_o = c3n;
+
+  while ( c3y == _newt_ring_send(rin_u) ) {
+    //  still no space, even though we've asked to be woken
+    //
+    if ( c3y == ask_o ) {
+      if ( c3n == rin_u->wan_o ) {
+        rin_u->wan_o = c3y;
+        uv_poll_start(&rin_u->pol_u, UV_READABLE, _newt_ring_space_cb);
+      }
+      return;
+    }
+
+    //  ask for a wakeup, then try again, in case the reader
+    //  released space before it saw the request
+    //
+    __atomic_store_n(&rin_u->rug_u->wan_w, 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    ask_o = c3y;
+  }
+
+  if ( c3y == rin_u->wan_o ) {
+    rin_u->wan_o = c3n;
+    uv_poll_stop(&rin_u->pol_u);
+  }
+}
+
+/* _newt_ring_release(): release records read, waking the writer
+**                       if it's waiting for space.
+*/
+static void
+_newt_ring_release(u3_ring* rin_u)
+{
+  u3_rung* rug_u = rin_u->rug_u;
+
+  __atomic_store_n(&rug_u->tal_d, rin_u->pos_d, __ATOMIC_RELEASE);
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+  if ( __atomic_load_n(&rug_u->wan_w, __ATOMIC_RELAXED) &&
+       __atomic_exchange_n(&rug_u->wan_w, 0, __ATOMIC_ACQ_REL) )
+  {
+    _newt_ring_ping(rin_u, rin_u->spa_i);
+  }
+}
+
+/* _newt_ring_take(): read published records, poking complete messages.
+*/
+static void
+_newt_ring_take(u3_ring* rin_u)
+{
+  c3_d hed_d = __atomic_load_n(&rin_u->rug_u->hed_d, __ATOMIC_ACQUIRE);
+  c3_d siz_d = rin_u->siz_d;
+
+  while ( rin_u->pos_d < hed_d ) {
+    c3_d    pos_d = rin_u->pos_d & (siz_d - 1ULL);
+    c3_y*   buf_y = rin_u->dat_y + pos_d;
+    c3_d    len_d = ((c3_d*)buf_y)[0];
+    c3_d    typ_d = ((c3_d*)buf_y)[1];
+    u3_noun mat   = u3_none;
+
+    switch ( typ_d ) {
+      default: {
+        rin_u->bal_f(rin_u->vod_p, "bad ring record");
+        return;
+      }
+
+      case _newt_ring_skip: {
+        rin_u->pos_d += siz_d - pos_d;
+        continue;
+      }
+
+      //  copy the payload straight into an atom
+      //
+      case _newt_ring_whole: {
+        c3_assert( !rin_u->fra_y );
+        mat = u3i_bytes((c3_w)len_d, buf_y + 16);
+      } break;
+
+      //  large messages are reassembled off to the side
+      //
+      case _newt_ring_more:
+      case _newt_ring_last: {
+        rin_u->fra_y = c3_realloc(rin_u->fra_y, rin_u->fra_d + len_d);
+        memcpy(rin_u->fra_y + rin_u->fra_d, buf_y + 16, len_d);
+        rin_u->fra_d += len_d;
+
+        if ( _newt_ring_last == typ_d ) {
+          mat = u3i_bytes((c3_w)rin_u->fra_d, rin_u->fra_y);
+          c3_free(rin_u->fra_y);
+          rin_u->fra_y = 0;
+          rin_u->fra_d = 0;
+        }
+      } break;
+    }
+
+    rin_u->pos_d += _newt_ring_size(len_d);
+    _newt_ring_release(rin_u);
+
+    if ( u3_none != mat ) {
+      rin_u->pok_f(rin_u->vod_p, mat);
+    }
+  }
+}
+
+/* _newt_ring_data_cb(): writer published records.
+*/
+static void
+_newt_ring_data_cb(uv_poll_t* pol_u, c3_i sas_i, c3_i evt_i)
+{
+  u3_ring* rin_u = (u3_ring*)pol_u;
+
+  if ( 0 != sas_i ) {
+    uv_poll_stop(pol_u);
+    rin_u->bal_f(rin_u->vod_p, uv_strerror(sas_i));
+    return;
+  }
+
+  //  reset the wakeup before looking, so that none are lost
+  //
+  _newt_ring_pong(rin_u, rin_u->dat_i);
+  _newt_ring_take(rin_u);
+}
+
+/* u3_newt_ring_make(): create a shared ring of [siz_d] bytes,
+**                      producing its three descriptors.
+*/
+c3_o
+u3_newt_ring_make(c3_d siz_d, c3_i* fid_i)
+{
+#if defined(U3_OS_linux) && defined(SYS_memfd_create)
+  c3_assert( (siz_d >= 65536ULL) && !(siz_d & (siz_d - 1ULL)) );
+
+  //  descriptors are close-on-exec; the worker gets them by dup
+  //
+  fid_i[0] = syscall(SYS_memfd_create, "newt", 1 /* MFD_CLOEXEC */);
+
+  if ( 0 > fid_i[0] ) {
+    u3l_log("newt: memfd: %s\r\n", strerror(errno));
+    return c3n;
+  }
+
+  if ( 0 > ftruncate(fid_i[0], _newt_ring_head + siz_d) ) {
+    u3l_log("newt: ring: %s\r\n", strerror(errno));
+    close(fid_i[0]);
+    return c3n;
+  }
+
+  {
+    u3_rung* rug_u = mmap(0, sizeof(u3_rung), PROT_READ | PROT_WRITE,
+                          MAP_SHARED, fid_i[0], 0);
+
+    if ( MAP_FAILED == rug_u ) {
+      u3l_log("newt: ring: %s\r\n", strerror(errno));
+      close(fid_i[0]);
+      return c3n;
+    }
+
+    rug_u->siz_d = siz_d;
+    munmap(rug_u, sizeof(u3_rung));
+  }
+
+  fid_i[1] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  fid_i[2] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+  if ( (0 > fid_i[1]) || (0 > fid_i[2]) ) {
+    u3l_log("newt: eventfd: %s\r\n", strerror(errno));
+    close(fid_i[0]);
+
+    if ( 0 <= fid_i[1] ) {
+      close(fid_i[1]);
+    }
+    if ( 0 <= fid_i[2] ) {
+      close(fid_i[2]);
+    }
+    return c3n;
+  }
+
+  return c3y;
+#else
+  return c3n;
+#endif
+}
+
+/* u3_newt_ring_open(): map a shared ring from its descriptors,
+**                      to write to it if [wri_o], else to read.
+**
+**   the ring takes the eventfds; the memfd stays with the caller.
+*/
+u3_ring*
+u3_newt_ring_open(uv_loop_t* lup_u, c3_i* fid_i, c3_o wri_o)
+{
+  u3_ring* rin_u = c3_calloc(sizeof(*rin_u));
+  u3_rung* rug_u;
+  c3_d     siz_d;
+  c3_i     err_i;
+
+  rug_u = mmap(0, sizeof(u3_rung), PROT_READ, MAP_SHARED, fid_i[0], 0);
+
+  if ( MAP_FAILED == rug_u ) {
+    u3l_log("newt: ring: %s\r\n", strerror(errno));
+    c3_free(rin_u);
+    return 0;
+  }
+
+  siz_d = rug_u->siz_d;
+  munmap(rug_u, sizeof(u3_rung));
+
+  rug_u = mmap(0, _newt_ring_head + siz_d, PROT_READ | PROT_WRITE,
+               MAP_SHARED, fid_i[0], 0);
+
+  if ( MAP_FAILED == rug_u ) {
+    u3l_log("newt: ring: %s\r\n", strerror(errno));
+    c3_free(rin_u);
+    return 0;
+  }
+
+  rin_u->rug_u = rug_u;
+  rin_u->dat_y = (c3_y*)rug_u + _newt_ring_head;
+  rin_u->siz_d = siz_d;
+  rin_u->max_d = siz_d >> 2;
+  rin_u->dat_i = fid_i[1];
+  rin_u->spa_i = fid_i[2];
+  rin_u->wan_o = c3n;
+
+  //  the writer watches for space, the reader for records
+  //
+  if ( c3y == wri_o ) {
+    rin_u->pos_d = __atomic_load_n(&rug_u->hed_d, __ATOMIC_ACQUIRE);
+    err_i = uv_poll_init(lup_u, &rin_u->pol_u, rin_u->spa_i);
+  }
+  else {
+    rin_u->pos_d = __atomic_load_n(&rug_u->tal_d, __ATOMIC_ACQUIRE);
+    err_i = uv_poll_init(lup_u, &rin_u->pol_u, rin_u->dat_i);
+  }
+
+  if ( 0 != err_i ) {
+    u3l_log("newt: ring: %s\r\n", uv_strerror(err_i));
+    munmap(rug_u, _newt_ring_head + siz_d);
+    c3_free(rin_u);
+    return 0;
+  }
+
+  return rin_u;
+}
+
+/* u3_newt_ring_read(): activate reading on shared ring.
+*/
+void
+u3_newt_ring_read(u3_ring* rin_u)
+{
+  c3_i err_i = uv_poll_start(&rin_u->pol_u, UV_READABLE, _newt_ring_data_cb);
+
+  if ( 0 != err_i ) {
+    rin_u->bal_f(rin_u->vod_p, uv_strerror(err_i));
+    return;
+  }
+
+  //  records may have been published before we started watching
+  //
+  _newt_ring_take(rin_u);
+}
+
+/* _newt_ring_queue(): queue a write until there's space in the ring.
+*/
+static void
+_newt_ring_queue(u3_ring* rin_u, u3_rack* rac_u)
+{
+  rac_u->nex_u = 0;
+  rac_u->off_d = 0;
+
+  if ( !rin_u->ent_u ) {
+    rin_u->ext_u = rin_u->ent_u = rac_u;
+  }
+  else {
+    rin_u->ent_u->nex_u = rac_u;
+    rin_u->ent_u = rac_u;
+  }
+
+  _newt_ring_drain(rin_u);
+}
+
+/* u3_newt_ring_write(): write atom to shared ring; free atom.
+*/
+void
+u3_newt_ring_write(u3_ring* rin_u, u3_atom mat)
+{
+  c3_d  len_d = u3r_met(3, mat);
+  c3_y* buf_y;
+
+  //  copy the atom straight into the ring, if it fits
+  //
+  if ( !rin_u->ext_u &&
+       (len_d <= rin_u->max_d) &&
+       (buf_y = _newt_ring_room(rin_u, len_d)) )
+  {
+    u3r_bytes(0, (c3_w)len_d, buf_y + 16, mat);
+    _newt_ring_put(rin_u, buf_y, _newt_ring_whole, len_d);
+    _newt_ring_publish(rin_u);
+  }
+  //  otherwise, queue a copy until there's space
+  //
+  else {
+    u3_rack* rac_u = c3_malloc(sizeof(*rac_u) + len_d);
+
+    rac_u->len_d = len_d;
+    u3r_bytes(0, (c3_w)len_d, rac_u->hun_y, mat);
+    _newt_ring_queue(rin_u, rac_u);
+  }
+
+  u3z(mat);
+}
+
+/* u3_newt_ring_jam(): jam noun to shared ring; free noun.
+*/
+void
+u3_newt_ring_jam(u3_ring* rin_u, u3_noun som)
+{
+  c3_d     len_d;
+  u3_rack* rac_u = (u3_rack*)_newt_jam(som, sizeof(u3_rack), &len_d);
+  c3_y*    buf_y;
+
+  //  copy the jam into the ring, if it fits
+  //
+  if ( !rin_u->ext_u &&
+       (len_d <= rin_u->max_d) &&
+       (buf_y = _newt_ring_room(rin_u, len_d)) )
+  {
+    memcpy(buf_y + 16, rac_u->hun_y, len_d);
+    _newt_ring_put(rin_u, buf_y, _newt_ring_whole, len_d);
+    _newt_ring_publish(rin_u);
+    c3_free(rac_u);
+  }
+  //  otherwise, queue it as is
+  //
+  else {
+    rac_u->len_d = len_d;
+    _newt_ring_queue(rin_u, rac_u);
+  }
+}
+
+/* _newt_ring_close_cb(): free shared ring, once its watcher is closed.
+*/
+static void
+_newt_ring_close_cb(uv_handle_t* han_u)
+{
+  u3_ring* rin_u = (u3_ring*)han_u;
+
+  close(rin_u->dat_i);
+  close(rin_u->spa_i);
+  c3_free(rin_u);
+}
+
+/* u3_newt_ring_close(): unmap shared ring, dropping pending writes.
+*/
+void
+u3_newt_ring_close(u3_ring* rin_u)
+{
+  u3_rack* rac_u = rin_u->ext_u;
+
+  while ( rac_u ) {
+    u3_rack* nex_u = rac_u->nex_u;
+    c3_free(rac_u);
+    rac_u = nex_u;
+  }
+
+  rin_u->ext_u = rin_u->ent_u = 0;
+
+  if ( rin_u->fra_y ) {
+    c3_free(rin_u->fra_y);
+    rin_u->fra_y = 0;
+  }
+
+  munmap(rin_u->rug_u, _newt_ring_head + rin_u->siz_d);
+  rin_u->rug_u = 0;
+  rin_u->dat_y = 0;
+
+  uv_close((uv_handle_t*)&rin_u->pol_u, _newt_ring_close_cb);
+}
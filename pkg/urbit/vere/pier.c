@@ -71,6 +71,25 @@ static void _pier_boot_set_ship(u3_pier* pir_u, u3_noun who, u3_noun fak);
 static void _pier_exit_done(u3_pier* pir_u);
 static void _pier_inject(u3_pier* pir_u, c3_c* pax_c);
 static void _pier_loop_resume(u3_pier* pir_u);
+static void _pier_db_load_ahead(u3_pier* pir_u);
+static void _pier_writ_link(u3_pier* pir_u, u3_writ* wit_u);
+
+//  replay: events read from the log at a time, batches kept queued,
+//  events sent to the worker ahead of its completions, and events
+//  sent to the worker in one %many
+//
+#define PIER_PLAY_BATCH  1000ULL
+#define PIER_PLAY_QUEUE  3ULL
+#define PIER_PLAY_AHEAD  64ULL
+#define PIER_PLAY_MANY   16ULL
+
+//  group commit: most bytes of events committed at once
+//
+#define PIER_COMMIT_BYTES  (1ULL << 26)
+
+//  shared ring size, each way (-W)
+//
+#define PIER_RING_SIZE   (1ULL << 24)
 
 /* _pier_db_bail(): bail from disk i/o.
 */
@@ -80,11 +99,37 @@ _pier_db_bail(void* vod_p, const c3_c* err_c)
   u3l_log("disk error: %s\r\n", err_c);
 }
 
+/* _pier_db_stat(): print event log commit metrics.
+*/
+static void
+_pier_db_stat(u3_pier* pir_u, FILE* fil_u)
+{
+  u3_disk* log_u = pir_u->log_u;
+
+  if ( 0 == log_u->cun_d ) {
+    return;
+  }
+
+  fprintf(fil_u, "  event log: %" PRIu64 " commits, %" PRIu64 " events"
+                 " (%.1f per fsync), %" PRIu64 " bytes\r\n",
+                 log_u->cun_d,
+                 log_u->cev_d,
+                 (double)log_u->cev_d / (double)log_u->cun_d,
+                 log_u->cby_d);
+  fprintf(fil_u, "  event log: commit latency %.3fms mean, %.3fms max\r\n",
+                 ((double)log_u->cat_d / (double)log_u->cun_d) / 1e6,
+                 (double)log_u->cax_d / 1e6);
+}
+
 /* u3_pier_db_shutdown(): close the log.
 */
 void
 u3_pier_db_shutdown(u3_pier* pir_u)
 {
+  if ( (c3y == u3_Host.ops_u.veb) && pir_u->log_u ) {
+    _pier_db_stat(pir_u, stderr);
+  }
+
   u3_lmdb_shutdown(pir_u->log_u->db_u);
 }
 
@@ -120,6 +165,17 @@ _pier_db_commit_complete(c3_o success,
     log_u->com_d += event_count_d;
   }
 
+  /* track latency and events per commit (and so per fsync)
+  */
+  {
+    c3_d lat_d = uv_hrtime() - log_u->cos_d;
+
+    log_u->cun_d += 1;
+    log_u->cev_d += event_count_d;
+    log_u->cat_d += lat_d;
+    log_u->cax_d  = c3_max(log_u->cax_d, lat_d);
+  }
+
   _pier_loop_resume(pir_u);
 }
 
@@ -145,6 +201,7 @@ _pier_db_commit_request(u3_pier* pir_u,
   /* put it in the database
   */
   {
+    log_u->cos_d = uv_hrtime();
     u3_lmdb_write_event(log_u->db_u,
                         pir_u,
                         request_u,
@@ -159,6 +216,56 @@ _pier_db_commit_request(u3_pier* pir_u,
   }
 }
 
+/* _pier_db_commit_due(): group commit wait expired.
+*/
+static void
+_pier_db_commit_due(uv_timer_t* tim_u)
+{
+  u3_pier* pir_u = tim_u->data;
+
+  pir_u->log_u->gro_o = c3y;
+  _pier_loop_resume(pir_u);
+}
+
+/* _pier_db_commit_group(): of [max_d] computed events starting at [wit_u],
+**                          how many to commit now (or 0, to wait for more).
+**
+**   a group closes at PIER_COMMIT_BYTES, or when it's waited (-b) ms;
+**   by default it doesn't wait, and groups only form while a commit
+**   is in progress.
+*/
+static c3_d
+_pier_db_commit_group(u3_pier* pir_u, u3_writ* wit_u, c3_d max_d)
+{
+  u3_disk* log_u = pir_u->log_u;
+  c3_w     gro_w = u3_Host.ops_u.gro_w;
+  c3_d     len_d = 0;
+  c3_d     byt_d = 0;
+
+  while ( (len_d < max_d) && (byt_d < PIER_COMMIT_BYTES) ) {
+    byt_d += u3r_met(3, wit_u->mat);
+    wit_u  = wit_u->nex_u;
+    len_d++;
+  }
+
+  if ( (0 == gro_w) ||
+       (c3y == log_u->gro_o) ||
+       (byt_d >= PIER_COMMIT_BYTES) ||
+       (u3_psat_play != pir_u->sat_e) )
+  {
+    log_u->gro_o = c3n;
+    uv_timer_stop(&log_u->gro_u);
+
+    log_u->cby_d += byt_d;
+    return len_d;
+  }
+
+  if ( !uv_is_active((uv_handle_t*)&log_u->gro_u) ) {
+    uv_timer_start(&log_u->gro_u, _pier_db_commit_due, gro_w, 0);
+  }
+
+  return 0;
+}
 
 static void
 _pier_db_write_header(u3_pier* pir_u,
@@ -202,63 +309,94 @@ _pier_db_on_commit_loaded(u3_pier* pir_u,
                           c3_d id,
                           u3_noun mat)
 {
-  // Need to grab references to the nouns above.
+  //  the entry is sent to the worker as it is; we don't decode it,
+  //  as only the worker needs its contents (and checks them)
+  //
   u3_writ* wit_u = c3_calloc(sizeof(u3_writ));
   wit_u->pir_u = pir_u;
   wit_u->evt_d = id;
   wit_u->mat = u3k(mat);
 
-  // Parse the expected mug_l and job out of mat.
-  u3_noun entry = u3ke_cue(u3k(mat));
-  u3_noun mug, job;
-  if ( (c3y != u3du(entry)) ||
-       (c3n == u3r_cell(entry, &mug, &job)) ||
-       (c3n == u3ud(mug)) ||
-       (1 < u3r_met(5, mug)) ) {
-    u3l_log("pier: load: event %" PRIu64 " malformed.\r\n", id);
+  // Insert at queue front since we're loading events in order
+  if ( pir_u->ent_u &&
+       (wit_u->evt_d != (1ULL + pir_u->ent_u->evt_d)) )
+  {
+    fprintf(stderr, "pier: load: commit: event gap: %" PRIx64 ", %"
+            PRIx64 "\r\n",
+            wit_u->evt_d,
+            pir_u->ent_u->evt_d);
+    _pier_db_bail(0, "pier: load: comit: event gap");
     return c3n;
   }
 
-  wit_u->mug_l = u3r_word(0, mug);
-  wit_u->job = u3k(job);
+  _pier_writ_link(pir_u, wit_u);
 
-  u3z(entry);
+  return c3y;
+}
 
-  // Insert at queue front since we're loading events in order
-  if ( !pir_u->ent_u ) {
-    c3_assert(!pir_u->ext_u);
+/* _pier_db_load_complete(): replay batch loaded.
+*/
+static void
+_pier_db_load_complete(c3_o     success,
+                       u3_pier* pir_u,
+                       c3_d     lav_d,
+                       c3_d     len_d)
+{
+  u3_disk* log_u = pir_u->log_u;
 
-    pir_u->ent_u = pir_u->ext_u = wit_u;
-  }
-  else {
-    if ( wit_u->evt_d != (1ULL + pir_u->ent_u->evt_d) ) {
-      fprintf(stderr, "pier: load: commit: event gap: %" PRIx64 ", %"
-              PRIx64 "\r\n",
-              wit_u->evt_d,
-              pir_u->ent_u->evt_d);
-      _pier_db_bail(0, "pier: load: comit: event gap");
-      return c3n;
-    }
+  c3_assert( c3y == log_u->red_o );
+  log_u->red_o = c3n;
 
-    pir_u->ent_u->nex_u = wit_u;
-    pir_u->ent_u = wit_u;
+  if ( (c3n == success) || (0 == len_d) ) {
+    u3l_log("Failed to read event log for replay. Exiting...");
+    u3_pier_bail();
+    return;
   }
 
-  return c3y;
+  c3_assert( lav_d == (1ULL + log_u->red_d) );
+  log_u->red_d += len_d;
+
+  _pier_db_load_ahead(pir_u);
+  _pier_loop_resume(pir_u);
 }
 
-/* _pier_db_load_commit(): load len_d commits >= lav_d; enqueue for replay
+/* _pier_db_load_commits(): load len_d commits >= lav_d; enqueue for replay
+**
+**   read on a worker thread, while the worker computes events
+**   already enqueued.
 */
 static void
 _pier_db_load_commits(u3_pier* pir_u,
                       c3_d     lav_d,
                       c3_d     len_d)
 {
-  if ( c3n == u3_lmdb_read_events(pir_u, lav_d, len_d,
-                                  _pier_db_on_commit_loaded) )
+  u3_disk* log_u = pir_u->log_u;
+
+  c3_assert( c3n == log_u->red_o );
+  c3_assert( lav_d == (1ULL + log_u->red_d) );
+  log_u->red_o = c3y;
+
+  u3_lmdb_read_events_async(pir_u, lav_d, len_d,
+                            _pier_db_on_commit_loaded,
+                            _pier_db_load_complete);
+}
+
+/* _pier_db_load_ahead(): in replay, keep a few batches of events queued.
+*/
+static void
+_pier_db_load_ahead(u3_pier* pir_u)
+{
+  u3_disk*       log_u = pir_u->log_u;
+  u3_controller* god_u = pir_u->god_u;
+
+  if ( (c3n == log_u->red_o) &&
+       (log_u->red_d < log_u->com_d) &&
+       ((log_u->red_d - god_u->dun_d) < (PIER_PLAY_QUEUE * PIER_PLAY_BATCH)) )
   {
-    u3l_log("Failed to read event log for replay. Exiting...");
-    u3_pier_bail();
+    _pier_db_load_commits(pir_u,
+                          (1ULL + log_u->red_d),
+                          c3_min(PIER_PLAY_BATCH,
+                                 (log_u->com_d - log_u->red_d)));
   }
 }
 
@@ -296,6 +434,11 @@ _pier_disk_create(u3_pier* pir_u)
   pir_u->log_u = log_u;
   log_u->pir_u = pir_u;
   log_u->liv_o = c3n;
+  log_u->red_o = c3n;
+  log_u->gro_o = c3n;
+
+  uv_timer_init(u3L, &log_u->gro_u);
+  log_u->gro_u.data = pir_u;
 
   /* create/load pier, urbit directory, log directory.
   */
@@ -372,6 +515,59 @@ _pier_disk_create(u3_pier* pir_u)
   return c3y;
 }
 
+/* _pier_writ_index(): (re)build the queue index, with room for [len_d].
+*/
+static void
+_pier_writ_index(u3_pier* pir_u, c3_d len_d)
+{
+  u3_writ* wit_u;
+  c3_d     dex_d = ( pir_u->dex_d ) ? pir_u->dex_d : 256ULL;
+
+  while ( dex_d < len_d ) {
+    dex_d <<= 1;
+  }
+
+  c3_free(pir_u->dex_u);
+  pir_u->dex_u = c3_calloc(dex_d * sizeof(u3_writ*));
+  pir_u->dex_d = dex_d;
+
+  for ( wit_u = pir_u->ext_u; wit_u; wit_u = wit_u->nex_u ) {
+    pir_u->dex_u[wit_u->evt_d & (dex_d - 1ULL)] = wit_u;
+  }
+}
+
+/* _pier_writ_link(): enqueue writ.
+**
+**   the queue holds consecutive events, indexed by event number
+**   in a ring that grows with the queue.
+*/
+static void
+_pier_writ_link(u3_pier* pir_u, u3_writ* wit_u)
+{
+  c3_d len_d = 1ULL;
+
+  if ( !pir_u->ent_u ) {
+    c3_assert(!pir_u->ext_u);
+
+    pir_u->ent_u = pir_u->ext_u = wit_u;
+  }
+  else {
+    c3_assert( wit_u->evt_d == (1ULL + pir_u->ent_u->evt_d) );
+
+    pir_u->ent_u->nex_u = wit_u;
+    pir_u->ent_u = wit_u;
+
+    len_d += wit_u->evt_d - pir_u->ext_u->evt_d;
+  }
+
+  if ( len_d > pir_u->dex_d ) {
+    _pier_writ_index(pir_u, len_d);
+  }
+  else {
+    pir_u->dex_u[wit_u->evt_d & (pir_u->dex_d - 1ULL)] = wit_u;
+  }
+}
+
 /* _pier_writ_insert(): insert raw event.
 */
 static void
@@ -389,15 +585,7 @@ _pier_writ_insert(u3_pier* pir_u,
 
   wit_u->job = job;
 
-  if ( !pir_u->ent_u ) {
-    c3_assert(!pir_u->ext_u);
-
-    pir_u->ent_u = pir_u->ext_u = wit_u;
-  }
-  else {
-    pir_u->ent_u->nex_u = wit_u;
-    pir_u->ent_u = wit_u;
-  }
+  _pier_writ_link(pir_u, wit_u);
 }
 
 /* _pier_writ_insert_ovum(): insert raw ovum - for boot sequence.
@@ -422,16 +610,18 @@ static u3_writ*
 _pier_writ_find(u3_pier* pir_u,
                 c3_d     evt_d)
 {
-  u3_writ* wit_u;
+  if ( !pir_u->ext_u ||
+       (evt_d < pir_u->ext_u->evt_d) ||
+       (evt_d > pir_u->ent_u->evt_d) )
+  {
+    return 0;
+  }
+  else {
+    u3_writ* wit_u = pir_u->dex_u[evt_d & (pir_u->dex_d - 1ULL)];
 
-  /* very unlikely to be O(n) and n is small
-  */
-  for ( wit_u = pir_u->ext_u; wit_u; wit_u = wit_u->nex_u ) {
-    if ( evt_d == wit_u->evt_d ) {
-      return wit_u;
-    }
+    c3_assert( evt_d == wit_u->evt_d );
+    return wit_u;
   }
-  return 0;
 }
 
 /* _pier_writ_unlink(): unlink writ from queue.
@@ -445,6 +635,9 @@ _pier_writ_unlink(u3_writ* wit_u)
   fprintf(stderr, "pier: (%" PRIu64 "): delete\r\n", wit_u->evt_d);
 #endif
 
+  c3_assert( wit_u == pir_u->ext_u );
+
+  pir_u->dex_u[wit_u->evt_d & (pir_u->dex_d - 1ULL)] = 0;
   pir_u->ext_u = wit_u->nex_u;
 
   if ( wit_u == pir_u->ent_u ) {
@@ -476,6 +669,19 @@ _pier_work_bail(void*       vod_p,
   fprintf(stderr, "\rpier: work error: %s\r\n", err_c);
 }
 
+/* _pier_work_write(): write atom to worker, by ring or pipe; free atom.
+*/
+static void
+_pier_work_write(u3_controller* god_u, u3_atom mat, void* vod_p)
+{
+  if ( god_u->shi_u ) {
+    u3_newt_ring_write(god_u->shi_u, mat);
+  }
+  else {
+    u3_newt_write(&god_u->inn_u, mat, vod_p);
+  }
+}
+
 /* _pier_work_boot(): prepare for boot.
 */
 static void
@@ -496,7 +702,7 @@ _pier_work_boot(u3_pier* pir_u, c3_o sav_o)
 
   u3_noun msg = u3nc(c3__boot, len);
   u3_atom mat = u3ke_jam(msg);
-  u3_newt_write(&god_u->inn_u, mat, 0);
+  _pier_work_write(god_u, mat, 0);
 }
 
 /* _pier_work_shutdown(): stop the worker process.
@@ -506,7 +712,7 @@ _pier_work_shutdown(u3_pier* pir_u)
 {
   u3_controller* god_u = pir_u->god_u;
 
-  u3_newt_write(&god_u->inn_u, u3ke_jam(u3nc(c3__exit, 0)), 0);
+  _pier_work_write(god_u, u3ke_jam(u3nc(c3__exit, 0)), 0);
 }
 
 /* _pier_work_build(): build atomic action.
@@ -538,7 +744,33 @@ _pier_work_send(u3_writ* wit_u)
                               u3i_chubs(1, &wit_u->evt_d),
                               u3k(wit_u->mat)));
 
-  u3_newt_write(&god_u->inn_u, msg, wit_u);
+  _pier_work_write(god_u, msg, wit_u);
+}
+
+/* _pier_work_send_many(): send [len_d] consecutive writs to worker at once.
+*/
+static void
+_pier_work_send_many(u3_writ* wit_u, c3_d len_d)
+{
+  u3_pier* pir_u = wit_u->pir_u;
+  u3_controller* god_u = pir_u->god_u;
+  u3_writ* nex_u = wit_u;
+  u3_noun  mat = u3_nul;
+  c3_d     i_d;
+
+  for ( i_d = 0; i_d < len_d; i_d++ ) {
+    c3_assert(0 != nex_u->mat);
+    mat = u3nc(u3k(nex_u->mat), mat);
+    nex_u = nex_u->nex_u;
+  }
+
+  {
+    u3_noun msg = u3ke_jam(u3nt(c3__many,
+                                u3i_chubs(1, &wit_u->evt_d),
+                                u3kb_flop(mat)));
+
+    _pier_work_write(god_u, msg, wit_u);
+  }
 }
 
 /* _pier_work_save(): tell worker to save checkpoint.
@@ -555,9 +787,10 @@ _pier_work_save(u3_pier* pir_u)
 
   {
     u3_noun mat = u3ke_jam(u3nc(c3__save, u3i_chubs(1, &god_u->dun_d)));
-    u3_newt_write(&god_u->inn_u, mat, 0);
+    _pier_work_write(god_u, mat, 0);
 
-    //  XX wait on some report of success before updating?
+    //  the worker reports %save once the snapshot is on disk
+    //  (see _pier_work_saved()), but events needn't wait for that
     //
     sav_u->dun_d = sav_u->req_d;
   }
@@ -569,6 +802,20 @@ _pier_work_save(u3_pier* pir_u)
   }
 }
 
+/* _pier_work_saved(): worker reported a snapshot written to disk.
+*/
+static void
+_pier_work_saved(u3_pier* pir_u, c3_d evt_d)
+{
+  u3_save* sav_u = pir_u->sav_u;
+
+  sav_u->dur_d = evt_d;
+
+  if ( u3C.wag_w & u3o_verbose ) {
+    u3l_log("pier: snapshot saved at %" PRIu64 "\r\n", evt_d);
+  }
+}
+
 /* _pier_work_release(): apply side effects.
 */
 static void
@@ -581,19 +828,9 @@ _pier_work_release(u3_writ* wit_u)
   if ( u3_psat_pace == pir_u->sat_e ) {
     fputc('.', stderr);
 
-    //  enqueue another batch of events for replay
+    //  enqueue another batch of events for replay, if needed
     //
-    {
-      u3_disk* log_u = pir_u->log_u;
-
-      //  XX requires that writs be unlinked before effects are released
-      //
-      if ( (0 == pir_u->ent_u) &&
-           (wit_u->evt_d < log_u->com_d) )
-      {
-        _pier_db_load_commits(pir_u, (1ULL + god_u->dun_d), 1000ULL);
-      }
-    }
+    _pier_db_load_ahead(pir_u);
   }
   else {
 #ifdef VERBOSE_EVENTS
@@ -708,6 +945,20 @@ _pier_work_complete(u3_writ* wit_u,
   wit_u->act = act;
 
   _pier_work_spin_stop(wit_u);
+
+  //  take a snapshot requested while events were in flight,
+  //  if they've already been committed (as in replay)
+  //
+  {
+    u3_save* sav_u = pir_u->sav_u;
+
+    if ( (sav_u->req_d > sav_u->dun_d) &&
+         (god_u->dun_d == sav_u->req_d) &&
+         (pir_u->log_u->com_d >= sav_u->req_d) )
+    {
+      _pier_work_save(pir_u);
+    }
+  }
 }
 
 /* _pier_work_replace(): worker reported replacement.
@@ -723,7 +974,12 @@ _pier_work_replace(u3_writ* wit_u,
   fprintf(stderr, "pier: (%" PRIu64 "): compute: replace\r\n", wit_u->evt_d);
 #endif
 
-  c3_assert(god_u->sen_d == wit_u->evt_d);
+  //  later events have been sent on, computed without this one
+  //
+  if ( god_u->sen_d != wit_u->evt_d ) {
+    u3l_log("pier: replay: event %" PRIu64 " failed\r\n", wit_u->evt_d);
+    u3_pier_bail();
+  }
 
   //  something has gone very wrong, we should probably stop now
   //
@@ -772,6 +1028,51 @@ _pier_work_compute(u3_writ* wit_u)
   _pier_work_spin_start(wit_u);
 }
 
+/* _pier_work_compute_many(): in replay, dispatch a run of writs at once.
+**
+**   produces c3n if we should wait for the worker to catch up.
+*/
+static c3_o
+_pier_work_compute_many(u3_writ* wit_u)
+{
+  u3_pier* pir_u = wit_u->pir_u;
+  u3_controller* god_u = pir_u->god_u;
+  c3_d     max_d = c3_min(PIER_PLAY_MANY,
+                          PIER_PLAY_AHEAD - (god_u->sen_d - god_u->dun_d));
+  u3_writ* nex_u = wit_u;
+  c3_d     len_d = 0;
+
+  while ( nex_u && (len_d < max_d) ) {
+    c3_assert(nex_u->evt_d == (1 + god_u->sen_d + len_d));
+    len_d++;
+    nex_u = nex_u->nex_u;
+  }
+
+  //  don't dribble out short runs while the worker is busy
+  //
+  if ( (len_d < PIER_PLAY_MANY) &&
+       (0 != nex_u) &&
+       (god_u->sen_d != god_u->dun_d) )
+  {
+    return c3n;
+  }
+
+#ifdef VERBOSE_EVENTS
+  fprintf(stderr, "pier: (%" PRIu64 "-%" PRIu64 "): compute: request\r\n",
+                  wit_u->evt_d, (wit_u->evt_d + len_d - 1ULL));
+#endif
+
+  _pier_work_send_many(wit_u, len_d);
+  god_u->sen_d += len_d;
+
+  for ( nex_u = wit_u; len_d--; nex_u = nex_u->nex_u ) {
+    nex_u->mug_l = god_u->mug_l;
+    _pier_work_spin_start(nex_u);
+  }
+
+  return c3y;
+}
+
 /* _pier_work_play(): with active worker, create or load log.
 */
 static void
@@ -863,6 +1164,14 @@ _pier_work_exit(uv_process_t* req_u,
                   sas_i, sig_i);
   uv_close((uv_handle_t*) req_u, 0);
 
+  //  a restarted worker gets fresh rings
+  //
+  if ( god_u->shi_u ) {
+    u3_newt_ring_close(god_u->shi_u);
+    u3_newt_ring_close(god_u->sho_u);
+    god_u->shi_u = god_u->sho_u = 0;
+  }
+
   //  XX dispose
   //
   pir_u->god_u = 0;
@@ -947,6 +1256,40 @@ _pier_work_poke(void*   vod_p,
       break;
     }
 
+    case c3__many: {
+      u3_noun dun;
+
+      if ( (c3n == u3r_trel(jar, 0, &p_jar, &q_jar)) ||
+           (c3n == u3ud(p_jar)) ||
+           (u3r_met(6, p_jar) != 1) )
+      {
+        goto error;
+      }
+      else {
+        c3_d evt_d = u3r_chub(0, p_jar);
+
+        for ( dun = q_jar; u3_nul != dun; dun = u3t(dun), evt_d++ ) {
+          u3_noun  i_dun = u3h(dun);
+          u3_writ* wit_u = _pier_writ_find(pir_u, evt_d);
+
+          if ( (c3n == u3du(i_dun)) ||
+               (c3n == u3ud(u3h(i_dun))) ||
+               (u3r_met(5, u3h(i_dun)) > 1) )
+          {
+            goto error;
+          }
+
+          if ( !wit_u ) {
+            u3l_log("poke: no writ: %" PRIu64 "\r\n", evt_d);
+            goto error;
+          }
+
+          _pier_work_complete(wit_u, u3r_word(0, u3h(i_dun)), u3k(u3t(i_dun)));
+        }
+      }
+      break;
+    }
+
     case c3__done: {
       if ( (c3n == u3r_qual(jar, 0, &p_jar, &q_jar, &r_jar)) ||
            (c3n == u3ud(p_jar)) ||
@@ -988,6 +1331,29 @@ _pier_work_poke(void*   vod_p,
       break;
     }
 
+    case c3__save: {
+      if ( (c3n == u3r_cell(jar, 0, &p_jar)) ||
+           (c3n == u3ud(p_jar)) ||
+           (u3r_met(6, p_jar) != 1) )
+      {
+        goto error;
+      }
+      else {
+        c3_d evt_d = u3r_chub(0, p_jar);
+
+        //  we can't have asked for a snapshot we haven't computed
+        //
+        if ( evt_d > pir_u->sav_u->dun_d ) {
+          u3l_log("poke: save: %" PRIu64 " ahead of request %" PRIu64 "\r\n",
+                  evt_d, pir_u->sav_u->dun_d);
+          goto error;
+        }
+
+        _pier_work_saved(pir_u, evt_d);
+      }
+      break;
+    }
+
     case  c3__slog: {
       if ( (c3n == u3r_qual(jar, 0, &p_jar, &q_jar, &r_jar)) ||
            (c3n == u3ud(p_jar)) ||
@@ -1039,12 +1405,13 @@ _pier_work_create(u3_pier* pir_u)
   /* spawn new process and connect to it
   */
   {
-    c3_c* arg_c[6];
+    c3_c* arg_c[7];
     c3_c* bin_c = u3_Host.wrk_c;
     c3_c* pax_c = pir_u->pax_c;
     c3_c  key_c[256];
     c3_c  wag_c[11];
     c3_c  hap_c[11];
+    c3_i  fid_i[6];
     c3_i  err_i;
 
     sprintf(key_c, "%" PRIx64 ":%" PRIx64 ":%" PRIx64 ":%" PRIx64 "",
@@ -1061,7 +1428,8 @@ _pier_work_create(u3_pier* pir_u)
     arg_c[2] = key_c;                   //  disk key
     arg_c[3] = wag_c;                   //  runtime config
     arg_c[4] = hap_c;                   //  hash table size
-    arg_c[5] = 0;
+    arg_c[5] = 0;                       //  shared rings, if any
+    arg_c[6] = 0;
 
     uv_pipe_init(u3L, &god_u->inn_u.pyp_u, 0);
     uv_pipe_init(u3L, &god_u->out_u.pyp_u, 0);
@@ -1078,11 +1446,64 @@ _pier_work_create(u3_pier* pir_u)
     god_u->ops_u.stdio = god_u->cod_u;
     god_u->ops_u.stdio_count = 3;
 
+    //  pass shared rings as [FD 3-5] (to worker) and [FD 6-8] (from),
+    //  keeping the pipes for liveness
+    //
+    if ( c3y == u3_Host.ops_u.shm ) {
+      c3_o inn_o = u3_newt_ring_make(PIER_RING_SIZE, fid_i);
+      c3_o out_o = ( c3y == inn_o )
+                   ? u3_newt_ring_make(PIER_RING_SIZE, fid_i + 3)
+                   : c3n;
+
+      if ( (c3y == inn_o) && (c3y == out_o) ) {
+        c3_w i_w;
+
+        for ( i_w = 0; i_w < 6; i_w++ ) {
+          god_u->cod_u[3 + i_w].flags = UV_INHERIT_FD;
+          god_u->cod_u[3 + i_w].data.fd = fid_i[i_w];
+        }
+
+        god_u->ops_u.stdio_count = 9;
+        arg_c[5] = "ring";
+
+        god_u->shi_u = u3_newt_ring_open(u3L, fid_i, c3y);
+        god_u->sho_u = u3_newt_ring_open(u3L, fid_i + 3, c3n);
+        c3_assert( god_u->shi_u && god_u->sho_u );
+      }
+      else {
+        //  don't leak the input ring into the fallback
+        //
+        if ( c3y == inn_o ) {
+          close(fid_i[0]);
+          close(fid_i[1]);
+          close(fid_i[2]);
+        }
+
+        u3l_log("pier: shared memory unavailable, using pipes\r\n");
+      }
+    }
+
     god_u->ops_u.exit_cb = _pier_work_exit;
     god_u->ops_u.file = arg_c[0];
     god_u->ops_u.args = arg_c;
 
-    if ( (err_i = uv_spawn(u3L, &god_u->cub_u, &god_u->ops_u)) ) {
+    err_i = uv_spawn(u3L, &god_u->cub_u, &god_u->ops_u);
+
+    //  the worker has its own copies of the shared memory, and both
+    //  sides keep their mappings; only the eventfds are still ours
+    //
+    if ( god_u->shi_u ) {
+      close(fid_i[0]);
+      close(fid_i[3]);
+
+      if ( err_i ) {
+        u3_newt_ring_close(god_u->shi_u);
+        u3_newt_ring_close(god_u->sho_u);
+        god_u->shi_u = god_u->sho_u = 0;
+      }
+    }
+
+    if ( err_i ) {
       fprintf(stderr, "spawn: %s: %s\r\n", arg_c[0], uv_strerror(err_i));
 
       return 0;
@@ -1099,6 +1520,17 @@ _pier_work_create(u3_pier* pir_u)
     god_u->inn_u.bal_f = _pier_work_bail;
 
     u3_newt_read(&god_u->out_u);
+
+    if ( god_u->shi_u ) {
+      god_u->shi_u->vod_p = pir_u;
+      god_u->shi_u->bal_f = _pier_work_bail;
+
+      god_u->sho_u->vod_p = pir_u;
+      god_u->sho_u->pok_f = _pier_work_poke;
+      god_u->sho_u->bal_f = _pier_work_bail;
+
+      u3_newt_ring_read(god_u->sho_u);
+    }
   }
   return god_u;
 }
@@ -1369,15 +1801,17 @@ _pier_boot_vent(u3_boot* bot_u)
 
     c3_assert( c3y == u3du(bot_u->pil) );
 
-    if ( c3y == u3h(bot_u->pil) ) {
-      u3x_trel(bot_u->pil, 0, &pil_p, &pil_q);
+    //  a complete pill from a file has already been cued (.r)
+    //
+    u3x_qual(bot_u->pil, 0, &pil_p, &pil_q, &pil_r);
+
+    if ( (c3y == u3h(bot_u->pil)) && (c3y == pil_r) ) {
+      pro = u3nc(0, u3k(pil_p));
     }
     else {
-      u3x_qual(bot_u->pil, 0, &pil_p, &pil_q, &pil_r);
+      pro = u3m_soft(0, 0, u3ke_cue, u3k(pil_p));
     }
 
-    pro = u3m_soft(0, u3ke_cue, u3k(pil_p));
-
     if ( 0 != u3h(pro) ) {
       fprintf(stderr, "boot: failed: unable to parse pill\r\n");
       exit(1);
@@ -1550,6 +1984,24 @@ _pier_boot_complete(u3_pier* pir_u)
   }
 }
 
+/* _pier_pace(): replay committed events, from the worker's next.
+*/
+static void
+_pier_pace(u3_pier* pir_u)
+{
+  u3_disk*       log_u = pir_u->log_u;
+  u3_controller* god_u = pir_u->god_u;
+
+  c3_assert( god_u->dun_d < log_u->com_d );
+
+  pir_u->sat_e = u3_psat_pace;
+
+  //  begin queuing batches of committed events
+  //
+  log_u->red_d = god_u->dun_d;
+  _pier_db_load_ahead(pir_u);
+}
+
 /* _pier_boot_ready():
 */
 static void
@@ -1612,10 +2064,6 @@ _pier_boot_ready(u3_pier* pir_u)
     //
     _pier_db_read_header(pir_u);
 
-    //  begin queuing batches of committed events
-    //
-    _pier_db_load_commits(pir_u, (1ULL + god_u->dun_d), 1000ULL);
-
     if ( 0 == god_u->dun_d ) {
       fprintf(stderr, "pier: replaying events 1 through %" PRIu64 "\r\n",
                       log_u->com_d);
@@ -1635,7 +2083,7 @@ _pier_boot_ready(u3_pier* pir_u)
                       log_u->com_d);
     }
 
-    pir_u->sat_e = u3_psat_pace;
+    _pier_pace(pir_u);
   }
   //  resume
   //
@@ -1657,7 +2105,22 @@ _pier_boot_ready(u3_pier* pir_u)
   }
 }
 
+/* _pier_work_ahead(): events the worker may be sent before completing.
+**
+**   replayed events are already committed, and can't be replaced,
+**   so we keep the worker's pipe full, sending them in runs;
+**   otherwise, one at a time.
+*/
+static c3_d
+_pier_work_ahead(u3_pier* pir_u)
+{
+  return ( u3_psat_pace == pir_u->sat_e ) ? PIER_PLAY_AHEAD : 1ULL;
+}
+
 /* _pier_apply(): react to i/o, inbound or outbound.
+**
+**   each stage starts from its own cursor (the next event to compute,
+**   to commit, or to release), so a pass costs what it changes.
 */
 static void
 _pier_apply(u3_pier* pir_u)
@@ -1675,55 +2138,61 @@ _pier_apply(u3_pier* pir_u)
   }
 
   u3_writ* wit_u;
-  c3_o     act_o = c3n;
+  c3_o     act_o;
 
-start:
+  do {
+    act_o = c3n;
 
-  /* iterate from queue exit, advancing any writs that can advance
-  */
-  wit_u = pir_u->ext_u;
-  while ( wit_u ) {
-    /* if writ is (a) next in line to compute, (b) worker is inactive,
-    ** and (c) a snapshot has not been requested, request computation
+    /* while the next writ to compute is queued, the worker is inactive
+    ** (or we're replaying, and it's not too far behind), and a
+    ** snapshot has not been requested, request computation.
+    **
+    ** a requested snapshot only holds back work until its %save is
+    ** sent, so that it's taken at exactly [req_d]; the worker writes
+    ** it (or forks to) before computing anything we send after.
     */
-    if ( (wit_u->evt_d == (1 + god_u->sen_d)) &&
-         (god_u->sen_d == god_u->dun_d) &&
-         (sav_u->dun_d == sav_u->req_d) )
+    while ( (wit_u = _pier_writ_find(pir_u, 1 + god_u->sen_d)) &&
+            ((god_u->sen_d - god_u->dun_d) < _pier_work_ahead(pir_u)) &&
+            (sav_u->dun_d == sav_u->req_d) )
     {
-      _pier_work_compute(wit_u);
-      act_o = c3y;
+      if ( u3_psat_pace != pir_u->sat_e ) {
+        _pier_work_compute(wit_u);
+      }
+      else if ( c3n == _pier_work_compute_many(wit_u) ) {
+        break;
+      }
     }
 
-    /* if writ is (a) computed and (b) next in line to commit,
-    ** and (c) no commit is in progress and (d) we've booted,
-    ** request commit.
+    /* if writs are computed but not committed, and no commit is
+    ** in progress, request commit of a group of them.
     */
-    if ( (wit_u->evt_d <= god_u->dun_d) &&
-         (wit_u->evt_d == (1 + log_u->moc_d)) &&
-         (wit_u->evt_d == (1 + log_u->com_d)) )
+    if ( (log_u->moc_d == log_u->com_d) &&
+         (god_u->dun_d > log_u->com_d) &&
+         (wit_u = _pier_writ_find(pir_u, 1 + log_u->com_d)) )
     {
-      c3_d count = 1 + (god_u->dun_d - wit_u->evt_d);
-      struct u3_lmdb_write_request* request =
-          u3_lmdb_build_write_request(wit_u, count);
-      c3_assert(request != 0);
-
-      _pier_db_commit_request(pir_u,
-                              request,
-                              wit_u->evt_d,
-                              count);
-      act_o = c3y;
+      c3_d count = _pier_db_commit_group(pir_u, wit_u,
+                                         god_u->dun_d - log_u->com_d);
+
+      if ( 0 != count ) {
+        struct u3_lmdb_write_request* request =
+            u3_lmdb_build_write_request(wit_u, count);
+        c3_assert(request != 0);
+
+        _pier_db_commit_request(pir_u,
+                                request,
+                                wit_u->evt_d,
+                                count);
+      }
     }
 
-    /* if writ is (a) committed and (b) computed,
-    ** release effects and delete from queue
+    /* while the writ at the queue exit is committed and computed,
+    ** release effects and delete from queue.  releasing effects
+    ** may enqueue events, so make another pass.
     */
-    if ( (wit_u->evt_d <= log_u->com_d) &&
-         (wit_u->evt_d <= god_u->dun_d) )
+    while ( (wit_u = pir_u->ext_u) &&
+            (wit_u->evt_d <= log_u->com_d) &&
+            (wit_u->evt_d <= god_u->dun_d) )
     {
-      //  effects must be released in order
-      //
-      c3_assert(wit_u == pir_u->ext_u);
-
       //  remove from queue
       //
       //    Must be done before releasing effects
@@ -1738,22 +2207,10 @@ start:
       //
       _pier_writ_dispose(wit_u);
 
-      wit_u = pir_u->ext_u;
       act_o = c3y;
     }
-    else {
-      /* otherwise, continue backward
-      */
-      wit_u = wit_u->nex_u;
-    }
-  }
-
-  /* if we did anything to the queue, make another pass.
-  */
-  if ( c3y == act_o ) {
-    act_o = c3n;
-    goto start;
   }
+  while ( c3y == act_o );
 }
 
 /* _pier_create(): create a pier, loading existing.
@@ -1807,7 +2264,13 @@ _pier_create(c3_w wag_w, c3_c* pax_c)
 static void
 _pier_inject(u3_pier* pir_u, c3_c* pax_c)
 {
-  u3_noun ovo = u3ke_cue(u3m_file(pax_c));
+  u3_weak ovo = u3s_cue_file(pax_c);
+
+  if ( u3_none == ovo ) {
+    u3l_log("pier: unable to inject %s\r\n", pax_c);
+    return;
+  }
+
   u3m_p("injecting event", u3h(ovo));
   u3_pier_work(pir_u, u3k(u3h(ovo)), u3k(u3t(ovo)));
   u3z(ovo);
@@ -2217,6 +2680,8 @@ u3_pier_mark(FILE* fil_u)
       pir_w += u3a_maid(fil_u, "  encoded events", mat_w);
       pir_w += u3a_maid(fil_u, "  pending effects", act_w);
 
+      _pier_db_stat(pir_u, fil_u);
+
       tot_w += u3a_maid(fil_u, "total pier stuff", pir_w);
     }
   }
@@ -17,6 +17,19 @@ static void
 _save_time_cb(uv_timer_t* tim_u)
 {
   u3_pier *pir_u = tim_u->data;
+  u3_save* sav_u = pir_u->sav_u;
+
+  //  a forked snapshot may still be writing; another %save now
+  //  would only stall the worker until it's done
+  //
+  if ( sav_u->dur_d < sav_u->dun_d ) {
+    if ( u3C.wag_w & u3o_verbose ) {
+      u3l_log("pier: snapshot at %" PRIu64 " still in progress\r\n",
+              sav_u->dun_d);
+    }
+    return;
+  }
+
   u3_pier_snap(pir_u);
 }
 
@@ -51,6 +64,7 @@ u3_save_io_init(u3_pier *pir_u)
 
   sav_u->req_d = 0;
   sav_u->dun_d = 0;
+  sav_u->dur_d = 0;
   sav_u->pid_w = 0;
 
   sav_u->tim_u.data = pir_u;
@@ -33,7 +33,18 @@
       c3_d    key_d[4];                     //  disk key
       u3_moat inn_u;                        //  message input
       u3_mojo out_u;                        //  message output
+      u3_ring* shi_u;                       //  shared input, or 0
+      u3_ring* sho_u;                       //  shared output, or 0
       c3_c*   dir_c;                        //  execution directory (pier)
+      uv_idle_t mel_u;                      //  meld slicer
+      c3_w    mel_w;                        //  words released by meld
+      uv_signal_t sil_u;                    //  snapshot child signal
+      c3_d    sav_d;                        //  snapshot in background, or 0
+      c3_o    man_o;                        //  computing a %many
+      c3_d    man_d;                        //  first completion in [man]
+      u3_noun man;                          //  completions, reversed
+      u3_noun mas;                          //  %many entries in progress
+      c3_o    pac_o;                        //  |pack deferred past %many
     } u3_worker;
     static u3_worker u3V;
 
@@ -59,6 +70,14 @@
           ::
           [p=@ q=@ r=(list ovum)]
       ==
+      ::  events executed unchanged (in response to %many)
+      ::
+      $:  %many
+          ::  p: first event number
+          ::  q: mug of kernel and effects, for each event
+          ::
+          [p=@ q=(list (pair @ (list ovum)))]
+      ==
       ::  replace event and retry (in response to %work)
       ::
       $:  %work
@@ -84,7 +103,13 @@
           ::  r: output tank
           ::
           [p=@ q=@ r=tank]
-  ==  ==
+      ==
+      ::  snapshot written (in response to %save)
+      ::
+      ::  p: event number
+      ::
+      [%save p=@]
+  ==
 ::  +writ: from daemon to worker
 ::
 +$  writ
@@ -110,6 +135,14 @@
           ::  q: a jammed noun [mug [date ovum]]
           ::
           [p=@ q=@]
+      ==
+      ::  execute consecutive events
+      ::
+      $:  %many
+          ::  p: first event number
+          ::  q: jammed nouns [mug [date ovum]], one per event
+          ::
+          [p=@ q=(list @)]
   ==  ==
 --
 */
@@ -294,10 +327,13 @@ _worker_grab(u3_noun sac, u3_noun ovo, u3_noun vir)
     tot_w += u3a_maid(fil_u, "space profile", u3a_mark_noun(sac));
     tot_w += u3a_maid(fil_u, "event", u3a_mark_noun(ovo));
     tot_w += u3a_maid(fil_u, "lifecycle events", u3a_mark_noun(u3V.roe));
+    tot_w += u3a_maid(fil_u, "batched events", u3a_mark_noun(u3V.mas));
+    tot_w += u3a_maid(fil_u, "batched effects", u3a_mark_noun(u3V.man));
     tot_w += u3a_maid(fil_u, "effects", u3a_mark_noun(vir));
 
     u3a_print_memory(fil_u, "total marked", tot_w);
     u3a_print_memory(fil_u, "free lists", u3a_idle(u3R));
+    u3a_print_slabs(fil_u);
     u3a_print_memory(fil_u, "sweep", u3a_sweep());
 
     fflush(fil_u);
@@ -320,50 +356,83 @@ _worker_static_grab(void)
   fprintf(stderr, "work: measuring memory:\r\n");
   u3a_print_memory(stderr, "total marked", u3m_mark(stderr));
   u3a_print_memory(stderr, "free lists", u3a_idle(u3R));
+  u3a_print_slabs(stderr);
   u3a_print_memory(stderr, "sweep", u3a_sweep());
   fprintf(stderr, "\r\n");
   fflush(stderr);
 }
 
-/* _worker_pack(): deduplicate and compact memory
+/* _worker_pack(): compact memory in place
 */
 static void
 _worker_pack(void)
 {
-  _worker_static_grab();
-  u3l_log("work: compacting loom\r\n");
+  c3_w wor_w;
 
-  if ( c3n == u3m_rock_stay(u3V.dir_c, u3V.dun_d) ) {
-    u3l_log("work: unable to jam state\r\n");
+  //  lifecycle formulas are held outside the loom, where compaction
+  //  can't find them; they are gone by the time %pack can be sent
+  //
+  if ( u3_nul != u3V.roe ) {
+    u3l_log("work: pack: skipped, lifecycle events pending\r\n");
     return;
   }
 
-  if ( c3n == u3e_hold() ) {
-    u3l_log("work: unable to backup checkpoint\r\n");
-    return;
-  }
+  _worker_static_grab();
+  u3l_log("work: compacting loom\r\n");
 
-  u3m_wipe();
+  //  the snapshot is left as it was until the next save, so if we
+  //  fail in here, we restart from it (and replay) as from any crash
+  //
+  wor_w = u3m_pack();
 
-  if ( c3n == u3m_rock_load(u3V.dir_c, u3V.dun_d) ) {
-    u3l_log("work: compaction failed, restoring checkpoint\r\n");
+  u3a_print_memory(stderr, "work: pack: gained", wor_w);
+  u3l_log("work: pack: reclaimed %u pages\r\n", wor_w >> u3a_page);
+  _worker_static_grab();
+}
 
-    if ( c3n == u3e_fall() ) {
-      fprintf(stderr, "work: unable to restore checkpoint\r\n");
-      c3_assert(0);
-    }
+/* _worker_meld_slice(): deduplicate memory between events.
+*/
+static void
+_worker_meld_slice(uv_idle_t* idl_u)
+{
+  //  |pack abandons a meld in progress
+  //
+  if ( c3n == u3a_meld_live() ) {
+    u3l_log("work: meld: abandoned\r\n");
+    uv_idle_stop(idl_u);
   }
+  else if ( c3y == u3a_meld(10, &u3V.mel_w) ) {
+    uv_idle_stop(idl_u);
+    u3a_meld_stop();
 
-  if ( c3n == u3e_drop() ) {
-    u3l_log("work: warning: orphaned backup checkpoint file\r\n");
+    u3a_print_memory(stderr, "work: meld: gained", u3V.mel_w);
+    u3l_log("work: meld: done\r\n");
   }
+  //  stopped short of running out of loom
+  //
+  else if ( c3n == u3a_meld_live() ) {
+    uv_idle_stop(idl_u);
 
-  if ( c3n == u3m_rock_drop(u3V.dir_c, u3V.dun_d) ) {
-    u3l_log("work: warning: orphaned state file\r\n");
+    u3a_print_memory(stderr, "work: meld: gained", u3V.mel_w);
+    u3l_log("work: meld: failed, loom full\r\n");
   }
+}
 
-  u3l_log("work: compacted loom\r\n");
-  _worker_static_grab();
+/* _worker_meld(): deduplicate memory, incrementally.
+*/
+static void
+_worker_meld(void)
+{
+  if ( c3y == u3a_meld_live() ) {
+    u3l_log("work: meld: already in progress\r\n");
+    return;
+  }
+
+  u3l_log("work: melding loom\r\n");
+
+  u3V.mel_w = 0;
+  u3a_meld_start(u3k(u3A->roc));
+  uv_idle_start(&u3V.mel_u, _worker_meld_slice);
 }
 
 /* _worker_fail(): failure stub.
@@ -380,7 +449,45 @@ _worker_fail(void* vod_p, const c3_c* wut_c)
 static void
 _worker_send(u3_noun job)
 {
-  u3_newt_write(&u3V.out_u, u3ke_jam(job), 0);
+  if ( u3V.sho_u ) {
+    u3_newt_ring_jam(u3V.sho_u, job);
+  }
+  else {
+    u3_newt_jam(&u3V.out_u, job, 0);
+  }
+}
+
+/* _worker_send_many(): report completions accumulated in a %many.
+*/
+static void
+_worker_send_many(void)
+{
+  if ( u3_nul != u3V.man ) {
+    _worker_send(u3nt(c3__many,
+                      u3i_chubs(1, &u3V.man_d),
+                      u3kb_flop(u3V.man)));
+    u3V.man = u3_nul;
+  }
+}
+
+/* _worker_send_done(): report completion, or accumulate it in a %many.
+*/
+static void
+_worker_send_done(c3_d evt_d, c3_l mug_l, u3_noun vir)
+{
+  if ( c3y == u3V.man_o ) {
+    if ( u3_nul == u3V.man ) {
+      u3V.man_d = evt_d;
+    }
+
+    u3V.man = u3nc(u3nc(mug_l, vir), u3V.man);
+  }
+  else {
+    _worker_send(u3nq(c3__done,
+                      u3i_chubs(1, &evt_d),
+                      mug_l,
+                      vir));
+  }
 }
 
 /* _worker_send_replace(): send replacement job back to daemon.
@@ -388,6 +495,10 @@ _worker_send(u3_noun job)
 static void
 _worker_send_replace(c3_d evt_d, u3_noun job)
 {
+  //  completions must precede the replacement
+  //
+  _worker_send_many();
+
   _worker_send(u3nt(c3__work,
                     u3i_chubs(1, &evt_d),
                     u3ke_jam(u3nc(u3V.mug_l, job))));
@@ -398,10 +509,15 @@ _worker_send_replace(c3_d evt_d, u3_noun job)
 static void
 _worker_send_complete(u3_noun vir)
 {
-  _worker_send(u3nq(c3__done,
-                    u3i_chubs(1, &u3V.dun_d),
-                    u3V.mug_l,
-                    vir));
+  _worker_send_done(u3V.dun_d, u3V.mug_l, vir);
+}
+
+/* _worker_send_save(): report a snapshot written to disk.
+*/
+static void
+_worker_send_save(c3_d evt_d)
+{
+  _worker_send(u3nc(c3__save, u3i_chubs(1, &evt_d)));
 }
 
 /* _worker_send_stdr(): send stderr output
@@ -487,6 +603,7 @@ _worker_sure_feck(u3_noun ovo, u3_noun vir, c3_w pre_w)
 {
   u3_noun sac = u3_nul;
   c3_o  pac_o = c3n;
+  c3_o  mel_o = c3n;
   c3_o  rec_o = c3n;
 
   //  intercept |mass, observe |reset
@@ -528,6 +645,12 @@ _worker_sure_feck(u3_noun ovo, u3_noun vir, c3_w pre_w)
         pac_o = c3y;
       }
 
+      //  deduplicate memory on |meld
+      //
+      if ( c3__meld == u3h(fec) ) {
+        mel_o = c3y;
+      }
+
       riv = u3t(riv);
       i_w++;
     }
@@ -594,8 +717,19 @@ _worker_sure_feck(u3_noun ovo, u3_noun vir, c3_w pre_w)
 
   u3z(sac); u3z(ovo);
 
+  //  compaction would move a %many out from under us
+  //
   if ( c3y == pac_o ) {
-    _worker_pack();
+    if ( c3y == u3V.man_o ) {
+      u3V.pac_o = c3y;
+    }
+    else {
+      _worker_pack();
+    }
+  }
+
+  if ( c3y == mel_o ) {
+    _worker_meld();
   }
 }
 
@@ -639,7 +773,7 @@ _worker_work_live(c3_d evt_d, u3_noun job)
   }
 #endif
 
-  gon = u3m_soft(0, u3v_poke, u3k(ovo));
+  gon = u3m_soft(0, 0, u3v_poke, u3k(ovo));
 
 #ifdef U3_EVENT_TIME_DEBUG
   {
@@ -732,10 +866,7 @@ _worker_work_boot(c3_d evt_d, u3_noun job)
     u3V.mug_l = u3r_mug(job);
   }
 
-  _worker_send(u3nq(c3__done,
-                    u3i_chubs(1, &evt_d),
-                    u3V.mug_l,
-                    u3_nul));
+  _worker_send_done(evt_d, u3V.mug_l, u3_nul);
 }
 
 /* _worker_poke_work(): apply event.
@@ -802,11 +933,85 @@ _worker_poke_work(c3_d    evt_d,              //  event number
   }
 }
 
+/* _worker_poke_many(): apply consecutive events, reporting them at once.
+*/
+static void
+_worker_poke_many(c3_d evt_d,                 //  first event number
+                  u3_noun lis)                //  jammed entries
+{
+  u3_noun ent = lis;
+
+  u3V.man_o = c3y;
+  u3V.mas   = lis;
+
+  while ( u3_nul != ent ) {
+    u3_noun entry = u3qe_cue(u3h(ent));
+    u3_noun mug, job;
+    c3_l    mug_l;
+
+    if ( (c3y != u3du(entry)) ||
+         (c3n == u3r_cell(entry, &mug, &job)) ||
+         (c3n == u3ud(mug)) ||
+         (1 < u3r_met(5, mug)) )
+    {
+      u3z(entry);
+      u3V.man_o = c3n;
+      u3V.mas   = u3_nul;
+      u3z(lis);
+
+      _worker_fail(0, "bad jar");
+      c3_assert(!"unreachable");
+      return;
+    }
+
+    mug_l = u3r_word(0, mug);
+    u3k(job);
+    u3z(entry);
+
+    _worker_poke_work(evt_d, mug_l, job);
+
+    //  the event was replaced; the rest of the batch is stale
+    //
+    if ( evt_d != u3V.sen_d ) {
+      break;
+    }
+
+    evt_d++;
+    ent = u3t(ent);
+  }
+
+  u3V.man_o = c3n;
+  u3V.mas   = u3_nul;
+  _worker_send_many();
+
+  u3z(lis);
+
+  if ( c3y == u3V.pac_o ) {
+    u3V.pac_o = c3n;
+    _worker_pack();
+  }
+}
+
 /* _worker_poke_exit(): exit on command.
 */
 static void
 _worker_poke_exit(c3_w cod_w)                 //  exit code
 {
+  //  a snapshot may still be in progress
+  //
+  u3e_wait(c3y);
+
+  //  leave a packed snapshot, for backup or migration
+  //
+  if ( u3C.wag_w & u3o_pack_exit ) {
+    c3_w  len_w = strlen(u3V.dir_c) + sizeof("/.urb/chk/image.pak");
+    c3_c* pax_c = c3_malloc(len_w);
+
+    snprintf(pax_c, len_w, "%s/.urb/chk/image.pak", u3V.dir_c);
+    u3e_pack_save(pax_c);
+    c3_free(pax_c);
+  }
+
   if ( u3C.wag_w & u3o_debug_cpu ) {
     FILE* fil_u;
 
@@ -845,6 +1050,48 @@ _worker_poke_exit(c3_w cod_w)                 //  exit code
   exit(cod_w);
 }
 
+/* _worker_save_reap(): report a background snapshot, if it's done.
+*/
+static void
+_worker_save_reap(c3_o hol_o)
+{
+  if ( (0 != u3V.sav_d) && (c3y == u3e_wait(hol_o)) ) {
+    _worker_send_save(u3V.sav_d);
+    u3V.sav_d = 0;
+  }
+}
+
+/* _worker_save_signal(): a snapshot child may have exited.
+*/
+static void
+_worker_save_signal(uv_signal_t* sil_u, c3_i num_i)
+{
+  _worker_save_reap(c3n);
+}
+
+/* _worker_poke_save(): save a snapshot, from a child process if
+**                      so configured, and report when it's written.
+*/
+static void
+_worker_poke_save(c3_d evt_d)
+{
+  c3_assert( evt_d == u3V.dun_d );
+
+  if ( u3C.wag_w & u3o_fork_save ) {
+    _worker_save_reap(c3y);
+
+    if ( c3y == u3e_fork() ) {
+      u3V.sav_d = evt_d;
+      return;
+    }
+  }
+  else {
+    u3e_save();
+  }
+
+  _worker_send_save(evt_d);
+}
+
 /* _worker_poke_boot(): prepare to boot.
 */
 static void
@@ -915,6 +1162,24 @@ _worker_poke(void* vod_p, u3_noun mat)
         return _worker_poke_work(evt_d, mug_l, job);
       }
 
+      case c3__many: {
+        u3_noun evt, lis;
+        c3_d evt_d;
+
+        if ( (c3n == u3r_trel(jar, 0, &evt, &lis)) ||
+             (c3n == u3ud(evt)) ||
+             (1 != u3r_met(6, evt)) )
+        {
+          goto error;
+        }
+
+        evt_d = u3r_chub(0, evt);
+        u3k(lis);
+        u3z(jar);
+
+        return _worker_poke_many(evt_d, lis);
+      }
+
       case c3__exit: {
         u3_noun cod;
         c3_w cod_w;
@@ -945,9 +1210,7 @@ _worker_poke(void* vod_p, u3_noun mat)
         evt_d = u3r_chub(0, evt);
         u3z(jar);
 
-        c3_assert( evt_d == u3V.dun_d );
-
-        return u3e_save();
+        return _worker_poke_save(evt_d);
       }
     }
   }
@@ -969,6 +1232,11 @@ u3_worker_boot(void)
   //
   u3V.len_w = 0;
 
+  u3V.man_o = c3n;
+  u3V.man   = u3_nul;
+  u3V.mas   = u3_nul;
+  u3V.pac_o = c3n;
+
   if ( 0 != u3V.dun_d ) {
     u3V.mug_l = u3r_mug(u3A->roc);
     nex_d    += u3V.dun_d;
@@ -999,7 +1267,8 @@ u3_worker_boot(void)
 c3_i
 main(c3_i argc, c3_c* argv[])
 {
-  //  the worker is spawned with [FD 0] = events and [FD 1] = effects
+  //  the worker is spawned with [FD 0] = events and [FD 1] = effects,
+  //  and, given "ring", shared rings for each at [FD 3-5] and [FD 6-8]
   //  we dup [FD 0 & 1] so we don't accidently use them for something else
   //  we replace [FD 0] (stdin) with a fd pointing to /dev/null
   //  we replace [FD 1] (stdout) with a dup of [FD 2] (stderr)
@@ -1017,7 +1286,7 @@ main(c3_i argc, c3_c* argv[])
   c3_c*      wag_c = argv[3];
   c3_c*      hap_c = argv[4];
 
-  c3_assert(5 == argc);
+  c3_assert( (5 == argc) || ((6 == argc) && !strcmp("ring", argv[5])) );
 
   memset(&u3V, 0, sizeof(u3V));
   memset(&u3_Host.tra_u, 0, sizeof(u3_Host.tra_u));
@@ -1074,6 +1343,47 @@ main(c3_i argc, c3_c* argv[])
     err_i = uv_pipe_init(lup_u, &u3V.out_u.pyp_u, 0);
     c3_assert(!err_i);
     uv_pipe_open(&u3V.out_u.pyp_u, out_i);
+
+    err_i = uv_idle_init(lup_u, &u3V.mel_u);
+    c3_assert(!err_i);
+  }
+
+  /* configure shared rings, if given
+  **
+  **   the pipes stay open, so we notice if the daemon goes away
+  */
+  if ( 6 == argc ) {
+    c3_i inn_i[3] = { 3, 4, 5 };
+    c3_i out_i[3] = { 6, 7, 8 };
+
+    u3V.shi_u = u3_newt_ring_open(lup_u, inn_i, c3n);
+    u3V.sho_u = u3_newt_ring_open(lup_u, out_i, c3y);
+    c3_assert( u3V.shi_u && u3V.sho_u );
+
+    //  the mappings outlive the memfds
+    //
+    close(inn_i[0]);
+    close(out_i[0]);
+
+    u3V.sho_u->bal_f = _worker_fail;
+  }
+
+  /* reap snapshot children as they exit
+  */
+  if ( u3C.wag_w & u3o_fork_save ) {
+    c3_i err_i;
+
+    err_i = uv_signal_init(lup_u, &u3V.sil_u);
+    c3_assert(!err_i);
+    uv_signal_start(&u3V.sil_u, _worker_save_signal, SIGCHLD);
+    uv_unref((uv_handle_t*)&u3V.sil_u);
+  }
+
+  /* resume a meld interrupted by restart
+  */
+  if ( c3y == u3a_meld_live() ) {
+    u3l_log("work: meld: resuming\r\n");
+    uv_idle_start(&u3V.mel_u, _worker_meld_slice);
   }
 
   /* set up writing
@@ -1088,6 +1398,14 @@ main(c3_i argc, c3_c* argv[])
 
   u3_newt_read(&u3V.inn_u);
 
+  if ( u3V.shi_u ) {
+    u3V.shi_u->vod_p = &u3V;
+    u3V.shi_u->pok_f = _worker_poke;
+    u3V.shi_u->bal_f = _worker_fail;
+
+    u3_newt_ring_read(u3V.shi_u);
+  }
+
   /* send start request
   */
   u3_worker_boot();